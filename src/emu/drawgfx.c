@@ -14,6 +14,95 @@
 #include "deprecat.h"
 
 
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* sprite batches are only split into bands when there is enough work */
+#define MIN_SPRITES_FOR_BANDING			32
+#define MIN_SPRITE_BATCH_BAND_HEIGHT	16
+#define MAX_SPRITE_BATCH_BANDS			8
+
+/* marks an empty decode pool slot or an undecoded code */
+#define GFX_POOL_NO_SLOT				0xffffffff
+
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+/* a sprite after setup, ready to render */
+typedef struct _sprite_batch_entry sprite_batch_entry;
+struct _sprite_batch_entry
+{
+	const UINT8 *		srcdata;			/* decoded source data */
+	const pen_t *		paldata;			/* palette lookup for this sprite */
+	UINT32				line_modulo;		/* bytes between source rows */
+	INT32				destx, desty;		/* top-left destination pixel */
+	INT32				dstwidth, dstheight;/* scaled size */
+	INT32				dx, dy;				/* 16.16 source steps */
+	UINT32				pmask;				/* priority mask, with the implicit high bit */
+	UINT32				sortkey;			/* sort key from the submitted sprite */
+	UINT32				index;				/* submission order */
+	UINT8				flipx, flipy;		/* flip flags */
+	UINT8				packed;				/* TRUE if the source is packed 4bpp */
+	UINT8				opaque;				/* TRUE if no pixel can be transparent */
+};
+
+
+/* a horizontal band of the destination, rendered by one work item */
+typedef struct _sprite_batch_band sprite_batch_band;
+struct _sprite_batch_band
+{
+	const gfx_sprite_batch *batch;			/* owning batch */
+	bitmap_t *			dest;				/* destination bitmap */
+	bitmap_t *			priority;			/* priority bitmap, or NULL */
+	rectangle			clip;				/* clip for this band */
+	UINT32				transpen;			/* transparent pen */
+	int					entries;			/* number of prepared entries */
+};
+
+
+/* In drawgfx.h: typedef struct _gfx_sprite_batch gfx_sprite_batch; */
+struct _gfx_sprite_batch
+{
+	running_machine *	machine;			/* pointer to the owning machine */
+	UINT32				flags;				/* GFX_SPRITE_BATCH_* flags */
+	osd_work_queue *	queue;				/* work queue for banded rendering */
+	sprite_batch_entry *entry;				/* array of prepared entries */
+	int					entry_count;		/* number of entries allocated */
+};
+
+
+
+/* LRU links for a single decode pool slot */
+typedef struct _gfx_pool_link gfx_pool_link;
+struct _gfx_pool_link
+{
+	UINT32				prev;				/* previous (more recently used) slot */
+	UINT32				next;				/* next (less recently used) slot */
+};
+
+
+/* In drawgfx.h: typedef struct _gfx_decode_pool gfx_decode_pool; */
+struct _gfx_decode_pool
+{
+	UINT8 *				data;				/* decoded data, one char_modulo per slot */
+	UINT32 *			slotmap;			/* code -> slot, or GFX_POOL_NO_SLOT */
+	UINT32 *			slotcode;			/* slot -> code, or GFX_POOL_NO_SLOT */
+	gfx_pool_link *		link;				/* LRU list links, one per slot */
+	UINT32				slots;				/* number of slots */
+	UINT32				head;				/* most recently used slot */
+	UINT32				tail;				/* least recently used slot */
+
+	UINT64				hits;				/* fetches satisfied from the pool */
+	UINT64				misses;				/* fetches that required a decode */
+	UINT64				evictions;			/* tiles evicted to make room */
+};
+
+
+
 /***************************************************************************
     GLOBAL VARIABLES
 ***************************************************************************/
@@ -71,16 +160,172 @@ INLINE INT32 normalize_yscroll(bitmap_t *bitmap, INT32 yscroll)
 
 
 
+/***************************************************************************
+    DECODE POOLS
+***************************************************************************/
+
+/*-------------------------------------------------
+    decode_pool_alloc - allocate a decode pool
+    with the given number of slots
+-------------------------------------------------*/
+
+static gfx_decode_pool *decode_pool_alloc(const gfx_element *gfx, UINT32 slots)
+{
+	gfx_decode_pool *pool;
+	UINT32 slot;
+
+	pool = alloc_clear_or_die(gfx_decode_pool);
+	pool->slots = slots;
+	pool->data = alloc_array_or_die(UINT8, slots * gfx->char_modulo);
+	pool->slotmap = alloc_array_or_die(UINT32, gfx->total_elements);
+	pool->slotcode = alloc_array_or_die(UINT32, slots);
+	pool->link = alloc_array_or_die(gfx_pool_link, slots);
+
+	/* nothing is resident to start */
+	memset(pool->slotmap, 0xff, gfx->total_elements * sizeof(pool->slotmap[0]));
+	memset(pool->slotcode, 0xff, slots * sizeof(pool->slotcode[0]));
+
+	/* chain all the slots together in order */
+	for (slot = 0; slot < slots; slot++)
+	{
+		pool->link[slot].prev = (slot == 0) ? GFX_POOL_NO_SLOT : slot - 1;
+		pool->link[slot].next = (slot == slots - 1) ? GFX_POOL_NO_SLOT : slot + 1;
+	}
+	pool->head = 0;
+	pool->tail = slots - 1;
+	return pool;
+}
+
+
+/*-------------------------------------------------
+    decode_pool_free - free a decode pool
+-------------------------------------------------*/
+
+static void decode_pool_free(gfx_decode_pool *pool)
+{
+	free(pool->link);
+	free(pool->slotcode);
+	free(pool->slotmap);
+	free(pool->data);
+	free(pool);
+}
+
+
+/*-------------------------------------------------
+    decode_pool_touch - move a slot to the most
+    recently used end of the LRU list
+-------------------------------------------------*/
+
+INLINE void decode_pool_touch(gfx_decode_pool *pool, UINT32 slot)
+{
+	gfx_pool_link *link = &pool->link[slot];
+
+	/* already at the head? */
+	if (pool->head == slot)
+		return;
+
+	/* unlink; we know we are not the head, so prev is valid */
+	pool->link[link->prev].next = link->next;
+	if (link->next != GFX_POOL_NO_SLOT)
+		pool->link[link->next].prev = link->prev;
+	else
+		pool->tail = link->prev;
+
+	/* relink at the head */
+	link->prev = GFX_POOL_NO_SLOT;
+	link->next = pool->head;
+	pool->link[pool->head].prev = slot;
+	pool->head = slot;
+}
+
+
+/*-------------------------------------------------
+    decode_pool_claim - return the slot holding
+    a code, evicting the least recently used
+    tile if it is not resident
+-------------------------------------------------*/
+
+static UINT32 decode_pool_claim(const gfx_element *gfx, UINT32 code)
+{
+	gfx_decode_pool *pool = gfx->pool;
+	UINT32 slot = pool->slotmap[code];
+	UINT32 oldcode;
+
+	if (slot != GFX_POOL_NO_SLOT)
+		return slot;
+
+	/* take the least recently used slot; unused slots start at that end */
+	slot = pool->tail;
+	oldcode = pool->slotcode[slot];
+	if (oldcode != GFX_POOL_NO_SLOT)
+	{
+		/* the evicted tile must be decoded again next time it is used */
+		pool->slotmap[oldcode] = GFX_POOL_NO_SLOT;
+		gfx->dirty[oldcode] = 1;
+		pool->evictions++;
+	}
+	pool->slotmap[code] = slot;
+	pool->slotcode[slot] = code;
+	decode_pool_touch(pool, slot);
+	return slot;
+}
+
+
+/*-------------------------------------------------
+    element_data_base - return the base of the
+    decoded data for a code, claiming a pool slot
+    if needed
+-------------------------------------------------*/
+
+INLINE UINT8 *element_data_base(const gfx_element *gfx, UINT32 code)
+{
+	if (gfx->pool != NULL)
+		return gfx->pool->data + decode_pool_claim(gfx, code) * gfx->char_modulo;
+	return gfx->gfxdata + code * gfx->char_modulo;
+}
+
+
+/*-------------------------------------------------
+    gfx_element_pool_fetch - return a pointer to
+    the decoded data of a code in a pooled
+    gfx_element, decoding it if not resident
+-------------------------------------------------*/
+
+const UINT8 *gfx_element_pool_fetch(const gfx_element *gfx, UINT32 code)
+{
+	gfx_decode_pool *pool = gfx->pool;
+	UINT32 slot;
+
+	/* dirty covers both never-decoded and evicted tiles */
+	if (gfx->dirty[code])
+	{
+		pool->misses++;
+		gfx_element_decode(gfx, code);
+		slot = pool->slotmap[code];
+	}
+	else
+	{
+		pool->hits++;
+		slot = pool->slotmap[code];
+		decode_pool_touch(pool, slot);
+	}
+	return pool->data + slot * gfx->char_modulo;
+}
+
+
+
 /***************************************************************************
     GRAPHICS ELEMENTS
 ***************************************************************************/
 
 /*-------------------------------------------------
-    gfx_element_alloc - allocate a gfx_element structure
-    based on a given layout
+    element_alloc - allocate a gfx_element
+    structure based on a given layout, decoding
+    into a pool if poolbytes is non-zero and the
+    full decode would be larger
 -------------------------------------------------*/
 
-gfx_element *gfx_element_alloc(running_machine *machine, const gfx_layout *gl, const UINT8 *srcdata, UINT32 total_colors, UINT32 color_base)
+static gfx_element *element_alloc(running_machine *machine, const gfx_layout *gl, const UINT8 *srcdata, UINT32 total_colors, UINT32 color_base, UINT32 poolbytes)
 {
 	int israw = (gl->planeoffset[0] == GFX_RAW);
 	int planes = gl->planes;
@@ -171,14 +416,47 @@ gfx_element *gfx_element_alloc(running_machine *machine, const gfx_layout *gl, c
 		gfx->line_modulo = gfx->origwidth;
 		gfx->char_modulo = gfx->line_modulo * gfx->origheight;
 
-		/* allocate memory for the data */
-		gfx->gfxdata = alloc_array_or_die(UINT8, gfx->total_elements * gfx->char_modulo);
+		/* large elements decode on demand into a bounded pool */
+		if (poolbytes != 0 && (UINT64)gfx->total_elements * gfx->char_modulo > poolbytes)
+		{
+			UINT32 slots = MAX(poolbytes / gfx->char_modulo, GFX_POOL_MIN_SLOTS);
+			if (slots < gfx->total_elements)
+				gfx->pool = decode_pool_alloc(gfx, slots);
+		}
+
+		/* otherwise, allocate memory for all the data */
+		if (gfx->pool == NULL)
+			gfx->gfxdata = alloc_array_or_die(UINT8, gfx->total_elements * gfx->char_modulo);
 	}
 
 	return gfx;
 }
 
 
+/*-------------------------------------------------
+    gfx_element_alloc - allocate a gfx_element structure
+    based on a given layout
+-------------------------------------------------*/
+
+gfx_element *gfx_element_alloc(running_machine *machine, const gfx_layout *gl, const UINT8 *srcdata, UINT32 total_colors, UINT32 color_base)
+{
+	return element_alloc(machine, gl, srcdata, total_colors, color_base, 0);
+}
+
+
+/*-------------------------------------------------
+    gfx_element_alloc_pooled - allocate a
+    gfx_element structure whose decoded data is
+    kept in an LRU pool of about poolbytes bytes
+    when fully decoding would need more
+-------------------------------------------------*/
+
+gfx_element *gfx_element_alloc_pooled(running_machine *machine, const gfx_layout *gl, const UINT8 *srcdata, UINT32 total_colors, UINT32 color_base, UINT32 poolbytes)
+{
+	return element_alloc(machine, gl, srcdata, total_colors, color_base, poolbytes);
+}
+
+
 /*-------------------------------------------------
     gfx_element_decode - update a single code in
     a gfx_element
@@ -209,6 +487,16 @@ void gfx_element_free(gfx_element *gfx)
 		free(gfx->pen_usage);
 	if (gfx->dirty != NULL)
 		free(gfx->dirty);
+	if (gfx->pool != NULL)
+	{
+		gfx_decode_pool *pool = gfx->pool;
+		UINT64 fetches = pool->hits + pool->misses;
+
+		mame_printf_verbose("gfx pool: %d slots of %d tiles, %d%% hits, %d decodes, %d evictions\n",
+				pool->slots, gfx->total_elements, (fetches == 0) ? 0 : (int)(pool->hits * 100 / fetches),
+				(UINT32)pool->misses, (UINT32)pool->evictions);
+		decode_pool_free(pool);
+	}
 	if (!(gfx->flags & GFX_ELEMENT_DONT_FREE))
 		free(gfx->gfxdata);
 	free(gfx);
@@ -247,6 +535,7 @@ void gfx_element_build_temporary(gfx_element *gfx, running_machine *machine, UIN
 	gfx->srcdata = base;
 	gfx->dirty = &not_dirty;
 	gfx->dirtyseq = 0;
+	gfx->pool = NULL;
 
 	gfx->machine = machine;
 }
@@ -257,9 +546,8 @@ void gfx_element_build_temporary(gfx_element *gfx, running_machine *machine, UIN
     a given graphics tile
 -------------------------------------------------*/
 
-static void calc_penusage(const gfx_element *gfx, UINT32 code)
+static void calc_penusage(const gfx_element *gfx, UINT32 code, const UINT8 *dp)
 {
-	const UINT8 *dp = gfx->gfxdata + code * gfx->char_modulo;
 	UINT32 usage = 0;
 	int x, y;
 
@@ -306,7 +594,8 @@ void decodechar(const gfx_element *gfx, UINT32 code, const UINT8 *src)
 	const UINT32 *poffset = gl->planeoffset;
 	const UINT32 *xoffset = gl->extxoffs ? gl->extxoffs : gl->xoffset;
 	const UINT32 *yoffset = gl->extyoffs ? gl->extyoffs : gl->yoffset;
-	UINT8 *dp = gfx->gfxdata + code * gfx->char_modulo;
+	UINT8 *base = element_data_base(gfx, code);
+	UINT8 *dp = base;
 	int plane, x, y;
 
 	if (!israw)
@@ -325,7 +614,7 @@ void decodechar(const gfx_element *gfx, UINT32 code, const UINT8 *src)
 				{
 					int yoffs = planeoffs + yoffset[y];
 
-					dp = gfx->gfxdata + code * gfx->char_modulo + y * gfx->line_modulo;
+					dp = base + y * gfx->line_modulo;
 					for (x = 0; x < gfx->origwidth; x += 2)
 					{
 						if (readbit(src, yoffs + xoffset[x+0]))
@@ -347,7 +636,7 @@ void decodechar(const gfx_element *gfx, UINT32 code, const UINT8 *src)
 				{
 					int yoffs = planeoffs + yoffset[y];
 
-					dp = gfx->gfxdata + code * gfx->char_modulo + y * gfx->line_modulo;
+					dp = base + y * gfx->line_modulo;
 					for (x = 0; x < gfx->origwidth; x++)
 						if (readbit(src, yoffs + xoffset[x]))
 							dp[x] |= planebit;
@@ -356,7 +645,7 @@ void decodechar(const gfx_element *gfx, UINT32 code, const UINT8 *src)
 	}
 
 	/* compute pen usage */
-	calc_penusage(gfx, code);
+	calc_penusage(gfx, code, base);
 
 	/* no longer dirty */
 	gfx->dirty[code] = 0;
@@ -386,7 +675,7 @@ void decodegfx(gfx_element *gfx, UINT32 first, UINT32 count)
 
 		/* compute pen usage for everything */
 		for (c = first; c <= last; c++)
-			calc_penusage(gfx, c);
+			calc_penusage(gfx, c, gfx->gfxdata + c * gfx->char_modulo);
 	}
 
 	/* otherwise, we get to manually decode */
@@ -1494,6 +1783,395 @@ void pdrawgfxzoom_alpha(bitmap_t *dest, const rectangle *cliprect, const gfx_ele
 
 
 
+/***************************************************************************
+    SPRITE BATCHES
+***************************************************************************/
+
+/*-------------------------------------------------
+    gfx_sprite_batch_alloc - allocate a sprite
+    batch able to hold up to maxsprites sprites
+    per draw
+-------------------------------------------------*/
+
+gfx_sprite_batch *gfx_sprite_batch_alloc(running_machine *machine, int maxsprites, UINT32 flags)
+{
+	gfx_sprite_batch *batch;
+
+	/* allocate the batch itself */
+	batch = alloc_clear_or_die(gfx_sprite_batch);
+	batch->machine = machine;
+	batch->flags = flags;
+
+	/* allocate the prepared entries; a batch captures all its tile pointers before
+       drawing, so it must fit in a decode pool without evicting its own tiles */
+	assert(maxsprites <= GFX_POOL_MIN_SLOTS);
+	batch->entry_count = MAX(maxsprites, 1);
+	batch->entry = alloc_array_or_die(sprite_batch_entry, batch->entry_count);
+
+	/* create the work queue if we are allowed to render in bands */
+	if (flags & GFX_SPRITE_BATCH_BANDED)
+		batch->queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	return batch;
+}
+
+
+/*-------------------------------------------------
+    gfx_sprite_batch_free - free a sprite batch
+-------------------------------------------------*/
+
+void gfx_sprite_batch_free(gfx_sprite_batch *batch)
+{
+	/* free the work queue */
+	if (batch->queue != NULL)
+		osd_work_queue_free(batch->queue);
+
+	/* free the arrays */
+	free(batch->entry);
+	free(batch);
+}
+
+
+/*-------------------------------------------------
+    compare_sprite_batch_entries - qsort callback
+    that orders entries by sort key, keeping
+    submission order for equal keys
+-------------------------------------------------*/
+
+static int compare_sprite_batch_entries(const void *e1, const void *e2)
+{
+	const sprite_batch_entry *entry1 = (const sprite_batch_entry *)e1;
+	const sprite_batch_entry *entry2 = (const sprite_batch_entry *)e2;
+
+	if (entry1->sortkey != entry2->sortkey)
+		return (entry1->sortkey < entry2->sortkey) ? -1 : 1;
+	return (int)entry1->index - (int)entry2->index;
+}
+
+
+/*-------------------------------------------------
+    sprite_batch_prepare - clip, decode and
+    classify the submitted sprites; everything
+    that touches shared gfx_element state happens
+    here, on the calling thread
+-------------------------------------------------*/
+
+static int sprite_batch_prepare(gfx_sprite_batch *batch, bitmap_t *dest, const rectangle *cliprect, const gfx_sprite *sprites, int count, UINT32 transpen)
+{
+	int sprnum, entries = 0;
+
+	assert(count <= batch->entry_count);
+
+	/* ignore empty/invalid cliprects */
+	if (cliprect->min_x > cliprect->max_x || cliprect->min_y > cliprect->max_y)
+		return 0;
+
+	for (sprnum = 0; sprnum < count && entries < batch->entry_count; sprnum++)
+	{
+		const gfx_sprite *sprite = &sprites[sprnum];
+		sprite_batch_entry *entry = &batch->entry[entries];
+		const gfx_element *gfx = sprite->gfx;
+		UINT32 scalex = (sprite->scalex == 0) ? 0x10000 : sprite->scalex;
+		UINT32 scaley = (sprite->scaley == 0) ? 0x10000 : sprite->scaley;
+		UINT32 code = sprite->code % gfx->total_elements;
+		UINT32 color = sprite->color % gfx->total_colors;
+		INT32 dstwidth, dstheight;
+
+		/* compute scaled size, exactly as drawgfxzoom does */
+		dstwidth = (scalex * gfx->width + 0x8000) >> 16;
+		dstheight = (scaley * gfx->height + 0x8000) >> 16;
+		if (dstwidth < 1 || dstheight < 1)
+			continue;
+
+		/* skip anything entirely clipped */
+		if (sprite->destx > cliprect->max_x || sprite->destx + dstwidth - 1 < cliprect->min_x ||
+			sprite->desty > cliprect->max_y || sprite->desty + dstheight - 1 < cliprect->min_y)
+			continue;
+
+		/* fetch the source data, which decodes it if dirty */
+		entry->srcdata = gfx_element_get_data(gfx, code);
+		entry->opaque = (transpen > 0xff);
+
+		/* use pen usage to skip fully transparent sprites and find fully opaque ones */
+		if (gfx->pen_usage != NULL && !entry->opaque)
+		{
+			UINT32 usage = gfx->pen_usage[code];
+			if ((usage & ~(1 << transpen)) == 0)
+				continue;
+			if ((usage & (1 << transpen)) == 0)
+				entry->opaque = TRUE;
+		}
+
+		entry->paldata = &gfx->machine->pens[gfx->color_base + gfx->color_granularity * color];
+		entry->line_modulo = gfx->line_modulo;
+		entry->destx = sprite->destx;
+		entry->desty = sprite->desty;
+		entry->dstwidth = dstwidth;
+		entry->dstheight = dstheight;
+		entry->dx = (gfx->width << 16) / dstwidth;
+		entry->dy = (gfx->height << 16) / dstheight;
+		entry->pmask = sprite->pmask | (1 << 31);
+		entry->sortkey = sprite->sortkey;
+		entry->index = sprnum;
+		entry->flipx = (sprite->flipx != 0);
+		entry->flipy = (sprite->flipy != 0);
+		entry->packed = ((gfx->flags & GFX_ELEMENT_PACKED) != 0);
+		entries++;
+	}
+
+	/* sort if requested */
+	if ((batch->flags & GFX_SPRITE_BATCH_SORT) && entries > 1)
+		qsort(batch->entry, entries, sizeof(batch->entry[0]), compare_sprite_batch_entries);
+	return entries;
+}
+
+
+/*-------------------------------------------------
+    sprite_batch_pixel - render one pixel; all
+    the flags are constants in each caller
+-------------------------------------------------*/
+
+INLINE void sprite_batch_pixel(void *destrow, UINT8 *prirow, int x, UINT32 srcpix, const sprite_batch_entry *entry, UINT32 transpen, const int bpp32, const int dopri)
+{
+	if (entry->opaque || srcpix != transpen)
+	{
+		if (!dopri || ((1 << (prirow[x] & 0x1f)) & entry->pmask) == 0)
+		{
+			if (bpp32)
+				((UINT32 *)destrow)[x] = entry->paldata[srcpix];
+			else
+				((UINT16 *)destrow)[x] = entry->paldata[srcpix];
+		}
+		if (dopri)
+			prirow[x] = 31;
+	}
+}
+
+
+/*-------------------------------------------------
+    sprite_batch_render_entry - render one
+    prepared sprite, clipped to the given
+    rectangle
+-------------------------------------------------*/
+
+INLINE void sprite_batch_render_entry(bitmap_t *dest, bitmap_t *priority, const sprite_batch_entry *entry, const rectangle *clip, UINT32 transpen, const int bpp32, const int dopri)
+{
+	INT32 minx = MAX(entry->destx, clip->min_x);
+	INT32 maxx = MIN(entry->destx + entry->dstwidth - 1, clip->max_x);
+	INT32 miny = MAX(entry->desty, clip->min_y);
+	INT32 maxy = MIN(entry->desty + entry->dstheight - 1, clip->max_y);
+	INT32 srcx, srcy, dx, dy;
+	INT32 width, curx, cury;
+
+	/* if totally clipped, stop here */
+	if (minx > maxx || miny > maxy)
+		return;
+	width = maxx + 1 - minx;
+
+	/* compute 16.16 source positions and steps, matching drawgfxzoom */
+	srcx = (minx - entry->destx) * entry->dx;
+	srcy = (miny - entry->desty) * entry->dy;
+	dx = entry->dx;
+	dy = entry->dy;
+	if (entry->flipx)
+	{
+		srcx = (entry->dstwidth - 1) * dx - srcx;
+		dx = -dx;
+	}
+	if (entry->flipy)
+	{
+		srcy = (entry->dstheight - 1) * dy - srcy;
+		dy = -dy;
+	}
+
+	for (cury = miny; cury <= maxy; cury++, srcy += dy)
+	{
+		const UINT8 *srcrow = entry->srcdata + (srcy >> 16) * entry->line_modulo;
+		void *destrow = bpp32 ? (void *)BITMAP_ADDR32(dest, cury, minx) : (void *)BITMAP_ADDR16(dest, cury, minx);
+		UINT8 *prirow = dopri ? BITMAP_ADDR8(priority, cury, minx) : NULL;
+
+		/* unzoomed 8bpp data: step straight through the source, 4 pixels at a time */
+		if (!entry->packed && (dx == 0x10000 || dx == -0x10000))
+		{
+			const UINT8 *srcptr = srcrow + (srcx >> 16);
+			int step = dx >> 16;
+
+			for (curx = 0; curx + 4 <= width; curx += 4, srcptr += 4 * step)
+			{
+				UINT32 s0 = srcptr[0], s1 = srcptr[step], s2 = srcptr[2 * step], s3 = srcptr[3 * step];
+
+				/* skip groups that are entirely transparent */
+				if (!entry->opaque && s0 == transpen && s1 == transpen && s2 == transpen && s3 == transpen)
+					continue;
+
+				sprite_batch_pixel(destrow, prirow, curx + 0, s0, entry, transpen, bpp32, dopri);
+				sprite_batch_pixel(destrow, prirow, curx + 1, s1, entry, transpen, bpp32, dopri);
+				sprite_batch_pixel(destrow, prirow, curx + 2, s2, entry, transpen, bpp32, dopri);
+				sprite_batch_pixel(destrow, prirow, curx + 3, s3, entry, transpen, bpp32, dopri);
+			}
+			for ( ; curx < width; curx++, srcptr += step)
+				sprite_batch_pixel(destrow, prirow, curx, srcptr[0], entry, transpen, bpp32, dopri);
+		}
+
+		/* zoomed 8bpp data */
+		else if (!entry->packed)
+		{
+			INT32 cursrcx = srcx;
+			for (curx = 0; curx < width; curx++, cursrcx += dx)
+				sprite_batch_pixel(destrow, prirow, curx, srcrow[cursrcx >> 16], entry, transpen, bpp32, dopri);
+		}
+
+		/* packed 4bpp data; even pixels are in the low nibble */
+		else
+		{
+			INT32 cursrcx = srcx;
+			for (curx = 0; curx < width; curx++, cursrcx += dx)
+			{
+				INT32 srcpos = cursrcx >> 16;
+				sprite_batch_pixel(destrow, prirow, curx, (srcrow[srcpos >> 1] >> ((srcpos & 1) * 4)) & 15, entry, transpen, bpp32, dopri);
+			}
+		}
+	}
+}
+
+
+/*-------------------------------------------------
+    sprite_batch_render - render all prepared
+    sprites in order, clipped to a rectangle
+-------------------------------------------------*/
+
+static void sprite_batch_render(const sprite_batch_band *band)
+{
+	const gfx_sprite_batch *batch = band->batch;
+	const rectangle *clip = &band->clip;
+	int entnum;
+
+	for (entnum = 0; entnum < band->entries; entnum++)
+	{
+		const sprite_batch_entry *entry = &batch->entry[entnum];
+
+		/* quick vertical rejection for banded rendering */
+		if (entry->desty > clip->max_y || entry->desty + entry->dstheight - 1 < clip->min_y)
+			continue;
+
+		if (band->dest->bpp == 32)
+		{
+			if (band->priority != NULL)
+				sprite_batch_render_entry(band->dest, band->priority, entry, clip, band->transpen, TRUE, TRUE);
+			else
+				sprite_batch_render_entry(band->dest, NULL, entry, clip, band->transpen, TRUE, FALSE);
+		}
+		else
+		{
+			if (band->priority != NULL)
+				sprite_batch_render_entry(band->dest, band->priority, entry, clip, band->transpen, FALSE, TRUE);
+			else
+				sprite_batch_render_entry(band->dest, NULL, entry, clip, band->transpen, FALSE, FALSE);
+		}
+	}
+}
+
+
+/*-------------------------------------------------
+    sprite_batch_band_callback - work queue
+    callback to render a single band
+-------------------------------------------------*/
+
+static void *sprite_batch_band_callback(void *param, int threadid)
+{
+	sprite_batch_render((const sprite_batch_band *)param);
+	return NULL;
+}
+
+
+/*-------------------------------------------------
+    sprite_batch_draw - common code for drawing
+    a batch, with or without priority
+-------------------------------------------------*/
+
+static void sprite_batch_draw(gfx_sprite_batch *batch, bitmap_t *dest, const rectangle *cliprect, const gfx_sprite *sprites, int count, bitmap_t *priority, UINT32 transpen)
+{
+	sprite_batch_band band[MAX_SPRITE_BATCH_BANDS];
+	int entries, bandnum, numbands;
+
+	assert(dest != NULL);
+	assert(dest->bpp == 16 || dest->bpp == 32);
+
+	/* NULL clip means use the full bitmap */
+	if (cliprect == NULL)
+		cliprect = &dest->cliprect;
+
+profiler_mark_start(PROFILER_DRAWGFX);
+
+	/* clip, decode and sort everything up front */
+	entries = sprite_batch_prepare(batch, dest, cliprect, sprites, count, transpen);
+
+	/* figure out how many bands to split into */
+	numbands = 1;
+	if (batch->queue != NULL && entries >= MIN_SPRITES_FOR_BANDING)
+		numbands = MIN((cliprect->max_y + 1 - cliprect->min_y) / MIN_SPRITE_BATCH_BAND_HEIGHT, MAX_SPRITE_BATCH_BANDS);
+	numbands = MAX(numbands, 1);
+
+	/* set up the bands */
+	for (bandnum = 0; bandnum < numbands; bandnum++)
+	{
+		int height = cliprect->max_y + 1 - cliprect->min_y;
+
+		band[bandnum].batch = batch;
+		band[bandnum].dest = dest;
+		band[bandnum].priority = priority;
+		band[bandnum].transpen = transpen;
+		band[bandnum].entries = entries;
+		band[bandnum].clip = *cliprect;
+		band[bandnum].clip.min_y = cliprect->min_y + height * bandnum / numbands;
+		band[bandnum].clip.max_y = cliprect->min_y + height * (bandnum + 1) / numbands - 1;
+	}
+
+	/* render directly if there is only one band, otherwise fan out and wait */
+	if (numbands == 1)
+		sprite_batch_render(&band[0]);
+	else
+	{
+		osd_work_item_queue_multiple(batch->queue, sprite_batch_band_callback, numbands, band, sizeof(band[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		osd_work_queue_wait(batch->queue, osd_ticks_per_second() * 10);
+	}
+
+profiler_mark_end();
+}
+
+
+/*-------------------------------------------------
+    gfx_sprite_batch_draw_transpen - render a
+    batch of sprites with a single transparent
+    pen; the result is identical to calling
+    drawgfxzoom_transpen for each sprite in
+    order
+-------------------------------------------------*/
+
+void gfx_sprite_batch_draw_transpen(gfx_sprite_batch *batch, bitmap_t *dest, const rectangle *cliprect,
+		const gfx_sprite *sprites, int count, UINT32 transpen)
+{
+	sprite_batch_draw(batch, dest, cliprect, sprites, count, NULL, transpen);
+}
+
+
+/*-------------------------------------------------
+    gfx_sprite_batch_pdraw_transpen - render a
+    batch of sprites with a single transparent
+    pen, checking against the priority bitmap;
+    the result is identical to calling
+    pdrawgfxzoom_transpen for each sprite in
+    order
+-------------------------------------------------*/
+
+void gfx_sprite_batch_pdraw_transpen(gfx_sprite_batch *batch, bitmap_t *dest, const rectangle *cliprect,
+		const gfx_sprite *sprites, int count, bitmap_t *priority, UINT32 transpen)
+{
+	assert(priority != NULL);
+	sprite_batch_draw(batch, dest, cliprect, sprites, count, priority, transpen);
+}
+
+
+
 /***************************************************************************
     DRAW_SCANLINE IMPLEMENTATIONS
 ***************************************************************************/
@@ -33,6 +33,13 @@
 #define GFX_ELEMENT_DONT_FREE	2	/* gfxdata was not malloc()ed, so don't free it on exit */
 
 #define GFX_RAW 				0x12345678
+
+/* decode pools always hold at least this many tiles; anything that captures tile
+   data pointers before drawing them must draw after at most this many captures */
+#define GFX_POOL_MIN_SLOTS		16384
+
+#define GFX_SPRITE_BATCH_SORT	1	/* draw sprites in ascending sortkey order (stable) */
+#define GFX_SPRITE_BATCH_BANDED	2	/* allow rendering in horizontal bands across threads */
 /* When planeoffset[0] is set to GFX_RAW, the gfx data is left as-is, with no conversion.
    No buffer is allocated for the decoded data, and gfxdata is set to point to the source
    data.
@@ -115,6 +122,10 @@ struct _gfx_layout
 };
 
 
+/* opaque LRU pool of decoded tiles, used by large gfx_elements */
+typedef struct _gfx_decode_pool gfx_decode_pool;
+
+
 /* In mamecore.h: typedef struct _gfx_element gfx_element; */
 struct _gfx_element
 {
@@ -141,12 +152,35 @@ struct _gfx_element
 	const UINT8 *	srcdata;			/* pointer to the source data for decoding */
 	UINT8 *			dirty;				/* dirty array for detecting tiles that need decoding */
 	UINT32			dirtyseq;			/* sequence number; incremented each time a tile is dirtied */
+	gfx_decode_pool *pool;				/* LRU pool of decoded tiles, or NULL if gfxdata holds them all */
 
 	running_machine *machine;			/* pointer to the owning machine */
 	gfx_layout		layout;				/* copy of the original layout */
 };
 
 
+/* a single sprite submitted to a gfx_sprite_batch */
+typedef struct _gfx_sprite gfx_sprite;
+struct _gfx_sprite
+{
+	const gfx_element *gfx;				/* gfx_element to draw from */
+	UINT32			code;				/* index of the entry within the gfx_element */
+	UINT32			color;				/* index of the color within the gfx_element */
+	UINT8			flipx;				/* non-zero to render right-to-left */
+	UINT8			flipy;				/* non-zero to render bottom-to-top */
+	INT32			destx;				/* top-left X coordinate to render to */
+	INT32			desty;				/* top-left Y coordinate to render to */
+	UINT32			scalex;				/* 16.16 X scale factor; 0 means 1x */
+	UINT32			scaley;				/* 16.16 Y scale factor; 0 means 1x */
+	UINT32			pmask;				/* priority mask, for priority drawing */
+	UINT32			sortkey;			/* sort key, if GFX_SPRITE_BATCH_SORT is used */
+};
+
+
+/* opaque sprite batch, which holds scratch space and an optional work queue */
+typedef struct _gfx_sprite_batch gfx_sprite_batch;
+
+
 typedef struct _gfx_decode_entry gfx_decode_entry;
 struct _gfx_decode_entry
 {
@@ -171,6 +205,12 @@ struct _gfx_decode_entry
 /* allocate a gfx_element structure based on a given layout */
 gfx_element *gfx_element_alloc(running_machine *machine, const gfx_layout *gl, const UINT8 *srcdata, UINT32 total_colors, UINT32 color_base);
 
+/* allocate a gfx_element structure that keeps at most about poolbytes of decoded data */
+gfx_element *gfx_element_alloc_pooled(running_machine *machine, const gfx_layout *gl, const UINT8 *srcdata, UINT32 total_colors, UINT32 color_base, UINT32 poolbytes);
+
+/* return the decoded data for a code in a pooled gfx_element, decoding it if needed */
+const UINT8 *gfx_element_pool_fetch(const gfx_element *gfx, UINT32 code);
+
 /* update a single code in a gfx_element */
 void gfx_element_decode(const gfx_element *gfx, UINT32 code);
 
@@ -230,6 +270,22 @@ void pdrawgfxzoom_alpha(bitmap_t *dest, const rectangle *cliprect, const gfx_ele
 
 
 
+/* ----- sprite batches ----- */
+
+/* allocate a sprite batch able to hold up to maxsprites sprites per draw */
+gfx_sprite_batch *gfx_sprite_batch_alloc(running_machine *machine, int maxsprites, UINT32 flags);
+
+/* free a sprite batch */
+void gfx_sprite_batch_free(gfx_sprite_batch *batch);
+
+/* draw a list of sprites in one pass, equivalent to drawgfxzoom_transpen on each in order */
+void gfx_sprite_batch_draw_transpen(gfx_sprite_batch *batch, bitmap_t *dest, const rectangle *cliprect, const gfx_sprite *sprites, int count, UINT32 transpen);
+
+/* draw a list of sprites in one pass, equivalent to pdrawgfxzoom_transpen on each in order */
+void gfx_sprite_batch_pdraw_transpen(gfx_sprite_batch *batch, bitmap_t *dest, const rectangle *cliprect, const gfx_sprite *sprites, int count, bitmap_t *priority, UINT32 transpen);
+
+
+
 /* ----- scanline copying ----- */
 
 /* copy pixels from an 8bpp buffer to a single scanline of a bitmap */
@@ -344,6 +400,8 @@ INLINE void gfx_element_set_source(gfx_element *gfx, const UINT8 *source)
 INLINE const UINT8 *gfx_element_get_data(const gfx_element *gfx, UINT32 code)
 {
 	assert(code < gfx->total_elements);
+	if (gfx->pool != NULL)
+		return gfx_element_pool_fetch(gfx, code) + gfx->starty * gfx->line_modulo + gfx->startx;
 	if (gfx->dirty[code])
 		gfx_element_decode(gfx, code);
 	return gfx->gfxdata + code * gfx->char_modulo + gfx->starty * gfx->line_modulo + gfx->startx;
@@ -97,6 +97,8 @@ EMUSOUNDOBJS = \
 	$(EMUOBJ)/sound/filter.o \
 	$(EMUOBJ)/sound/flt_vol.o \
 	$(EMUOBJ)/sound/flt_rc.o \
+	$(EMUOBJ)/sound/samplesrc.o \
+	$(EMUOBJ)/sound/soundlog.o \
 	$(EMUOBJ)/sound/wavwrite.o \
 
 EMUAUDIOOBJS = \
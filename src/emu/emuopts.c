@@ -65,6 +65,8 @@ const options_entry mame_core_options[] =
 	{ "mngwrite",                    NULL,        0,                 "optional filename to write a MNG movie of the current session" },
 	{ "aviwrite",                    NULL,        0,                 "optional filename to write an AVI movie of the current session" },
 	{ "wavwrite",                    NULL,        0,                 "optional filename to write a WAV file of the current session" },
+	{ "soundlog",                    NULL,        0,                 "optional filename to write a log of sound chip register writes of the current session" },
+	{ "soundprofile",                NULL,        0,                 "optional filename to write a JSON report of the time spent in each sound stream at exit" },
 	{ "snapname",                    "%g/%i",     0,                 "override of the default snapshot/movie naming; %g == gamename, %i == index" },
 	{ "snapsize",                    "auto",      0,                 "specify snapshot/movie resolution (<width>x<height>) or 'auto' to use minimal size " },
 	{ "snapview",                    "internal",  0,                 "specify snapshot/movie view or 'internal' to use internal pixel-aspect views" },
@@ -79,6 +81,10 @@ const options_entry mame_core_options[] =
 	{ "sleep",                       "1",         OPTION_BOOLEAN,    "enable sleeping, which gives time back to other applications when idle" },
 	{ "speed(0.01-100)",             "1.0",       0,                 "controls the speed of gameplay, relative to realtime; smaller numbers are slower" },
 	{ "refreshspeed;rs",             "0",         OPTION_BOOLEAN,    "automatically adjusts the speed of gameplay to keep the refresh rate lower than the screen" },
+	{ "framepacing",                 "0",         OPTION_BOOLEAN,    "schedule frames from a model of per-frame cost and choose autoframeskip levels predictively" },
+	{ "framelog",                    NULL,        0,                 "write per-frame timing and interval/jitter percentiles to the given file" },
+	{ "gfxpool",                     "0",         0,                 "maximum MB of decoded tiles per graphics set before decoding on demand into an LRU pool; 0 disables" },
+	{ "polyscale(1-4)",              "1",         0,                 "render 3D at this multiple of the native resolution and filter it down, in drivers that support it" },
 
 	/* rotation options */
 	{ NULL,                          NULL,        OPTION_HEADER,     "CORE ROTATION OPTIONS" },
@@ -72,6 +72,8 @@
 #define OPTION_MNGWRITE				"mngwrite"
 #define OPTION_AVIWRITE				"aviwrite"
 #define OPTION_WAVWRITE				"wavwrite"
+#define OPTION_SOUNDLOG				"soundlog"
+#define OPTION_SOUNDPROFILE			"soundprofile"
 #define OPTION_SNAPNAME				"snapname"
 #define OPTION_SNAPSIZE				"snapsize"
 #define OPTION_SNAPVIEW				"snapview"
@@ -85,6 +87,10 @@
 #define OPTION_SLEEP				"sleep"
 #define OPTION_SPEED				"speed"
 #define OPTION_REFRESHSPEED			"refreshspeed"
+#define OPTION_FRAMEPACING			"framepacing"
+#define OPTION_FRAMELOG				"framelog"
+#define OPTION_GFXPOOL				"gfxpool"
+#define OPTION_POLYSCALE			"polyscale"
 
 /* core rotation options */
 #define OPTION_ROTATE				"rotate"
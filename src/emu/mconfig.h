@@ -106,6 +106,9 @@ enum
 /* calls VIDEO_UPDATE for every visible scanline, even for skipped frames */
 #define VIDEO_UPDATE_SCANLINE			0x0100
 
+/* driver reads gfx_element gfxdata directly, so never decode it into a pool */
+#define VIDEO_NEEDS_GFXDATA				0x0200
+
 
 
 /***************************************************************************
@@ -15,6 +15,7 @@
 #include "config.h"
 #include "profiler.h"
 #include "sound/wavwrite.h"
+#include "sound/soundlog.h"
 
 
 
@@ -97,6 +98,18 @@ struct _sound_private
 	int nosound_mode;
 
 	wav_file *wavfile;
+
+	/* profiling */
+	osd_ticks_t update_ticks;				/* total ticks spent in sound_update */
+	osd_ticks_t stream_ticks;				/* ticks spent bringing the speaker streams up to date */
+	osd_ticks_t output_ticks;				/* ticks spent handing the final mix to the OSD and recorders */
+	UINT32 updates;							/* number of calls to sound_update */
+	osd_ticks_t profile_start;				/* time sound_init was called */
+	osd_ticks_t profile_time;				/* time the overlay text was last refreshed */
+	osd_ticks_t profile_update_ticks;		/* update_ticks at the last refresh */
+	stream_profile *profile_last;			/* stream counters at the last refresh */
+	int profile_count;						/* number of entries in profile_last */
+	astring *profile_text;					/* overlay text from the last refresh */
 };
 
 
@@ -107,6 +120,7 @@ struct _sound_private
 
 static void sound_reset(running_machine *machine);
 static void sound_exit(running_machine *machine);
+static void sound_write_profile(running_machine *machine, const char *filename);
 static void sound_pause(running_machine *machine, int pause);
 static void sound_load(running_machine *machine, int config_type, xml_data_node *parentnode);
 static void sound_save(running_machine *machine, int config_type, xml_data_node *parentnode);
@@ -220,6 +234,13 @@ void sound_init(running_machine *machine)
 	if (filename[0] != 0)
 		global->wavfile = wav_open(filename, machine->sample_rate, 2);
 
+	/* open the sound chip register log if specified */
+	soundlog_init(machine, options_get_string(mame_options(), OPTION_SOUNDLOG));
+
+	/* start the profiling clock */
+	global->profile_start = global->profile_time = osd_ticks();
+	global->profile_text = auto_astring_alloc(machine);
+
 	/* enable sound by default */
 	global->enabled = TRUE;
 	global->muted = FALSE;
@@ -240,12 +261,18 @@ void sound_init(running_machine *machine)
 static void sound_exit(running_machine *machine)
 {
 	sound_private *global = machine->sound_data;
+	const char *filename;
 
 	/* close any open WAV file */
 	if (global->wavfile != NULL)
 		wav_close(global->wavfile);
 	global->wavfile = NULL;
 
+	/* write the sound cost report if requested */
+	filename = options_get_string(mame_options(), OPTION_SOUNDPROFILE);
+	if (filename[0] != 0)
+		sound_write_profile(machine, filename);
+
 	/* reset variables */
 	global->totalsnd = 0;
 }
@@ -698,15 +725,22 @@ static TIMER_CALLBACK( sound_update )
 	sound_private *global = machine->sound_data;
 	INT16 *finalmix;
 	INT32 *leftmix, *rightmix;
+	osd_ticks_t start, stream_start, output_start;
 
 	VPRINTF(("sound_update\n"));
 
 	profiler_mark_start(PROFILER_SOUND);
+	start = osd_ticks();
 
 	leftmix = global->leftmix;
 	rightmix = global->rightmix;
 	finalmix = global->finalmix;
 
+	/* run the independent sound cores in parallel before pulling the speakers */
+	stream_start = osd_ticks();
+	streams_update_leaves(machine);
+	global->stream_ticks += osd_ticks() - stream_start;
+
 	/* force all the speaker streams to generate the proper number of samples */
 	for (curspeak = speaker_output_first(machine->config); curspeak != NULL; curspeak = speaker_output_next(curspeak))
 	{
@@ -719,7 +753,9 @@ static TIMER_CALLBACK( sound_update )
 			int numsamples;
 
 			/* update the stream, getting the start/end pointers around the operation */
+			stream_start = osd_ticks();
 			stream_buf = stream_get_output_since_last_update(spk->mixer_stream, 0, &numsamples);
+			global->stream_ticks += osd_ticks() - stream_start;
 
 			/* set or assert that all streams have the same count */
 			if (samples_this_update == 0)
@@ -797,6 +833,7 @@ static TIMER_CALLBACK( sound_update )
 	global->finalmix_leftover = sample - samples_this_update * 100;
 
 	/* play the result */
+	output_start = osd_ticks();
 	if (finalmix_offset > 0)
 	{
 		osd_update_audio_stream(machine, finalmix, finalmix_offset / 2);
@@ -804,10 +841,14 @@ static TIMER_CALLBACK( sound_update )
 		if (global->wavfile != NULL)
 			wav_add_data_16(global->wavfile, finalmix, finalmix_offset);
 	}
+	global->output_ticks += osd_ticks() - output_start;
 
 	/* update the streamer */
 	streams_update(machine);
 
+	global->update_ticks += osd_ticks() - start;
+	global->updates++;
+
 	profiler_mark_end();
 }
 
@@ -1016,3 +1057,114 @@ const char *sound_get_user_gain_name(running_machine *machine, int index)
 	speaker_info *spk = index_to_input(machine, index, &inputnum);
 	return (spk != NULL) ? spk->input[inputnum].name : NULL;
 }
+
+
+
+/***************************************************************************
+    SOUND PROFILING
+***************************************************************************/
+
+/*-------------------------------------------------
+    sound_get_profile_text - return a summary of
+    where the sound time went, refreshed about
+    once a second, for the profiler overlay
+-------------------------------------------------*/
+
+astring *sound_get_profile_text(running_machine *machine, astring *string)
+{
+	sound_private *global = machine->sound_data;
+	osd_ticks_t now = osd_ticks();
+	osd_ticks_t elapsed = now - global->profile_time;
+	stream_profile profile;
+	int index;
+
+	if (elapsed >= osd_ticks_per_second())
+	{
+		double scale = 100.0 / (double)elapsed;
+		osd_ticks_t update_ticks = global->update_ticks - global->profile_update_ticks;
+
+		astring_printf(global->profile_text, "%5.2f%% Sound Update\n", (double)update_ticks * scale);
+
+		for (index = 0; stream_get_profile(machine, index, &profile); index++)
+		{
+			osd_ticks_t callback_ticks, resample_ticks;
+			UINT64 samples, idle;
+
+			/* make room for any streams created since the last refresh */
+			if (index >= global->profile_count)
+			{
+				global->profile_last = auto_extend_array(machine, global->profile_last, stream_profile, index + 1);
+				memset(&global->profile_last[index], 0, sizeof(global->profile_last[index]));
+				global->profile_count = index + 1;
+			}
+
+			/* work out what this stream cost since the last refresh */
+			callback_ticks = profile.callback_ticks - global->profile_last[index].callback_ticks;
+			resample_ticks = profile.resample_ticks - global->profile_last[index].resample_ticks;
+			samples = profile.total_samples - global->profile_last[index].total_samples;
+			idle = profile.idle_samples - global->profile_last[index].idle_samples;
+			global->profile_last[index] = profile;
+
+			/* list only the streams that did some work */
+			if (callback_ticks + resample_ticks != 0)
+				astring_catprintf(global->profile_text, "%5.2f%% %5.2f%% %s '%s' #%d (%d%% idle)\n",
+						(double)(callback_ticks + resample_ticks) * scale, (double)resample_ticks * scale,
+						device_get_name(profile.device), profile.device->tag, profile.index,
+						(samples != 0) ? (int)(idle * 100 / samples) : 0);
+		}
+
+		global->profile_update_ticks = global->update_ticks;
+		global->profile_time = now;
+	}
+
+	return astring_cpy(string, global->profile_text);
+}
+
+
+/*-------------------------------------------------
+    sound_write_profile - write a JSON report of
+    where the sound time went over the session
+-------------------------------------------------*/
+
+static void sound_write_profile(running_machine *machine, const char *filename)
+{
+	sound_private *global = machine->sound_data;
+	attotime emutime = timer_get_time(machine);
+	osd_ticks_t tps = osd_ticks_per_second();
+	stream_profile profile;
+	FILE *file;
+	int index;
+
+	file = fopen(filename, "w");
+	if (file == NULL)
+	{
+		mame_printf_warning("Unable to open sound profile '%s'\n", filename);
+		return;
+	}
+
+	fprintf(file, "{\n");
+	fprintf(file, "\t\"game\": \"%s\",\n", machine->gamedrv->name);
+	fprintf(file, "\t\"sample_rate\": %d,\n", machine->sample_rate);
+	fprintf(file, "\t\"ticks_per_second\": %" I64FMT "d,\n", (INT64)tps);
+	fprintf(file, "\t\"emulated_seconds\": %.6f,\n", attotime_to_double(emutime));
+	fprintf(file, "\t\"real_seconds\": %.6f,\n", (double)(osd_ticks() - global->profile_start) / (double)tps);
+	fprintf(file, "\t\"sound_update\": { \"calls\": %u, \"ticks\": %" I64FMT "d, \"stream_ticks\": %" I64FMT "d, \"mix_ticks\": %" I64FMT "d, \"output_ticks\": %" I64FMT "d },\n",
+			global->updates, (INT64)global->update_ticks, (INT64)global->stream_ticks,
+			(INT64)(global->update_ticks - global->stream_ticks - global->output_ticks), (INT64)global->output_ticks);
+	fprintf(file, "\t\"streams\": [");
+
+	for (index = 0; stream_get_profile(machine, index, &profile); index++)
+	{
+		UINT64 active = profile.total_samples - profile.idle_samples;
+
+		fprintf(file, "%s\n\t\t{ \"index\": %d, \"tag\": \"%s\", ", (index == 0) ? "" : ",", profile.index, profile.device->tag);
+		fprintf(file, "\"device\": \"%s\", ", device_get_name(profile.device));
+		fprintf(file, "\"level\": %d, \"sample_rate\": %d, \"callback_calls\": %u, ", profile.level, profile.sample_rate, profile.callback_calls);
+		fprintf(file, "\"callback_ticks\": %" I64FMT "d, \"resample_ticks\": %" I64FMT "d, ", (INT64)profile.callback_ticks, (INT64)profile.resample_ticks);
+		fprintf(file, "\"total_samples\": %" I64FMT "u, \"idle_samples\": %" I64FMT "u, ", profile.total_samples, profile.idle_samples);
+		fprintf(file, "\"ns_per_sample\": %.1f }", (active != 0) ? 1e9 * (double)(profile.callback_ticks + profile.resample_ticks) / (double)tps / (double)active : 0.0);
+	}
+
+	fprintf(file, "\n\t]\n}\n");
+	fclose(file);
+}
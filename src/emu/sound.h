@@ -173,6 +173,10 @@ const char *sound_get_user_gain_name(running_machine *machine, int index);
 void sound_set_output_gain(const device_config *device, int output, float gain);
 
 
+/* per-stream profiling summary for the profiler overlay */
+astring *sound_get_profile_text(running_machine *machine, astring *string);
+
+
 /* ----- sound speaker device interface ----- */
 
 /* device get info callback */
@@ -8,6 +8,7 @@
 
 #include "sndintrf.h"
 #include "streams.h"
+#include "soundlog.h"
 #include "fm.h"
 #include "2151intf.h"
 #include "ym2151.h"
@@ -38,6 +39,8 @@ static STREAM_UPDATE( ym2151_update )
 {
 	ym2151_state *info = (ym2151_state *)param;
 	ym2151_update_one(info->chip, outputs, samples);
+	if (ym2151_is_idle(info->chip))
+		stream_set_idle(info->stream);
 }
 
 
@@ -60,6 +63,7 @@ static DEVICE_START( ym2151 )
 
 	/* stream setup */
 	info->stream = stream_create(device,0,2,rate,info,ym2151_update);
+	stream_set_thread_safe(info->stream);
 
 	info->chip = ym2151_init(device,device->clock,rate);
 	assert_always(info->chip != NULL, "Error creating YM2151 chip");
@@ -80,6 +84,7 @@ static DEVICE_STOP( ym2151 )
 static DEVICE_RESET( ym2151 )
 {
 	ym2151_state *info = get_safe_token(device);
+	soundlog_reset(device);
 	ym2151_reset_chip(info->chip);
 }
 
@@ -101,10 +106,14 @@ WRITE8_DEVICE_HANDLER( ym2151_w )
 {
 	ym2151_state *token = get_safe_token(device);
 
+	soundlog_write(device, offset, data);
+
 	if (offset & 1)
 	{
 		stream_update(token->stream);
 		ym2151_write_reg(token->chip, token->lastreg, data);
+		if (!ym2151_is_idle(token->chip))
+			stream_wake(token->stream);
 	}
 	else
 		token->lastreg = data;
@@ -1,6 +1,7 @@
 #include <math.h>
 #include "sndintrf.h"
 #include "streams.h"
+#include "soundlog.h"
 #include "2203intf.h"
 #include "fm.h"
 
@@ -107,6 +108,8 @@ static STREAM_UPDATE( ym2203_stream_update )
 {
 	ym2203_state *info = (ym2203_state *)param;
 	ym2203_update_one(info->chip, outputs[0], samples);
+	if (ym2203_is_idle(info->chip))
+		stream_set_idle(info->stream);
 }
 
 
@@ -143,6 +146,7 @@ static DEVICE_START( ym2203 )
 
 	/* stream system initialize */
 	info->stream = stream_create(device,0,1,rate,info,ym2203_stream_update);
+	stream_set_thread_safe(info->stream);
 
 	/* Initialize FM emurator */
 	info->chip = ym2203_init(info,device,device->clock,rate,timer_handler,IRQHandler,&psgintf);
@@ -161,6 +165,7 @@ static DEVICE_STOP( ym2203 )
 static DEVICE_RESET( ym2203 )
 {
 	ym2203_state *info = get_safe_token(device);
+	soundlog_reset(device);
 	ym2203_reset_chip(info->chip);
 }
 
@@ -175,7 +180,11 @@ READ8_DEVICE_HANDLER( ym2203_r )
 WRITE8_DEVICE_HANDLER( ym2203_w )
 {
 	ym2203_state *info = get_safe_token(device);
+
+	soundlog_write(device, offset, data);
 	ym2203_write(info->chip, offset & 1, data);
+	if (!ym2203_is_idle(info->chip))
+		stream_wake(info->stream);
 }
 
 
@@ -13,6 +13,7 @@
 
 #include "sndintrf.h"
 #include "streams.h"
+#include "soundlog.h"
 #include "ay8910.h"
 #include "2608intf.h"
 #include "fm.h"
@@ -119,6 +120,8 @@ static STREAM_UPDATE( ym2608_stream_update )
 {
 	ym2608_state *info = (ym2608_state *)param;
 	ym2608_update_one(info->chip, outputs, samples);
+	if (ym2608_is_idle(info->chip))
+		stream_set_idle(info->stream);
 }
 
 
@@ -183,6 +186,7 @@ static DEVICE_STOP( ym2608 )
 static DEVICE_RESET( ym2608 )
 {
 	ym2608_state *info = get_safe_token(device);
+	soundlog_reset(device);
 	ym2608_reset_chip(info->chip);
 }
 
@@ -196,7 +200,11 @@ READ8_DEVICE_HANDLER( ym2608_r )
 WRITE8_DEVICE_HANDLER( ym2608_w )
 {
 	ym2608_state *info = get_safe_token(device);
+
+	soundlog_write(device, offset, data);
 	ym2608_write(info->chip, offset & 3, data);
+	if (!ym2608_is_idle(info->chip))
+		stream_wake(info->stream);
 }
 
 READ8_DEVICE_HANDLER( ym2608_read_port_r ) { return ym2608_r(device, 1); }
@@ -13,6 +13,7 @@
 
 #include "sndintrf.h"
 #include "streams.h"
+#include "soundlog.h"
 #include "ay8910.h"
 #include "2610intf.h"
 #include "fm.h"
@@ -120,12 +121,16 @@ static STREAM_UPDATE( ym2610_stream_update )
 {
 	ym2610_state *info = (ym2610_state *)param;
 	ym2610_update_one(info->chip, outputs, samples);
+	if (ym2610_is_idle(info->chip))
+		stream_set_idle(info->stream);
 }
 
 static STREAM_UPDATE( ym2610b_stream_update )
 {
 	ym2610_state *info = (ym2610_state *)param;
 	ym2610b_update_one(info->chip, outputs, samples);
+	if (ym2610_is_idle(info->chip))
+		stream_set_idle(info->stream);
 }
 
 
@@ -196,6 +201,7 @@ static DEVICE_STOP( ym2610 )
 static DEVICE_RESET( ym2610 )
 {
 	ym2610_state *info = get_safe_token(device);
+	soundlog_reset(device);
 	ym2610_reset_chip(info->chip);
 }
 
@@ -209,7 +215,11 @@ READ8_DEVICE_HANDLER( ym2610_r )
 WRITE8_DEVICE_HANDLER( ym2610_w )
 {
 	ym2610_state *info = get_safe_token(device);
+
+	soundlog_write(device, offset, data);
 	ym2610_write(info->chip, offset & 3, data);
+	if (!ym2610_is_idle(info->chip))
+		stream_wake(info->stream);
 }
 
 
@@ -13,6 +13,7 @@
 
 #include "sndintrf.h"
 #include "streams.h"
+#include "soundlog.h"
 #include "sound/fm.h"
 #include "sound/2612intf.h"
 
@@ -116,6 +117,7 @@ static DEVICE_START( ym2612 )
 
 	/* stream system initialize */
 	info->stream = stream_create(device,0,2,rate,info,ym2612_stream_update);
+	stream_set_thread_safe(info->stream);
 
 	/**** initialize YM2612 ****/
 	info->chip = ym2612_init(info,device,device->clock,rate,timer_handler,IRQHandler);
@@ -134,6 +136,7 @@ static DEVICE_STOP( ym2612 )
 static DEVICE_RESET( ym2612 )
 {
 	ym2612_state *info = get_safe_token(device);
+	soundlog_reset(device);
 	ym2612_reset_chip(info->chip);
 }
 
@@ -147,6 +150,8 @@ READ8_DEVICE_HANDLER( ym2612_r )
 WRITE8_DEVICE_HANDLER( ym2612_w )
 {
 	ym2612_state *info = get_safe_token(device);
+
+	soundlog_write(device, offset, data);
 	ym2612_write(info->chip, offset & 3, data);
 }
 
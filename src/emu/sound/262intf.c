@@ -7,6 +7,7 @@
 ***************************************************************************/
 #include "sndintrf.h"
 #include "streams.h"
+#include "soundlog.h"
 #include "262intf.h"
 #include "ymf262.h"
 
@@ -69,6 +70,8 @@ static STREAM_UPDATE( ymf262_stream_update )
 {
 	ymf262_state *info = (ymf262_state *)param;
 	ymf262_update_one(info->chip, outputs, samples);
+	if (ymf262_is_idle(info->chip))
+		stream_set_idle(info->stream);
 }
 
 static void _stream_update(void *param, int interval)
@@ -92,6 +95,7 @@ static DEVICE_START( ymf262 )
 	assert_always(info->chip != NULL, "Error creating YMF262 chip");
 
 	info->stream = stream_create(device,0,4,rate,info,ymf262_stream_update);
+	stream_set_thread_safe(info->stream);
 
 	/* YMF262 setup */
 	ymf262_set_timer_handler (info->chip, timer_handler_262, info);
@@ -112,6 +116,7 @@ static DEVICE_STOP( ymf262 )
 static DEVICE_RESET( ymf262 )
 {
 	ymf262_state *info = get_safe_token(device);
+	soundlog_reset(device);
 	ymf262_reset_chip(info->chip);
 }
 
@@ -125,7 +130,11 @@ READ8_DEVICE_HANDLER( ymf262_r )
 WRITE8_DEVICE_HANDLER( ymf262_w )
 {
 	ymf262_state *info = get_safe_token(device);
+
+	soundlog_write(device, offset, data);
 	ymf262_write(info->chip, offset & 3, data);
+	if (!ymf262_is_idle(info->chip))
+		stream_wake(info->stream);
 }
 
 READ8_DEVICE_HANDLER ( ymf262_status_r ) { return ymf262_r(device, 0); }
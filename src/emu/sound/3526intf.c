@@ -18,6 +18,7 @@
 ******************************************************************************/
 #include "sndintrf.h"
 #include "streams.h"
+#include "soundlog.h"
 #include "cpuintrf.h"
 #include "3526intf.h"
 #include "fm.h"
@@ -81,6 +82,8 @@ static STREAM_UPDATE( ym3526_stream_update )
 {
 	ym3526_state *info = (ym3526_state *)param;
 	ym3526_update_one(info->chip, outputs[0], samples);
+	if (ym3526_is_idle(info->chip))
+		stream_set_idle(info->stream);
 }
 
 static void _stream_update(void *param, int interval)
@@ -122,6 +125,7 @@ static DEVICE_STOP( ym3526 )
 static DEVICE_RESET( ym3526 )
 {
 	ym3526_state *info = get_safe_token(device);
+	soundlog_reset(device);
 	ym3526_reset_chip(info->chip);
 }
 
@@ -135,7 +139,11 @@ READ8_DEVICE_HANDLER( ym3526_r )
 WRITE8_DEVICE_HANDLER( ym3526_w )
 {
 	ym3526_state *info = get_safe_token(device);
+
+	soundlog_write(device, offset, data);
 	ym3526_write(info->chip, offset & 1, data);
+	if (!ym3526_is_idle(info->chip))
+		stream_wake(info->stream);
 }
 
 READ8_DEVICE_HANDLER( ym3526_status_port_r ) { return ym3526_r(device, 0); }
@@ -18,6 +18,7 @@
 ******************************************************************************/
 #include "sndintrf.h"
 #include "streams.h"
+#include "soundlog.h"
 #include "cpuintrf.h"
 #include "3812intf.h"
 #include "fm.h"
@@ -81,6 +82,8 @@ static STREAM_UPDATE( ym3812_stream_update )
 {
 	ym3812_state *info = (ym3812_state *)param;
 	ym3812_update_one(info->chip, outputs[0], samples);
+	if (ym3812_is_idle(info->chip))
+		stream_set_idle(info->stream);
 }
 
 static void _stream_update(void * param, int interval)
@@ -104,6 +107,7 @@ static DEVICE_START( ym3812 )
 	assert_always(info->chip != NULL, "Error creating YM3812 chip");
 
 	info->stream = stream_create(device,0,1,rate,info,ym3812_stream_update);
+	stream_set_thread_safe(info->stream);
 
 	/* YM3812 setup */
 	ym3812_set_timer_handler (info->chip, TimerHandler, info);
@@ -123,6 +127,7 @@ static DEVICE_STOP( ym3812 )
 static DEVICE_RESET( ym3812 )
 {
 	ym3812_state *info = get_safe_token(device);
+	soundlog_reset(device);
 	ym3812_reset_chip(info->chip);
 }
 
@@ -136,7 +141,11 @@ READ8_DEVICE_HANDLER( ym3812_r )
 WRITE8_DEVICE_HANDLER( ym3812_w )
 {
 	ym3812_state *info = get_safe_token(device);
+
+	soundlog_write(device, offset, data);
 	ym3812_write(info->chip, offset & 1, data);
+	if (!ym3812_is_idle(info->chip))
+		stream_wake(info->stream);
 }
 
 READ8_DEVICE_HANDLER( ym3812_status_port_r ) { return ym3812_r(device, 0); }
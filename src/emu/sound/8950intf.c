@@ -18,6 +18,7 @@
 ******************************************************************************/
 #include "sndintrf.h"
 #include "streams.h"
+#include "soundlog.h"
 #include "cpuintrf.h"
 #include "8950intf.h"
 #include "fm.h"
@@ -108,6 +109,8 @@ static STREAM_UPDATE( y8950_stream_update )
 {
 	y8950_state *info = (y8950_state *)param;
 	y8950_update_one(info->chip, outputs[0], samples);
+	if (y8950_is_idle(info->chip))
+		stream_set_idle(info->stream);
 }
 
 static void _stream_update(void *param, int interval)
@@ -157,6 +160,7 @@ static DEVICE_STOP( y8950 )
 static DEVICE_RESET( y8950 )
 {
 	y8950_state *info = get_safe_token(device);
+	soundlog_reset(device);
 	y8950_reset_chip(info->chip);
 }
 
@@ -170,7 +174,11 @@ READ8_DEVICE_HANDLER( y8950_r )
 WRITE8_DEVICE_HANDLER( y8950_w )
 {
 	y8950_state *info = get_safe_token(device);
+
+	soundlog_write(device, offset, data);
 	y8950_write(info->chip, offset & 1, data);
+	if (!y8950_is_idle(info->chip))
+		stream_wake(info->stream);
 }
 
 READ8_DEVICE_HANDLER( y8950_status_port_r ) { return y8950_r(device, 0); }
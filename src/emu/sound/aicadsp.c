@@ -62,7 +62,25 @@ void aica_dsp_init(struct _AICADSP *DSP)
 	DSP->Stopped=1;
 }
 
-void aica_dsp_step(struct _AICADSP *DSP)
+/*
+    The microprogram is decoded into OPS[] whenever MPRO changes, so the
+    per-sample loop below only reads pre-extracted fields. Set
+    AICADSP_VALIDATE to 1 to also run the original field-decoding
+    interpreter every sample and log any difference in the results.
+*/
+#define AICADSP_VALIDATE	0
+
+#if AICADSP_VALIDATE
+struct _AICADSP_UNDO
+{
+	UINT32 addr[128];	//address of each memory write, in program order
+	UINT16 data[128];	//word it overwrote
+	UINT16 final[128];	//word left there once the program finished
+	int count;
+};
+
+/* reference interpreter, decoding every field from MPRO each sample */
+static void aica_dsp_interpret(struct _AICADSP *DSP, struct _AICADSP_UNDO *undo)
 {
 	INT32 ACC=0;	//26 bit
 	INT32 SHIFTED=0;	//24 bit
@@ -303,6 +321,8 @@ void aica_dsp_step(struct _AICADSP *DSP)
 			}
 			if(MWT && (step&1))
 			{
+				undo->addr[undo->count]=ADDR;
+				undo->data[undo->count++]=DSP->AICARAM[ADDR];
 				if(NOFL)
 					DSP->AICARAM[ADDR]=SHIFTED>>8;
 				else
@@ -327,6 +347,264 @@ void aica_dsp_step(struct _AICADSP *DSP)
 //  if(f)
 //      fclose(f);
 }
+#endif	/* AICADSP_VALIDATE */
+
+static void aica_dsp_decode(struct _AICADSP *DSP)
+{
+	int step;
+
+	for(step=0;step<128;++step)
+	{
+		const UINT16 *IPtr=DSP->MPRO+step*8;
+		struct _AICADSP_OP *op=&DSP->OPS[step];
+
+		op->TRA=(IPtr[0]>>9)&0x7F;
+		op->TWT=(IPtr[0]>>8)&0x01;
+		op->TWA=(IPtr[0]>>1)&0x7F;
+
+		op->XSEL=(IPtr[2]>>15)&0x01;
+		op->YSEL=(IPtr[2]>>13)&0x03;
+		op->IRA=(IPtr[2]>>7)&0x3F;
+		op->IWT=(IPtr[2]>>6)&0x01;
+		op->IWA=(IPtr[2]>>1)&0x1F;
+
+		op->TABLE=(IPtr[4]>>15)&0x01;
+		op->EWT=(IPtr[4]>>12)&0x01;
+		op->EWA=(IPtr[4]>>8)&0x0F;
+		op->ADRL=(IPtr[4]>>7)&0x01;
+		op->FRCL=(IPtr[4]>>6)&0x01;
+		op->SHIFT=(IPtr[4]>>4)&0x03;
+		op->YRL=(IPtr[4]>>3)&0x01;
+		op->NEGB=(IPtr[4]>>2)&0x01;
+		op->ZERO=(IPtr[4]>>1)&0x01;
+		op->BSEL=(IPtr[4]>>0)&0x01;
+
+		op->NOFL=(IPtr[6]>>15)&1;
+		op->COEF=step;
+		op->MASA=(IPtr[6]>>9)&0x1f;
+		op->ADREB=(IPtr[6]>>8)&0x1;
+		op->NXADR=(IPtr[6]>>7)&0x1;
+
+		//memory is only accessed on odd steps, so even steps never touch it
+		op->MRD=((IPtr[4]>>13)&0x01) && (step&1);
+		op->MWT=((IPtr[4]>>14)&0x01) && (step&1);
+	}
+	DSP->Dirty=0;
+}
+
+static void aica_dsp_execute(struct _AICADSP *DSP)
+{
+	INT32 ACC=0;	//26 bit
+	INT32 SHIFTED=0;	//24 bit
+	INT32 X=0;	//24 bit
+	INT32 Y=0;	//13 bit
+	INT32 B=0;	//26 bit
+	INT32 INPUTS=0;	//24 bit
+	INT32 MEMVAL=0;
+	INT32 FRC_REG=0;	//13 bit
+	INT32 Y_REG=0;		//24 bit
+	UINT32 ADDR=0;
+	UINT32 ADRS_REG=0;	//13 bit
+	const struct _AICADSP_OP *op=DSP->OPS;
+	const struct _AICADSP_OP *last=op+DSP->LastStep;
+
+	memset(DSP->EFREG,0,2*16);
+	for(;op<last;++op)
+	{
+		INT64 v;
+
+		//INPUTS RW
+		assert(op->IRA<0x32);
+		if(op->IRA<=0x1f)
+			INPUTS=DSP->MEMS[op->IRA];
+		else if(op->IRA<=0x2F)
+			INPUTS=DSP->MIXS[op->IRA-0x20]<<4;	//MIXS is 20 bit
+		else if(op->IRA<=0x31)
+			INPUTS=0;
+
+		INPUTS<<=8;
+		INPUTS>>=8;
+
+		if(op->IWT)
+		{
+			DSP->MEMS[op->IWA]=MEMVAL;	//MEMVAL was selected in previous MRD
+			if(op->IRA==op->IWA)
+				INPUTS=MEMVAL;
+		}
+
+		//Operand sel
+		//B
+		if(!op->ZERO)
+		{
+			if(op->BSEL)
+				B=ACC;
+			else
+			{
+				B=DSP->TEMP[(op->TRA+DSP->DEC)&0x7F];
+				B<<=8;
+				B>>=8;
+			}
+			if(op->NEGB)
+				B=0-B;
+		}
+		else
+			B=0;
+
+		//X
+		if(op->XSEL)
+			X=INPUTS;
+		else
+		{
+			X=DSP->TEMP[(op->TRA+DSP->DEC)&0x7F];
+			X<<=8;
+			X>>=8;
+		}
+
+		//Y
+		switch(op->YSEL)
+		{
+			case 0:	Y=FRC_REG;						break;
+			case 1:	Y=DSP->COEF[op->COEF<<1]>>3;		break;	//COEF is 16 bits
+			case 2:	Y=(Y_REG>>11)&0x1FFF;			break;
+			case 3:	Y=(Y_REG>>4)&0x0FFF;			break;
+		}
+
+		if(op->YRL)
+			Y_REG=INPUTS;
+
+		//Shifter
+		switch(op->SHIFT)
+		{
+			case 0:
+				SHIFTED=ACC;
+				if(SHIFTED>0x007FFFFF)
+					SHIFTED=0x007FFFFF;
+				if(SHIFTED<(-0x00800000))
+					SHIFTED=-0x00800000;
+				break;
+
+			case 1:
+				SHIFTED=ACC*2;
+				if(SHIFTED>0x007FFFFF)
+					SHIFTED=0x007FFFFF;
+				if(SHIFTED<(-0x00800000))
+					SHIFTED=-0x00800000;
+				break;
+
+			case 2:
+				SHIFTED=ACC*2;
+				SHIFTED<<=8;
+				SHIFTED>>=8;
+				break;
+
+			case 3:
+				SHIFTED=ACC;
+				SHIFTED<<=8;
+				SHIFTED>>=8;
+				break;
+		}
+
+		//ACCUM
+		Y<<=19;
+		Y>>=19;
+
+		v=(((INT64) X*(INT64) Y)>>12);
+		ACC=(int) v+B;
+
+		if(op->TWT)
+			DSP->TEMP[(op->TWA+DSP->DEC)&0x7F]=SHIFTED;
+
+		if(op->FRCL)
+		{
+			if(op->SHIFT==3)
+				FRC_REG=SHIFTED&0x0FFF;
+			else
+				FRC_REG=(SHIFTED>>11)&0x1FFF;
+		}
+
+		if(op->MRD || op->MWT)
+		{
+			ADDR=DSP->MADRS[op->MASA<<1];
+			if(!op->TABLE)
+				ADDR+=DSP->DEC;
+			if(op->ADREB)
+				ADDR+=ADRS_REG&0x0FFF;
+			if(op->NXADR)
+				ADDR++;
+			if(!op->TABLE)
+				ADDR&=DSP->RBL-1;
+			else
+				ADDR&=0xFFFF;
+			ADDR+=DSP->RBP<<10;
+			if(op->MRD)
+			{
+				if(op->NOFL)
+					MEMVAL=DSP->AICARAM[ADDR]<<8;
+				else
+					MEMVAL=UNPACK(DSP->AICARAM[ADDR]);
+			}
+			if(op->MWT)
+			{
+				if(op->NOFL)
+					DSP->AICARAM[ADDR]=SHIFTED>>8;
+				else
+					DSP->AICARAM[ADDR]=PACK(SHIFTED);
+			}
+		}
+
+		if(op->ADRL)
+		{
+			if(op->SHIFT==3)
+				ADRS_REG=(SHIFTED>>12)&0xFFF;
+			else
+				ADRS_REG=(INPUTS>>16);
+		}
+
+		if(op->EWT)
+			DSP->EFREG[op->EWA]+=SHIFTED>>8;
+	}
+	--DSP->DEC;
+	memset(DSP->MIXS,0,4*16);
+}
+
+void aica_dsp_step(struct _AICADSP *DSP)
+{
+#if AICADSP_VALIDATE
+	struct _AICADSP *ref;
+	struct _AICADSP_UNDO undo;
+	int i;
+#endif
+
+	if(DSP->Stopped)
+		return;
+
+	if(DSP->Dirty)
+		aica_dsp_decode(DSP);
+
+#if AICADSP_VALIDATE
+	//run the interpreter on a copy, then roll its memory writes back
+	ref=(struct _AICADSP *)malloc(sizeof(*ref));
+	*ref=*DSP;
+	undo.count=0;
+	aica_dsp_interpret(ref,&undo);
+	for(i=0;i<undo.count;++i)
+		undo.final[i]=DSP->AICARAM[undo.addr[i]];
+	for(i=undo.count-1;i>=0;--i)
+		DSP->AICARAM[undo.addr[i]]=undo.data[i];
+#endif
+
+	aica_dsp_execute(DSP);
+
+#if AICADSP_VALIDATE
+	if(memcmp(ref->TEMP,DSP->TEMP,sizeof(DSP->TEMP)) || memcmp(ref->MEMS,DSP->MEMS,sizeof(DSP->MEMS)) ||
+	   memcmp(ref->EFREG,DSP->EFREG,sizeof(DSP->EFREG)) || ref->DEC!=DSP->DEC)
+		logerror("AICADSP: decoded program diverged from interpreter (DEC=%04X)\n",DSP->DEC);
+	for(i=0;i<undo.count;++i)
+		if(DSP->AICARAM[undo.addr[i]]!=undo.final[i])
+			logerror("AICADSP: decoded program left %04X at %05X, interpreter left %04X\n",DSP->AICARAM[undo.addr[i]],undo.addr[i],undo.final[i]);
+	free(ref);
+#endif
+}
 
 void aica_dsp_setsample(struct _AICADSP *DSP,INT32 sample,int SEL,int MXL)
 {
@@ -348,5 +626,6 @@ void aica_dsp_start(struct _AICADSP *DSP)
 			break;
 	}
 	DSP->LastStep=i+1;
+	aica_dsp_decode(DSP);
 
 }
@@ -781,6 +781,7 @@ void *ay8910_start_ym(void *infoptr, sound_type chip_type, const device_config *
 	/* The envelope is pacing twice as fast for the YM2149 as for the AY-3-8910,    */
 	/* This handled by the step parameter. Consequently we use a divider of 8 here. */
 	info->channel = stream_create(device, 0, info->streams, device->clock / 8, info, ay8910_update);
+	stream_set_thread_safe(info->channel);
 
 	ay8910_set_clock_ym(info,device->clock);
 	ay8910_statesave(info, device);
@@ -338,7 +338,7 @@ static void c352_mix_one_channel(c352_state *info, unsigned long ch, long sample
 static STREAM_UPDATE( c352_update )
 {
 	c352_state *info = (c352_state *)param;
-	int i, j;
+	int i, j, busy = 0;
 	stream_sample_t *bufferl = outputs[0];
 	stream_sample_t *bufferr = outputs[1];
 	stream_sample_t *bufferl2 = outputs[2];
@@ -352,6 +352,7 @@ static STREAM_UPDATE( c352_update )
 	for (j = 0 ; j < 32 ; j++)
 	{
 		c352_mix_one_channel(info, j, samples);
+		busy |= info->c352_ch[j].flag & C352_FLG_BUSY;
 	}
 
 	for(i = 0 ; i < samples ; i++)
@@ -361,6 +362,10 @@ static STREAM_UPDATE( c352_update )
 		*bufferl2++ = (short) (info->channel_l2[i] >>3);
 		*bufferr2++ = (short) (info->channel_r2[i] >>3);
 	}
+
+	/* nothing is playing; wait for a register write */
+	if (!busy)
+		stream_set_idle(info->stream);
 }
 
 static unsigned short c352_read_reg16(c352_state *info, unsigned long address)
@@ -394,7 +399,9 @@ static void c352_write_reg16(c352_state *info, unsigned long address, unsigned s
 	unsigned long	chan;
 	int i;
 
+	/* any write may key on a channel */
 	stream_update(info->stream);
+	stream_wake(info->stream);
 
 	chan = (address >> 4) & 0xfff;
 
@@ -7,6 +7,7 @@
 #include "streams.h"
 #include "cdrom.h"
 #include "cdda.h"
+#include "samplesrc.h"
 #include "sound.h"
 #include "driver.h"
 
@@ -18,10 +19,10 @@ struct _cdda_info
 
 	INT8				audio_playing, audio_pause, audio_ended_normally;
 	UINT32				audio_lba, audio_length;
+	UINT32				audio_frame;
 
-	UINT8 *				audio_cache;
-	UINT32				audio_samples;
-	UINT32				audio_bptr;
+	sample_source *		reader;
+	UINT8 *				sector;
 };
 
 INLINE cdda_info *get_safe_token(const device_config *device)
@@ -34,7 +35,9 @@ INLINE cdda_info *get_safe_token(const device_config *device)
 }
 
 #define MAX_SECTORS ( 4 )
+#define SECTOR_FRAMES ( CD_MAX_SECTOR_DATA / 4 )
 
+static UINT32 cdda_read(void *param, UINT32 position, INT16 *dest, UINT32 frames);
 static void get_audio_data(cdda_info *info, stream_sample_t *bufL, stream_sample_t *bufR, UINT32 samples_wanted);
 
 
@@ -58,8 +61,9 @@ static DEVICE_START( cdda )
 	const struct CDDAinterface *intf;
 	cdda_info *info = get_safe_token(device);
 
-	/* allocate an audio cache */
-	info->audio_cache = auto_alloc_array( device->machine, UINT8, CD_MAX_SECTOR_DATA * MAX_SECTORS );
+	/* allocate a source that decodes a few sectors ahead of playback */
+	info->reader = sample_source_alloc( device->machine, 2, SECTOR_FRAMES * MAX_SECTORS, cdda_read, info );
+	info->sector = auto_alloc_array( device->machine, UINT8, CD_MAX_SECTOR_DATA );
 
 	intf = (const struct CDDAinterface *)device->static_config;
 
@@ -70,9 +74,7 @@ static DEVICE_START( cdda )
 	state_save_register_device_item( device, 0, info->audio_ended_normally );
 	state_save_register_device_item( device, 0, info->audio_lba );
 	state_save_register_device_item( device, 0, info->audio_length );
-	state_save_register_device_item_pointer( device, 0, info->audio_cache, CD_MAX_SECTOR_DATA * MAX_SECTORS );
-	state_save_register_device_item( device, 0, info->audio_samples );
-	state_save_register_device_item( device, 0, info->audio_bptr );
+	state_save_register_device_item( device, 0, info->audio_frame );
 }
 
 
@@ -85,6 +87,7 @@ void cdda_set_cdrom(const device_config *device, void *file)
 {
 	cdda_info *info = get_safe_token(device);
 	info->disc = (cdrom_file *)file;
+	sample_source_flush(info->reader);
 }
 
 
@@ -124,6 +127,7 @@ void cdda_start_audio(const device_config *device, UINT32 startlba, UINT32 numbl
 	info->audio_ended_normally = FALSE;
 	info->audio_lba = startlba;
 	info->audio_length = numblocks;
+	info->audio_frame = 0;
 }
 
 
@@ -159,6 +163,8 @@ void cdda_pause_audio(const device_config *device, int pause)
 /*-------------------------------------------------
     cdda_get_audio_lba - returns the current LBA
     (physical sector) during Red Book playback
+    (the sector being heard, not the one being
+    read ahead)
 -------------------------------------------------*/
 
 UINT32 cdda_get_audio_lba(const device_config *device)
@@ -209,89 +215,93 @@ int cdda_audio_ended(const device_config *device)
 
 
 /*-------------------------------------------------
-    get_audio_data - reads Red Book data off
-    the disc if playback is in progress and
-    converts it to 2 16-bit 44.1 kHz streams
+    cdda_read - sample source callback that reads
+    Red Book frames off the disc, stopping at the
+    end of the track being played
 -------------------------------------------------*/
 
-static void get_audio_data(cdda_info *info, stream_sample_t *bufL, stream_sample_t *bufR, UINT32 samples_wanted)
+static UINT32 cdda_read(void *param, UINT32 position, INT16 *dest, UINT32 frames)
 {
-	int i, sectoread, remaining;
-	INT16 *audio_cache = (INT16 *) info->audio_cache;
-
-	/* if no file, audio not playing, audio paused, or out of disc data,
-       just zero fill */
-	if (!info->disc || !info->audio_playing || info->audio_pause || (!info->audio_length && !info->audio_samples))
-	{
-		if( info->disc && info->audio_playing && !info->audio_pause && !info->audio_length )
-		{
-			info->audio_playing = FALSE;
-			info->audio_ended_normally = TRUE;
-		}
+	cdda_info *info = (cdda_info *)param;
+	UINT32 end = (info->audio_lba + info->audio_length) * SECTOR_FRAMES;
+	UINT32 total = 0;
 
-		memset(bufL, 0, sizeof(stream_sample_t)*samples_wanted);
-		memset(bufR, 0, sizeof(stream_sample_t)*samples_wanted);
-		return;
-	}
+	if (info->disc == NULL || position >= end)
+		return 0;
+	frames = MIN(frames, end - position);
 
-	/* if we've got enough samples, just feed 'em out */
-	if (samples_wanted <= info->audio_samples)
+	while (total < frames)
 	{
-		for (i = 0; i < samples_wanted; i++)
-		{
-			*bufL++ = audio_cache[ info->audio_bptr++ ];
-			*bufR++ = audio_cache[ info->audio_bptr++ ];
-		}
-
-		info->audio_samples -= samples_wanted;
-		return;
-	}
+		UINT32 offset = position % SECTOR_FRAMES;
+		UINT32 count = MIN(frames - total, SECTOR_FRAMES - offset);
+		const INT16 *sector = (const INT16 *)info->sector + offset * 2;
+		UINT32 i;
 
-	/* we don't have enough, so first feed what we've got */
-	for (i = 0; i < info->audio_samples; i++)
-	{
-		*bufL++ = audio_cache[ info->audio_bptr++ ];
-		*bufR++ = audio_cache[ info->audio_bptr++ ];
-	}
+		if (!cdrom_read_data(info->disc, position / SECTOR_FRAMES, info->sector, CD_TRACK_AUDIO))
+			memset(info->sector, 0, CD_MAX_SECTOR_DATA);
 
-	/* remember how much left for later */
-	remaining = samples_wanted - info->audio_samples;
+		/* CD-DA data on the disc is big-endian, flip if we're not */
+		for (i = 0; i < count * 2; i++)
+			*dest++ = BIG_ENDIANIZE_INT16(sector[i]);
 
-	/* reset the buffer and get what we can from the disc */
-	info->audio_samples = 0;
-	if (info->audio_length >= MAX_SECTORS)
-	{
-		sectoread = MAX_SECTORS;
+		position += count;
+		total += count;
 	}
-	else
-	{
-		sectoread = info->audio_length;
-	}
-
-	for (i = 0; i < sectoread; i++)
-	{
-		cdrom_read_data(info->disc, info->audio_lba, &info->audio_cache[CD_MAX_SECTOR_DATA*i], CD_TRACK_AUDIO);
+	return total;
+}
 
-		info->audio_lba++;
-	}
 
-	info->audio_samples = (CD_MAX_SECTOR_DATA*sectoread)/4;
-	info->audio_length -= sectoread;
+/*-------------------------------------------------
+    get_audio_data - feeds decoded Red Book data
+    out as 2 16-bit 44.1 kHz streams if playback
+    is in progress
+-------------------------------------------------*/
 
-	/* CD-DA data on the disc is big-endian, flip if we're not */
-	if (ENDIANNESS_NATIVE == ENDIANNESS_LITTLE)
+static void get_audio_data(cdda_info *info, stream_sample_t *bufL, stream_sample_t *bufR, UINT32 samples_wanted)
+{
+	/* feed out frames while audio is playing and there's disc data left */
+	if (info->disc && info->audio_playing && !info->audio_pause)
 	{
-		for( i = 0; i < info->audio_samples * 2; i++ )
+		while (samples_wanted > 0 && info->audio_length > 0)
 		{
-			audio_cache[ i ] = BIG_ENDIANIZE_INT16( audio_cache[ i ] );
+			UINT32 position = info->audio_lba * SECTOR_FRAMES + info->audio_frame;
+			const INT16 *data;
+			UINT32 frames, i;
+
+			/* take what's decoded, up to the end of the current sector */
+			data = sample_source_fetch(info->reader, position, 1, &frames);
+			frames = MIN(frames, samples_wanted);
+			frames = MIN(frames, SECTOR_FRAMES - info->audio_frame);
+			if (frames == 0)
+				break;
+
+			for (i = 0; i < frames; i++)
+			{
+				*bufL++ = *data++;
+				*bufR++ = *data++;
+			}
+			samples_wanted -= frames;
+
+			/* move on to the next sector once this one is done */
+			info->audio_frame += frames;
+			if (info->audio_frame == SECTOR_FRAMES)
+			{
+				info->audio_frame = 0;
+				info->audio_lba++;
+				info->audio_length--;
+			}
 		}
-	}
 
-	/* reset feedout ptr */
-	info->audio_bptr = 0;
+		if (!info->audio_length)
+		{
+			info->audio_playing = FALSE;
+			info->audio_ended_normally = TRUE;
+		}
+	}
 
-	/* we've got data, feed it out by calling ourselves recursively */
-	get_audio_data(info, bufL, bufR, remaining);
+	/* zero fill whatever is left */
+	memset(bufL, 0, sizeof(stream_sample_t)*samples_wanted);
+	memset(bufR, 0, sizeof(stream_sample_t)*samples_wanted);
 }
 
 
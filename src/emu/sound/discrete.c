@@ -316,33 +316,64 @@ static const discrete_module module_list[] =
 	{ DSS_NULL        ,"DSS_NULL"        , 0 ,0                                      ,NULL                  ,NULL                 ,NULL                  ,NULL                 }
 };
 
-INLINE void step_nodes_in_list(const linked_list_entry *list)
+/*************************************
+ *
+ *  Task programs
+ *
+ *************************************/
+
+/* Each task's node list is compiled into a flat array of step
+ * function / node pairs at start, so the inner loop runs down a
+ * contiguous array instead of chasing list pointers and reloading
+ * node->step for every node of every sample. */
+
+static void compile_task_program(const discrete_info *info, discrete_task *task)
 {
 	const linked_list_entry *entry;
+	int count = linked_list_count(task->list);
 
-	if (EXPECTED(!profiling))
+	if (task->program == NULL)
 	{
-		for (entry = list; entry != NULL; entry = entry->next)
-		{
-			node_description *node = (node_description *) entry->ptr;
+		task->program = auto_alloc_array_clear(info->device->machine, discrete_step, MAX(count, 1));
+		task->program_count = count;
+	}
+	assert(task->program_count == count);
 
-			/* Now step the node */
-			(*node->step)(node);
-		}
+	/* fill in the current step functions; reset may select a faster variant */
+	for (entry = task->list, count = 0; entry != NULL; entry = entry->next, count++)
+	{
+		node_description *node = (node_description *) entry->ptr;
+
+		task->program[count].step = node->step;
+		task->program[count].node = node;
+	}
+}
+
+INLINE void step_task_program(const discrete_task *task, int samples)
+{
+	const discrete_step *program = task->program;
+	const discrete_step *last = program + task->program_count;
+	const discrete_step *op;
+
+	if (EXPECTED(!profiling))
+	{
+		while (samples-- > 0)
+			for (op = program; op < last; op++)
+				(*op->step)(op->node);
 	}
 	else
 	{
-		osd_ticks_t last = get_profile_ticks();
+		osd_ticks_t now = get_profile_ticks();
 
-		for (entry = list; entry != NULL; entry = entry->next)
-		{
-			node_description *node = (node_description *) entry->ptr;
+		while (samples-- > 0)
+			for (op = program; op < last; op++)
+			{
+				osd_ticks_t prev = now;
 
-			node->run_time -= last;
-			(*node->step)(node);
-			last = get_profile_ticks();
-			node->run_time += last;
-		}
+				(*op->step)(op->node);
+				now = get_profile_ticks();
+				op->node->run_time += now - prev;
+			}
 	}
 }
 
@@ -544,6 +575,9 @@ static DEVICE_START( discrete )
 			(*node->module->start)(node);
 	}
 
+	/* compile each task's node list into a flat program */
+	for (entry = info->task_list; entry != NULL; entry = entry->next)
+		compile_task_program(info, (discrete_task *) entry->ptr);
 }
 
 
@@ -597,7 +631,7 @@ static void display_profiling(const discrete_info *info)
 		discrete_task *task = (discrete_task *) entry->ptr;
 		tt =  list_run_time(task->list);
 
-		printf("Task(%d): %8.2f %15.2f\n", task->task_group, tt / (double) total * 100.0, tt / (double) info->total_samples);
+		printf("Task(%d): %8.2f %15.2f %4d nodes\n", task->task_group, tt / (double) total * 100.0, tt / (double) info->total_samples, task->program_count);
 	}
 
 	printf("Average samples/stream_update: %8.2f\n", (double) info->total_samples / (double) info->total_stream_updates);
@@ -662,6 +696,10 @@ static DEVICE_RESET( discrete )
 		else if (node->step)
 			(*node->step)(node);
 	}
+
+	/* reset may have changed step functions, so refresh the programs */
+	for (entry = info->task_list; entry != NULL; entry = entry->next)
+		compile_task_program(info, (discrete_task *) entry->ptr);
 }
 
 /*************************************
@@ -705,12 +743,9 @@ static void *task_callback(void *param, int threadid)
 
 				task->samples -= samples;
 				assert_always(task->samples >=0, "task_callback: task_samples got negative");
-				while (samples > 0)
-				{
-					/* step */
-					step_nodes_in_list(task->list);
-					samples--;
-				}
+
+				/* run the whole slice through the compiled program */
+				step_task_program(task, samples);
 				if (task->samples == 0)
 				{
 					return NULL;
@@ -3804,11 +3804,23 @@ struct _linked_list_entry
 	const void 			*ptr;
 };
 
+/* one instruction of a compiled task program */
+typedef struct _discrete_step discrete_step;
+struct _discrete_step
+{
+	DISCRETE_FUNC((*step));						/* node step function */
+	node_description 		*node;				/* node to step */
+};
+
 typedef struct _discrete_task discrete_task;
 struct _discrete_task
 {
 	const linked_list_entry *list;
 
+	/* flat program compiled from list, in running order */
+	discrete_step			*program;
+	int						program_count;
+
 	volatile INT32			threadid;
 	volatile int			samples;
 
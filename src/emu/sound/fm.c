@@ -1354,6 +1354,42 @@ INLINE void update_phase_lfo_channel(FM_OPN *OPN, FM_CH *CH)
 	}
 }
 
+/* a channel can be left out of a whole update when every operator is off
+   (only a register write or CSM can key it on again), its feedback and MEM
+   delays have drained and it has no LFO phase modulation; chan_calc() would
+   then only step its phase counters, which is done once at the end instead */
+INLINE int chan_is_silent(FM_CH *CH)
+{
+	return CH->SLOT[SLOT1].state == EG_OFF && CH->SLOT[SLOT2].state == EG_OFF &&
+	       CH->SLOT[SLOT3].state == EG_OFF && CH->SLOT[SLOT4].state == EG_OFF &&
+	       !CH->pms && !CH->op1_out[0] && !CH->op1_out[1] && !CH->mem_value;
+}
+
+/* return a mask of the channels that are silent for the whole update */
+static UINT32 silent_channels(FM_OPN *OPN, FM_CH **cch, int chans)
+{
+	UINT32 mask = 0;
+	int c;
+
+	if( OPN->ST.mode & 0x80 )	/* CSM may key channel 3 on */
+		return 0;
+	for( c = 0 ; c < chans ; c++ )
+		if( chan_is_silent(cch[c]) )
+			mask |= 1 << c;
+	return mask;
+}
+
+/* step the phase counters of the skipped channels by a whole update */
+static void skip_silent_channels(FM_CH **cch, int chans, UINT32 mask, int length)
+{
+	int c,s;
+
+	for( c = 0 ; c < chans ; c++ )
+		if( mask & (1 << c) )
+			for( s = 0 ; s < 4 ; s++ )
+				cch[c]->SLOT[s].phase += (UINT32)cch[c]->SLOT[s].Incr * (UINT32)length;
+}
+
 INLINE void chan_calc(FM_OPN *OPN, FM_CH *CH, int chnum)
 {
 	unsigned int eg_out;
@@ -2035,6 +2071,21 @@ static void OPNWriteReg(FM_OPN *OPN, int r, int v)
 	}
 }
 
+/* TRUE if every operator of the given channels has finished its release and
+   CSM mode cannot key them on again; the FM part then only outputs silence */
+static int OPN_idle(FM_OPN *OPN, FM_CH *CH, int chans)
+{
+	int c,s;
+
+	if( OPN->ST.mode & 0x80 )
+		return 0;
+	for( c = 0 ; c < chans ; c++ )
+		for( s = 0 ; s < 4 ; s++ )
+			if( CH[c].SLOT[s].state != EG_OFF )
+				return 0;
+	return 1;
+}
+
 #endif /* BUILD_OPN */
 
 #if BUILD_OPN_PRESCALER
@@ -2107,6 +2158,7 @@ void ym2203_update_one(void *chip, FMSAMPLE *buffer, int length)
 	int i;
 	FMSAMPLE *buf = buffer;
 	FM_CH	*cch[3];
+	UINT32	silent;
 
 	cch[0]   = &F2203->CH[0];
 	cch[1]   = &F2203->CH[1];
@@ -2133,6 +2185,9 @@ void ym2203_update_one(void *chip, FMSAMPLE *buffer, int length)
 	LFO_AM = 0;
 	LFO_PM = 0;
 
+	/* leave out the channels that are silent for this whole update */
+	silent = silent_channels(OPN, cch, 3);
+
 	/* buffering */
 	for (i=0; i < length ; i++)
 	{
@@ -2154,9 +2209,9 @@ void ym2203_update_one(void *chip, FMSAMPLE *buffer, int length)
 		}
 
 		/* calculate FM */
-		chan_calc(OPN, cch[0], 0 );
-		chan_calc(OPN, cch[1], 1 );
-		chan_calc(OPN, cch[2], 2 );
+		if (!(silent & 0x01)) chan_calc(OPN, cch[0], 0 );
+		if (!(silent & 0x02)) chan_calc(OPN, cch[1], 1 );
+		if (!(silent & 0x04)) chan_calc(OPN, cch[2], 2 );
 
 		/* buffering */
 		{
@@ -2179,9 +2234,17 @@ void ym2203_update_one(void *chip, FMSAMPLE *buffer, int length)
 		/* timer A control */
 		INTERNAL_TIMER_A( &F2203->OPN.ST , cch[2] )
 	}
+	skip_silent_channels(cch, 3, silent, length);
 	INTERNAL_TIMER_B(&F2203->OPN.ST,length)
 }
 
+/* ---------- check if the chip has gone silent ---------- */
+int ym2203_is_idle(void *chip)
+{
+	YM2203 *F2203 = (YM2203 *)chip;
+	return OPN_idle( &F2203->OPN, F2203->CH, 3 );
+}
+
 /* ---------- reset one of chip ---------- */
 void ym2203_reset_chip(void *chip)
 {
@@ -2670,6 +2733,21 @@ static void FMsave_state_adpcma(const device_config *device,ADPCM_CH *adpcm)
 }
 #endif /* _STATE_H */
 
+/* TRUE if the FM, ADPCM-A and Delta-T units are all silent */
+static int YM2610_idle(YM2610 *F2610)
+{
+	int c;
+
+	if( !OPN_idle( &F2610->OPN, F2610->CH, 6 ) )
+		return 0;
+	if( F2610->deltaT.portstate & 0x80 )
+		return 0;
+	for( c = 0 ; c < 6 ; c++ )
+		if( F2610->adpcm[c].flag )
+			return 0;
+	return 1;
+}
+
 #endif /* (BUILD_YM2608||BUILD_YM2610||BUILD_YM2610B) */
 
 
@@ -3275,6 +3353,7 @@ void ym2608_update_one(void *chip, FMSAMPLE **buffer, int length)
 	int i,j;
 	FMSAMPLE  *bufL,*bufR;
 	FM_CH	*cch[6];
+	UINT32	silent;
 
 	/* set bufer */
 	bufL = buffer[0];
@@ -3309,6 +3388,9 @@ void ym2608_update_one(void *chip, FMSAMPLE **buffer, int length)
 	refresh_fc_eg_chan( OPN, cch[5] );
 
 
+	/* leave out the channels that are silent for this whole update */
+	silent = silent_channels(OPN, cch, 6);
+
 	/* buffering */
 	for(i=0; i < length ; i++)
 	{
@@ -3327,12 +3409,12 @@ void ym2608_update_one(void *chip, FMSAMPLE **buffer, int length)
 		out_fm[5] = 0;
 
 		/* calculate FM */
-		chan_calc(OPN, cch[0], 0 );
-		chan_calc(OPN, cch[1], 1 );
-		chan_calc(OPN, cch[2], 2 );
-		chan_calc(OPN, cch[3], 3 );
-		chan_calc(OPN, cch[4], 4 );
-		chan_calc(OPN, cch[5], 5 );
+		if (!(silent & 0x01)) chan_calc(OPN, cch[0], 0 );
+		if (!(silent & 0x02)) chan_calc(OPN, cch[1], 1 );
+		if (!(silent & 0x04)) chan_calc(OPN, cch[2], 2 );
+		if (!(silent & 0x08)) chan_calc(OPN, cch[3], 3 );
+		if (!(silent & 0x10)) chan_calc(OPN, cch[4], 4 );
+		if (!(silent & 0x20)) chan_calc(OPN, cch[5], 5 );
 
 		/* deltaT ADPCM */
 		if( DELTAT->portstate&0x80 )
@@ -3399,6 +3481,7 @@ void ym2608_update_one(void *chip, FMSAMPLE **buffer, int length)
 		/* timer A control */
 		INTERNAL_TIMER_A( &OPN->ST , cch[2] )
 	}
+	skip_silent_channels(cch, 6, silent, length);
 	INTERNAL_TIMER_B(&OPN->ST,length)
 
 
@@ -3406,6 +3489,13 @@ void ym2608_update_one(void *chip, FMSAMPLE **buffer, int length)
 	FM_STATUS_SET(&OPN->ST, 0);
 
 }
+
+/* ---------- check if the chip has gone silent ---------- */
+int ym2608_is_idle(void *chip)
+{
+	return YM2610_idle( (YM2608 *)chip );
+}
+
 #ifdef __STATE_H__
 void ym2608_postload(void *chip)
 {
@@ -3818,6 +3908,7 @@ void ym2610_update_one(void *chip, FMSAMPLE **buffer, int length)
 	int i,j;
 	FMSAMPLE  *bufL,*bufR;
 	FM_CH	*cch[4];
+	UINT32	silent;
 
 	/* buffer setup */
 	bufL = buffer[0];
@@ -3857,6 +3948,9 @@ void ym2610_update_one(void *chip, FMSAMPLE **buffer, int length)
 	refresh_fc_eg_chan( OPN, cch[2] );
 	refresh_fc_eg_chan( OPN, cch[3] );
 
+	/* leave out the channels that are silent for this whole update */
+	silent = silent_channels(OPN, cch, 4);
+
 	/* buffering */
 	for(i=0; i < length ; i++)
 	{
@@ -3886,10 +3980,10 @@ void ym2610_update_one(void *chip, FMSAMPLE **buffer, int length)
 		}
 
 		/* calculate FM */
-		chan_calc(OPN, cch[0], 1 );	/*remapped to 1*/
-		chan_calc(OPN, cch[1], 2 );	/*remapped to 2*/
-		chan_calc(OPN, cch[2], 4 );	/*remapped to 4*/
-		chan_calc(OPN, cch[3], 5 );	/*remapped to 5*/
+		if (!(silent & 0x01)) chan_calc(OPN, cch[0], 1 );	/*remapped to 1*/
+		if (!(silent & 0x02)) chan_calc(OPN, cch[1], 2 );	/*remapped to 2*/
+		if (!(silent & 0x04)) chan_calc(OPN, cch[2], 4 );	/*remapped to 4*/
+		if (!(silent & 0x08)) chan_calc(OPN, cch[3], 5 );	/*remapped to 5*/
 
 		/* deltaT ADPCM */
 		if( DELTAT->portstate&0x80 )
@@ -3941,6 +4035,7 @@ void ym2610_update_one(void *chip, FMSAMPLE **buffer, int length)
 		/* timer A control */
 		INTERNAL_TIMER_A( &OPN->ST , cch[1] )
 	}
+	skip_silent_channels(cch, 4, silent, length);
 	INTERNAL_TIMER_B(&OPN->ST,length)
 
 }
@@ -3955,6 +4050,7 @@ void ym2610b_update_one(void *chip, FMSAMPLE **buffer, int length)
 	int i,j;
 	FMSAMPLE  *bufL,*bufR;
 	FM_CH	*cch[6];
+	UINT32	silent;
 
 	/* buffer setup */
 	bufL = buffer[0];
@@ -3988,6 +4084,9 @@ void ym2610b_update_one(void *chip, FMSAMPLE **buffer, int length)
 	refresh_fc_eg_chan( OPN, cch[4] );
 	refresh_fc_eg_chan( OPN, cch[5] );
 
+	/* leave out the channels that are silent for this whole update */
+	silent = silent_channels(OPN, cch, 6);
+
 	/* buffering */
 	for(i=0; i < length ; i++)
 	{
@@ -4021,12 +4120,12 @@ void ym2610b_update_one(void *chip, FMSAMPLE **buffer, int length)
 		}
 
 		/* calculate FM */
-		chan_calc(OPN, cch[0], 0 );
-		chan_calc(OPN, cch[1], 1 );
-		chan_calc(OPN, cch[2], 2 );
-		chan_calc(OPN, cch[3], 3 );
-		chan_calc(OPN, cch[4], 4 );
-		chan_calc(OPN, cch[5], 5 );
+		if (!(silent & 0x01)) chan_calc(OPN, cch[0], 0 );
+		if (!(silent & 0x02)) chan_calc(OPN, cch[1], 1 );
+		if (!(silent & 0x04)) chan_calc(OPN, cch[2], 2 );
+		if (!(silent & 0x08)) chan_calc(OPN, cch[3], 3 );
+		if (!(silent & 0x10)) chan_calc(OPN, cch[4], 4 );
+		if (!(silent & 0x20)) chan_calc(OPN, cch[5], 5 );
 
 		/* deltaT ADPCM */
 		if( DELTAT->portstate&0x80 )
@@ -4080,11 +4179,18 @@ void ym2610b_update_one(void *chip, FMSAMPLE **buffer, int length)
 		/* timer A control */
 		INTERNAL_TIMER_A( &OPN->ST , cch[2] )
 	}
+	skip_silent_channels(cch, 6, silent, length);
 	INTERNAL_TIMER_B(&OPN->ST,length)
 
 }
 #endif /* BUILD_YM2610B */
 
+/* ---------- check if the chip has gone silent ---------- */
+int ym2610_is_idle(void *chip)
+{
+	return YM2610_idle( (YM2610 *)chip );
+}
+
 
 #ifdef __STATE_H__
 void ym2610_postload(void *chip)
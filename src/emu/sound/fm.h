@@ -140,6 +140,12 @@ void ym2203_reset_chip(void *chip);
 */
 void ym2203_update_one(void *chip, FMSAMPLE *buffer, int length);
 
+/*
+** check if all channels are keyed off and silent
+** return : TRUE if updating would only produce silence
+*/
+int ym2203_is_idle(void *chip);
+
 /*
 ** Write
 ** return : InterruptLevel
@@ -171,6 +177,7 @@ void * ym2608_init(void *param, const device_config *device, int baseclock, int
 void ym2608_shutdown(void *chip);
 void ym2608_reset_chip(void *chip);
 void ym2608_update_one(void *chip, FMSAMPLE **buffer, int length);
+int ym2608_is_idle(void *chip);
 
 int ym2608_write(void *chip, int a,unsigned char v);
 unsigned char ym2608_read(void *chip,int a);
@@ -186,6 +193,7 @@ void * ym2610_init(void *param, const device_config *device, int baseclock, int
 void ym2610_shutdown(void *chip);
 void ym2610_reset_chip(void *chip);
 void ym2610_update_one(void *chip, FMSAMPLE **buffer, int length);
+int ym2610_is_idle(void *chip);
 
 #if BUILD_YM2610B
 void ym2610b_update_one(void *chip, FMSAMPLE **buffer, int length);
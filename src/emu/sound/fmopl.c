@@ -2149,6 +2149,45 @@ static int OPLTimerOver(FM_OPL *OPL,int c)
 	return OPL->status>>7;
 }
 
+/* TRUE if all operators (and the Delta-T unit) are silent and CSM mode
+   cannot key them on again */
+static int OPLIdle(FM_OPL *OPL)
+{
+	int c,s;
+
+	if( OPL->mode & 0x80 )
+		return 0;
+	for( c=0; c<9; c++ )
+		for( s=0; s<2; s++ )
+			if( OPL->P_CH[c].SLOT[s].state != EG_OFF )
+				return 0;
+#if BUILD_Y8950
+	if( (OPL->type & OPL_TYPE_ADPCM) && (OPL->deltat->portstate & 0x80) )
+		return 0;
+#endif
+	return 1;
+}
+
+/* mask of the melody channels that can be left out of a whole update: both
+   slots off and the SLOT1 feedback delay drained.  Slot phases still move
+   on in advance(), and only a register write or CSM can key them on again */
+static UINT32 OPLSilentChannels(FM_OPL *OPL, int chans)
+{
+	UINT32 mask = 0;
+	int c;
+
+	if( OPL->mode & 0x80 )
+		return 0;
+	for( c=0; c<chans; c++ )
+	{
+		OPL_CH *CH = &OPL->P_CH[c];
+		if( CH->SLOT[SLOT1].state == EG_OFF && CH->SLOT[SLOT2].state == EG_OFF &&
+			!CH->SLOT[SLOT1].op1_out[0] && !CH->SLOT[SLOT1].op1_out[1] )
+			mask |= 1 << c;
+	}
+	return mask;
+}
+
 
 #define MAX_OPL_CHIPS 2
 
@@ -2197,6 +2236,11 @@ int ym3812_timer_over(void *chip, int c)
 	FM_OPL *YM3812 = (FM_OPL *)chip;
 	return OPLTimerOver(YM3812, c);
 }
+int ym3812_is_idle(void *chip)
+{
+	FM_OPL *YM3812 = (FM_OPL *)chip;
+	return OPLIdle(YM3812);
+}
 
 void ym3812_set_timer_handler(void *chip, OPL_TIMERHANDLER timer_handler, void *param)
 {
@@ -2228,6 +2272,7 @@ void ym3812_update_one(void *chip, OPLSAMPLE *buffer, int length)
 	UINT8		rhythm = OPL->rhythm&0x20;
 	OPLSAMPLE	*buf = buffer;
 	int i;
+	UINT32		silent;
 
 	if( (void *)OPL != cur_chip ){
 		cur_chip = (void *)OPL;
@@ -2237,6 +2282,9 @@ void ym3812_update_one(void *chip, OPLSAMPLE *buffer, int length)
 		SLOT8_1 = &OPL->P_CH[8].SLOT[SLOT1];
 		SLOT8_2 = &OPL->P_CH[8].SLOT[SLOT2];
 	}
+	/* leave out the channels that are silent for this whole update */
+	silent = OPLSilentChannels(OPL, rhythm ? 6 : 9);
+
 	for( i=0; i < length ; i++ )
 	{
 		int lt;
@@ -2246,18 +2294,18 @@ void ym3812_update_one(void *chip, OPLSAMPLE *buffer, int length)
 		advance_lfo(OPL);
 
 		/* FM part */
-		OPL_CALC_CH(&OPL->P_CH[0]);
-		OPL_CALC_CH(&OPL->P_CH[1]);
-		OPL_CALC_CH(&OPL->P_CH[2]);
-		OPL_CALC_CH(&OPL->P_CH[3]);
-		OPL_CALC_CH(&OPL->P_CH[4]);
-		OPL_CALC_CH(&OPL->P_CH[5]);
+		if( !(silent & 0x001) ) OPL_CALC_CH(&OPL->P_CH[0]);
+		if( !(silent & 0x002) ) OPL_CALC_CH(&OPL->P_CH[1]);
+		if( !(silent & 0x004) ) OPL_CALC_CH(&OPL->P_CH[2]);
+		if( !(silent & 0x008) ) OPL_CALC_CH(&OPL->P_CH[3]);
+		if( !(silent & 0x010) ) OPL_CALC_CH(&OPL->P_CH[4]);
+		if( !(silent & 0x020) ) OPL_CALC_CH(&OPL->P_CH[5]);
 
 		if(!rhythm)
 		{
-			OPL_CALC_CH(&OPL->P_CH[6]);
-			OPL_CALC_CH(&OPL->P_CH[7]);
-			OPL_CALC_CH(&OPL->P_CH[8]);
+			if( !(silent & 0x040) ) OPL_CALC_CH(&OPL->P_CH[6]);
+			if( !(silent & 0x080) ) OPL_CALC_CH(&OPL->P_CH[7]);
+			if( !(silent & 0x100) ) OPL_CALC_CH(&OPL->P_CH[8]);
 		}
 		else		/* Rhythm part */
 		{
@@ -2332,6 +2380,11 @@ int ym3526_timer_over(void *chip, int c)
 	FM_OPL *YM3526 = (FM_OPL *)chip;
 	return OPLTimerOver(YM3526, c);
 }
+int ym3526_is_idle(void *chip)
+{
+	FM_OPL *YM3526 = (FM_OPL *)chip;
+	return OPLIdle(YM3526);
+}
 
 void ym3526_set_timer_handler(void *chip, OPL_TIMERHANDLER timer_handler, void *param)
 {
@@ -2363,6 +2416,7 @@ void ym3526_update_one(void *chip, OPLSAMPLE *buffer, int length)
 	UINT8		rhythm = OPL->rhythm&0x20;
 	OPLSAMPLE	*buf = buffer;
 	int i;
+	UINT32		silent;
 
 	if( (void *)OPL != cur_chip ){
 		cur_chip = (void *)OPL;
@@ -2372,6 +2426,9 @@ void ym3526_update_one(void *chip, OPLSAMPLE *buffer, int length)
 		SLOT8_1 = &OPL->P_CH[8].SLOT[SLOT1];
 		SLOT8_2 = &OPL->P_CH[8].SLOT[SLOT2];
 	}
+	/* leave out the channels that are silent for this whole update */
+	silent = OPLSilentChannels(OPL, rhythm ? 6 : 9);
+
 	for( i=0; i < length ; i++ )
 	{
 		int lt;
@@ -2381,18 +2438,18 @@ void ym3526_update_one(void *chip, OPLSAMPLE *buffer, int length)
 		advance_lfo(OPL);
 
 		/* FM part */
-		OPL_CALC_CH(&OPL->P_CH[0]);
-		OPL_CALC_CH(&OPL->P_CH[1]);
-		OPL_CALC_CH(&OPL->P_CH[2]);
-		OPL_CALC_CH(&OPL->P_CH[3]);
-		OPL_CALC_CH(&OPL->P_CH[4]);
-		OPL_CALC_CH(&OPL->P_CH[5]);
+		if( !(silent & 0x001) ) OPL_CALC_CH(&OPL->P_CH[0]);
+		if( !(silent & 0x002) ) OPL_CALC_CH(&OPL->P_CH[1]);
+		if( !(silent & 0x004) ) OPL_CALC_CH(&OPL->P_CH[2]);
+		if( !(silent & 0x008) ) OPL_CALC_CH(&OPL->P_CH[3]);
+		if( !(silent & 0x010) ) OPL_CALC_CH(&OPL->P_CH[4]);
+		if( !(silent & 0x020) ) OPL_CALC_CH(&OPL->P_CH[5]);
 
 		if(!rhythm)
 		{
-			OPL_CALC_CH(&OPL->P_CH[6]);
-			OPL_CALC_CH(&OPL->P_CH[7]);
-			OPL_CALC_CH(&OPL->P_CH[8]);
+			if( !(silent & 0x040) ) OPL_CALC_CH(&OPL->P_CH[6]);
+			if( !(silent & 0x080) ) OPL_CALC_CH(&OPL->P_CH[7]);
+			if( !(silent & 0x100) ) OPL_CALC_CH(&OPL->P_CH[8]);
 		}
 		else		/* Rhythm part */
 		{
@@ -2488,6 +2545,11 @@ int y8950_timer_over(void *chip, int c)
 	FM_OPL *Y8950 = (FM_OPL *)chip;
 	return OPLTimerOver(Y8950, c);
 }
+int y8950_is_idle(void *chip)
+{
+	FM_OPL *Y8950 = (FM_OPL *)chip;
+	return OPLIdle(Y8950);
+}
 
 void y8950_set_timer_handler(void *chip, OPL_TIMERHANDLER timer_handler, void *param)
 {
@@ -2522,6 +2584,7 @@ void y8950_set_delta_t_memory(void *chip, void * deltat_mem_ptr, int deltat_mem_
 void y8950_update_one(void *chip, OPLSAMPLE *buffer, int length)
 {
 	int i;
+	UINT32		silent;
 	FM_OPL		*OPL = (FM_OPL *)chip;
 	UINT8		rhythm  = OPL->rhythm&0x20;
 	YM_DELTAT	*DELTAT = OPL->deltat;
@@ -2536,6 +2599,9 @@ void y8950_update_one(void *chip, OPLSAMPLE *buffer, int length)
 		SLOT8_2 = &OPL->P_CH[8].SLOT[SLOT2];
 
 	}
+	/* leave out the channels that are silent for this whole update */
+	silent = OPLSilentChannels(OPL, rhythm ? 6 : 9);
+
 	for( i=0; i < length ; i++ )
 	{
 		int lt;
@@ -2550,18 +2616,18 @@ void y8950_update_one(void *chip, OPLSAMPLE *buffer, int length)
 			YM_DELTAT_ADPCM_CALC(DELTAT);
 
 		/* FM part */
-		OPL_CALC_CH(&OPL->P_CH[0]);
-		OPL_CALC_CH(&OPL->P_CH[1]);
-		OPL_CALC_CH(&OPL->P_CH[2]);
-		OPL_CALC_CH(&OPL->P_CH[3]);
-		OPL_CALC_CH(&OPL->P_CH[4]);
-		OPL_CALC_CH(&OPL->P_CH[5]);
+		if( !(silent & 0x001) ) OPL_CALC_CH(&OPL->P_CH[0]);
+		if( !(silent & 0x002) ) OPL_CALC_CH(&OPL->P_CH[1]);
+		if( !(silent & 0x004) ) OPL_CALC_CH(&OPL->P_CH[2]);
+		if( !(silent & 0x008) ) OPL_CALC_CH(&OPL->P_CH[3]);
+		if( !(silent & 0x010) ) OPL_CALC_CH(&OPL->P_CH[4]);
+		if( !(silent & 0x020) ) OPL_CALC_CH(&OPL->P_CH[5]);
 
 		if(!rhythm)
 		{
-			OPL_CALC_CH(&OPL->P_CH[6]);
-			OPL_CALC_CH(&OPL->P_CH[7]);
-			OPL_CALC_CH(&OPL->P_CH[8]);
+			if( !(silent & 0x040) ) OPL_CALC_CH(&OPL->P_CH[6]);
+			if( !(silent & 0x080) ) OPL_CALC_CH(&OPL->P_CH[7]);
+			if( !(silent & 0x100) ) OPL_CALC_CH(&OPL->P_CH[8]);
 		}
 		else		/* Rhythm part */
 		{
@@ -47,6 +47,7 @@ void ym3812_reset_chip(void *chip);
 int  ym3812_write(void *chip, int a, int v);
 unsigned char ym3812_read(void *chip, int a);
 int  ym3812_timer_over(void *chip, int c);
+int  ym3812_is_idle(void *chip);
 void ym3812_update_one(void *chip, OPLSAMPLE *buffer, int length);
 
 void ym3812_set_timer_handler(void *chip, OPL_TIMERHANDLER TimerHandler, void *param);
@@ -72,6 +73,7 @@ void ym3526_reset_chip(void *chip);
 int  ym3526_write(void *chip, int a, int v);
 unsigned char ym3526_read(void *chip, int a);
 int  ym3526_timer_over(void *chip, int c);
+int  ym3526_is_idle(void *chip);
 /*
 ** Generate samples for one of the YM3526's
 **
@@ -101,6 +103,7 @@ void y8950_reset_chip(void *chip);
 int  y8950_write(void *chip, int a, int v);
 unsigned char y8950_read (void *chip, int a);
 int  y8950_timer_over(void *chip, int c);
+int  y8950_is_idle(void *chip);
 void y8950_update_one(void *chip, OPLSAMPLE *buffer, int length);
 
 void y8950_set_timer_handler(void *chip, OPL_TIMERHANDLER TimerHandler, void *param);
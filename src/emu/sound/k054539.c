@@ -80,6 +80,7 @@ struct _k054539_state {
 	unsigned char regs[0x230];
 	unsigned char *ram;
 	int reverb_pos;
+	int quiet_samples;		/* samples generated with no channel keyed on */
 
 	INT32 cur_ptr;
 	int cur_limit;
@@ -166,7 +167,18 @@ static STREAM_UPDATE( k054539_update )
 	rom = info->rom;
 	rom_mask = info->rom_mask;
 
-	if(!(info->regs[0x22f] & 1)) return;
+	if(!(info->regs[0x22f] & 1)) {
+		stream_set_idle(info->stream);
+		return;
+	}
+
+	/* once no channel has played for a whole reverb buffer, the echoes are gone too */
+	if(info->regs[0x22c] == 0) {
+		info->quiet_samples += samples;
+		if(info->quiet_samples >= 0x4000)
+			stream_set_idle(info->stream);
+	} else
+		info->quiet_samples = 0;
 
 	info->reverb_pos = (reverb_pos + samples) & 0x3fff;
 
@@ -518,6 +530,9 @@ WRITE8_DEVICE_HANDLER( k054539_w )
 	int latch, offs, ch, pan;
 	UINT8 *regbase, *regptr, *posptr;
 
+	/* any write may key on a channel or touch the reverb RAM */
+	stream_wake(info->stream);
+
 	regbase = info->regs;
 	latch = (info->k054539_flags & K054539_UPDATE_AT_KEYON) && (regbase[0x22f] & 1);
 
@@ -17,6 +17,7 @@
 #include "sndintrf.h"
 #include "streams.h"
 #include "msm5205.h"
+#include "okiadpcm.h"
 
 /*
  *
@@ -43,7 +44,7 @@ struct _msm5205_state
 	INT32 bitwidth;           /* bit width selector -3B/4B    */
 	INT32 signal;             /* current ADPCM signal         */
 	INT32 step;               /* current ADPCM step           */
-	int diff_lookup[49*16];
+	const adpcm_lookup *lookup;	/* shared ADPCM decode table */
 };
 
 INLINE msm5205_state *get_safe_token(const device_config *device)
@@ -58,48 +59,6 @@ INLINE msm5205_state *get_safe_token(const device_config *device)
 
 static void msm5205_playmode(msm5205_state *voice,int select);
 
-/*
- * ADPCM lockup tabe
- */
-
-/* step size index shift table */
-static const int index_shift[8] = { -1, -1, -1, -1, 2, 4, 6, 8 };
-
-/*
- *   Compute the difference table
- */
-
-static void ComputeTables (msm5205_state *voice)
-{
-	/* nibble to bit map */
-	static const int nbl2bit[16][4] =
-	{
-		{ 1, 0, 0, 0}, { 1, 0, 0, 1}, { 1, 0, 1, 0}, { 1, 0, 1, 1},
-		{ 1, 1, 0, 0}, { 1, 1, 0, 1}, { 1, 1, 1, 0}, { 1, 1, 1, 1},
-		{-1, 0, 0, 0}, {-1, 0, 0, 1}, {-1, 0, 1, 0}, {-1, 0, 1, 1},
-		{-1, 1, 0, 0}, {-1, 1, 0, 1}, {-1, 1, 1, 0}, {-1, 1, 1, 1}
-	};
-
-	int step, nib;
-
-	/* loop over all possible steps */
-	for (step = 0; step <= 48; step++)
-	{
-		/* compute the step value */
-		int stepval = floor (16.0 * pow (11.0 / 10.0, (double)step));
-
-		/* loop over all nibbles and compute the difference */
-		for (nib = 0; nib < 16; nib++)
-		{
-			voice->diff_lookup[step*16 + nib] = nbl2bit[nib][0] *
-				(stepval   * nbl2bit[nib][1] +
-				 stepval/2 * nbl2bit[nib][2] +
-				 stepval/4 * nbl2bit[nib][3] +
-				 stepval/8);
-		}
-	}
-}
-
 /* stream update callbacks */
 static STREAM_UPDATE( MSM5205_update )
 {
@@ -124,7 +83,6 @@ static STREAM_UPDATE( MSM5205_update )
 static TIMER_CALLBACK( MSM5205_vclk_callback )
 {
 	msm5205_state *voice = (msm5205_state *)ptr;
-	int val;
 	int new_signal;
 	/* callback user handler and latch next data */
 	if(voice->intf->vclk_callback) (*voice->intf->vclk_callback)(voice->device);
@@ -139,13 +97,11 @@ static TIMER_CALLBACK( MSM5205_vclk_callback )
 	{
 		/* update signal */
 		/* !! MSM5205 has internal 12bit decoding, signal width is 0 to 8191 !! */
-		val = voice->data;
-		new_signal = voice->signal + voice->diff_lookup[voice->step * 16 + (val & 15)];
+		const adpcm_lookup *entry = &voice->lookup[voice->step * 16 + (voice->data & 15)];
+		new_signal = voice->signal + entry->diff;
 		if (new_signal > 2047) new_signal = 2047;
 		else if (new_signal < -2048) new_signal = -2048;
-		voice->step += index_shift[val & 7];
-		if (voice->step > 48) voice->step = 48;
-		else if (voice->step < 0) voice->step = 0;
+		voice->step = entry->next;
 	}
 	/* update when signal changed */
 	if( voice->signal != new_signal)
@@ -187,7 +143,7 @@ static DEVICE_START( msm5205 )
 	voice->clock = device->clock;
 
 	/* compute the difference tables */
-	ComputeTables (voice);
+	voice->lookup = adpcm_get_lookup();
 
 	/* stream system initialize */
 	voice->stream = stream_create(device,0,1,device->clock,voice,MSM5205_update);
@@ -429,7 +429,7 @@ static STREAM_UPDATE( MultiPCM_update )
 {
 	MultiPCM *ptChip = (MultiPCM *)param;
 	stream_sample_t  *datap[2];
-	int i,sl;
+	int i,sl,playing=0;
 
 	datap[0] = outputs[0];
 	datap[1] = outputs[1];
@@ -490,6 +490,12 @@ static STREAM_UPDATE( MultiPCM_update )
 		datap[0][i]=ICLIP16(smpl);
 		datap[1][i]=ICLIP16(smpr);
 	}
+
+	//all slots have finished, nothing to do until the next key on
+	for(sl=0;sl<28;++sl)
+		playing|=ptChip->Slots[sl].Playing;
+	if(!playing)
+		stream_set_idle(ptChip->stream);
 }
 
 READ8_DEVICE_HANDLER( multipcm_r )
@@ -654,6 +660,7 @@ WRITE8_DEVICE_HANDLER( multipcm_w )
 	switch(offset)
 	{
 		case 0:		//Data write
+			stream_wake(ptChip->stream);
 			WriteSlot(ptChip,ptChip->Slots+ptChip->CurSlot,ptChip->Address,data);
 			break;
 		case 1:
@@ -0,0 +1,186 @@
+/***************************************************************************
+
+    okiadpcm.c
+
+    OKI/Dialogic ADPCM decoding shared by the OKI and MSM chips.
+
+    Copyright Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+***************************************************************************/
+
+#include <math.h>
+
+#include "sndintrf.h"
+#include "okiadpcm.h"
+
+
+/***************************************************************************
+    GLOBAL VARIABLES
+***************************************************************************/
+
+/* step size index shift table */
+static const int index_shift[8] = { -1, -1, -1, -1, 2, 4, 6, 8 };
+
+/* combined difference and next step table */
+static adpcm_lookup lookup[49*16];
+
+/* tables computed? */
+static int tables_computed = 0;
+
+
+
+/***************************************************************************
+    INLINE FUNCTIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    decode_nibble - apply one nibble to a signal
+    and table index
+-------------------------------------------------*/
+
+INLINE INT32 decode_nibble(INT32 *signal, INT32 index, int nibble)
+{
+	const adpcm_lookup *entry = &lookup[index + nibble];
+
+	*signal += entry->diff;
+
+	/* clamp to the maximum */
+	if (*signal > 2047)
+		*signal = 2047;
+	else if (*signal < -2048)
+		*signal = -2048;
+
+	return entry->next * 16;
+}
+
+
+
+/***************************************************************************
+    CORE IMPLEMENTATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    compute_tables - compute the difference and
+    next step tables
+-------------------------------------------------*/
+
+static void compute_tables(void)
+{
+	/* nibble to bit map */
+	static const int nbl2bit[16][4] =
+	{
+		{ 1, 0, 0, 0}, { 1, 0, 0, 1}, { 1, 0, 1, 0}, { 1, 0, 1, 1},
+		{ 1, 1, 0, 0}, { 1, 1, 0, 1}, { 1, 1, 1, 0}, { 1, 1, 1, 1},
+		{-1, 0, 0, 0}, {-1, 0, 0, 1}, {-1, 0, 1, 0}, {-1, 0, 1, 1},
+		{-1, 1, 0, 0}, {-1, 1, 0, 1}, {-1, 1, 1, 0}, {-1, 1, 1, 1}
+	};
+
+	int step, nib;
+
+	/* loop over all possible steps */
+	for (step = 0; step <= 48; step++)
+	{
+		/* compute the step value */
+		int stepval = floor(16.0 * pow(11.0 / 10.0, (double)step));
+
+		/* loop over all nibbles and compute the difference and the next step */
+		for (nib = 0; nib < 16; nib++)
+		{
+			int next = step + index_shift[nib & 7];
+
+			lookup[step*16 + nib].diff = nbl2bit[nib][0] *
+				(stepval   * nbl2bit[nib][1] +
+				 stepval/2 * nbl2bit[nib][2] +
+				 stepval/4 * nbl2bit[nib][3] +
+				 stepval/8);
+			lookup[step*16 + nib].next = (next < 0) ? 0 : (next > 48) ? 48 : next;
+		}
+	}
+
+	tables_computed = 1;
+}
+
+
+/*-------------------------------------------------
+    adpcm_get_lookup - return the decode table
+-------------------------------------------------*/
+
+const adpcm_lookup *adpcm_get_lookup(void)
+{
+	/* make sure we have our tables */
+	if (!tables_computed)
+		compute_tables();
+
+	return lookup;
+}
+
+
+/*-------------------------------------------------
+    reset_adpcm - reset the ADPCM stream
+-------------------------------------------------*/
+
+void reset_adpcm(struct adpcm_state *state)
+{
+	/* make sure we have our tables */
+	if (!tables_computed)
+		compute_tables();
+
+	/* reset the signal/step */
+	state->signal = -2;
+	state->step = 0;
+}
+
+
+/*-------------------------------------------------
+    clock_adpcm - clock the next ADPCM nibble
+-------------------------------------------------*/
+
+INT16 clock_adpcm(struct adpcm_state *state, UINT8 nibble)
+{
+	state->step = decode_nibble(&state->signal, state->step * 16, nibble & 15) / 16;
+	return state->signal;
+}
+
+
+/*-------------------------------------------------
+    decode_adpcm - decode a run of nibbles,
+    fetching each byte only once
+-------------------------------------------------*/
+
+void decode_adpcm(struct adpcm_state *state, const UINT8 *data, UINT32 nibble, INT16 *dest, int count)
+{
+	INT32 signal = state->signal;
+	INT32 index = state->step * 16;
+
+	data += nibble / 2;
+
+	/* finish a byte we're in the middle of */
+	if ((nibble & 1) && count > 0)
+	{
+		index = decode_nibble(&signal, index, *data++ & 15);
+		*dest++ = signal;
+		count--;
+	}
+
+	/* then two nibbles per byte */
+	for ( ; count >= 2; count -= 2)
+	{
+		int byte = *data++;
+
+		index = decode_nibble(&signal, index, byte >> 4);
+		*dest++ = signal;
+		index = decode_nibble(&signal, index, byte & 15);
+		*dest++ = signal;
+	}
+
+	/* and a final high nibble */
+	if (count > 0)
+	{
+		index = decode_nibble(&signal, index, *data >> 4);
+		*dest++ = signal;
+	}
+
+	state->signal = signal;
+	state->step = index / 16;
+}
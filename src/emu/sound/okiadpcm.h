@@ -0,0 +1,66 @@
+/***************************************************************************
+
+    okiadpcm.h
+
+    OKI/Dialogic ADPCM decoding shared by the OKI and MSM chips.
+
+    Copyright Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+****************************************************************************
+
+    Every nibble adds one of 16 differences, scaled by one of 49 step
+    sizes, to a 12-bit signal and then moves the step size up or down.
+    Both results depend only on the current step and the nibble, so
+    they are kept together in one table of 49*16 entries, with the
+    next step already clamped, and decoding a nibble costs one lookup
+    and a clamp of the signal.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __OKIADPCM_H__
+#define __OKIADPCM_H__
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+/* decoder state for one ADPCM stream */
+struct adpcm_state
+{
+	INT32	signal;
+	INT32	step;
+};
+
+
+/* one entry of the decode table, indexed by step * 16 + nibble */
+typedef struct _adpcm_lookup adpcm_lookup;
+struct _adpcm_lookup
+{
+	INT16	diff;			/* difference to add to the signal */
+	UINT8	next;			/* step to use for the following nibble */
+};
+
+
+
+/***************************************************************************
+    FUNCTION PROTOTYPES
+***************************************************************************/
+
+/* return the decode table, building it on the first call */
+const adpcm_lookup *adpcm_get_lookup(void);
+
+/* reset an ADPCM stream */
+void reset_adpcm(struct adpcm_state *state);
+
+/* decode a single nibble and return the new 12-bit signal */
+INT16 clock_adpcm(struct adpcm_state *state, UINT8 nibble);
+
+/* decode 'count' nibbles, high nibble first, starting at nibble 'nibble' of 'data' */
+void decode_adpcm(struct adpcm_state *state, const UINT8 *data, UINT32 nibble, INT16 *dest, int count);
+
+
+#endif	/* __OKIADPCM_H__ */
@@ -9,11 +9,10 @@
  **********************************************************************************************/
 
 
-#include <math.h>
-
 #include "sndintrf.h"
 #include "streams.h"
 #include "okim6258.h"
+#include "okiadpcm.h"
 
 #define COMMAND_STOP		(1 << 0)
 #define COMMAND_PLAY		(1 << 1)
@@ -42,14 +41,8 @@ struct _okim6258_state
 	INT32 step;
 };
 
-/* step size index shift table */
-static const int index_shift[8] = { -1, -1, -1, -1, 2, 4, 6, 8 };
-
-/* lookup table for the precomputed difference */
-static int diff_lookup[49*16];
-
-/* tables computed? */
-static int tables_computed = 0;
+/* shared ADPCM decode table */
+static const adpcm_lookup *lookup;
 
 INLINE okim6258_state *get_safe_token(const device_config *device)
 {
@@ -60,52 +53,14 @@ INLINE okim6258_state *get_safe_token(const device_config *device)
 	return (okim6258_state *)device->token;
 }
 
-/**********************************************************************************************
-
-     compute_tables -- compute the difference tables
-
-***********************************************************************************************/
-
-static void compute_tables(void)
-{
-	/* nibble to bit map */
-	static const int nbl2bit[16][4] =
-	{
-		{ 1, 0, 0, 0}, { 1, 0, 0, 1}, { 1, 0, 1, 0}, { 1, 0, 1, 1},
-		{ 1, 1, 0, 0}, { 1, 1, 0, 1}, { 1, 1, 1, 0}, { 1, 1, 1, 1},
-		{-1, 0, 0, 0}, {-1, 0, 0, 1}, {-1, 0, 1, 0}, {-1, 0, 1, 1},
-		{-1, 1, 0, 0}, {-1, 1, 0, 1}, {-1, 1, 1, 0}, {-1, 1, 1, 1}
-	};
-
-	int step, nib;
-
-	/* loop over all possible steps */
-	for (step = 0; step <= 48; step++)
-	{
-		/* compute the step value */
-		int stepval = floor(16.0 * pow(11.0 / 10.0, (double)step));
-
-		/* loop over all nibbles and compute the difference */
-		for (nib = 0; nib < 16; nib++)
-		{
-			diff_lookup[step*16 + nib] = nbl2bit[nib][0] *
-				(stepval   * nbl2bit[nib][1] +
-				 stepval/2 * nbl2bit[nib][2] +
-				 stepval/4 * nbl2bit[nib][3] +
-				 stepval/8);
-		}
-	}
-
-	tables_computed = 1;
-}
-
-
-static INT16 clock_adpcm(okim6258_state *chip, UINT8 nibble)
+static INT16 clock_voice(okim6258_state *chip, UINT8 nibble)
 {
 	INT32 max = (1 << (chip->output_bits - 1)) - 1;
 	INT32 min = -(1 << (chip->output_bits - 1));
 
-	chip->signal += diff_lookup[chip->step * 16 + (nibble & 15)];
+	const adpcm_lookup *entry = &lookup[chip->step * 16 + (nibble & 15)];
+
+	chip->signal += entry->diff;
 
 	/* clamp to the maximum */
 	if (chip->signal > max)
@@ -113,12 +68,8 @@ static INT16 clock_adpcm(okim6258_state *chip, UINT8 nibble)
 	else if (chip->signal < min)
 		chip->signal = min;
 
-	/* adjust the step size and clamp */
-	chip->step += index_shift[nibble & 7];
-	if (chip->step > 48)
-		chip->step = 48;
-	else if (chip->step < 0)
-		chip->step = 0;
+	/* adjust the step size */
+	chip->step = entry->next;
 
 	/* return the signal scaled up to 32767 */
 	return chip->signal << 4;
@@ -147,7 +98,7 @@ static STREAM_UPDATE( okim6258_update )
 			int nibble = (chip->data_in >> nibble_shift) & 0xf;
 
 			/* Output to the buffer */
-			INT16 sample = clock_adpcm(chip, nibble);
+			INT16 sample = clock_voice(chip, nibble);
 
 			nibble_shift ^= 4;
 
@@ -197,7 +148,7 @@ static DEVICE_START( okim6258 )
 	const okim6258_interface *intf = (const okim6258_interface *)device->static_config;
 	okim6258_state *info = get_safe_token(device);
 
-	compute_tables();
+	lookup = adpcm_get_lookup();
 
 	info->master_clock = device->clock;
 	info->adpcm_type = intf->adpcm_type;
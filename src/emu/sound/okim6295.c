@@ -21,14 +21,15 @@
  **********************************************************************************************/
 
 
-#include <math.h>
-
 #include "sndintrf.h"
 #include "streams.h"
 #include "okim6295.h"
 
 #define MAX_SAMPLE_CHUNK	10000
 
+/* bytes of ADPCM data fetched from the address space at a time */
+#define ADPCM_BLOCK_BYTES	32
+
 
 /* struct describing a single playing ADPCM voice */
 struct ADPCMVoice
@@ -56,12 +57,6 @@ struct _okim6295_state
 	UINT32 master_clock;	/* master clock frequency */
 };
 
-/* step size index shift table */
-static const int index_shift[8] = { -1, -1, -1, -1, 2, 4, 6, 8 };
-
-/* lookup table for the precomputed difference */
-static int diff_lookup[49*16];
-
 /* volume lookup table. The manual lists only 9 steps, ~3dB per step. Given the dB values,
    that seems to map to a 5-bit volume control. Any volume parameter beyond the 9th index
    results in silent playback. */
@@ -85,9 +80,6 @@ static const int volume_table[16] =
 	0x00,
 };
 
-/* tables computed? */
-static int tables_computed = 0;
-
 /* useful interfaces */
 const okim6295_interface okim6295_interface_pin7high = { 1 };
 const okim6295_interface okim6295_interface_pin7low = { 0 };
@@ -108,95 +100,6 @@ INLINE okim6295_state *get_safe_token(const device_config *device)
 }
 
 
-/**********************************************************************************************
-
-     compute_tables -- compute the difference tables
-
-***********************************************************************************************/
-
-static void compute_tables(void)
-{
-	/* nibble to bit map */
-	static const int nbl2bit[16][4] =
-	{
-		{ 1, 0, 0, 0}, { 1, 0, 0, 1}, { 1, 0, 1, 0}, { 1, 0, 1, 1},
-		{ 1, 1, 0, 0}, { 1, 1, 0, 1}, { 1, 1, 1, 0}, { 1, 1, 1, 1},
-		{-1, 0, 0, 0}, {-1, 0, 0, 1}, {-1, 0, 1, 0}, {-1, 0, 1, 1},
-		{-1, 1, 0, 0}, {-1, 1, 0, 1}, {-1, 1, 1, 0}, {-1, 1, 1, 1}
-	};
-
-	int step, nib;
-
-	/* loop over all possible steps */
-	for (step = 0; step <= 48; step++)
-	{
-		/* compute the step value */
-		int stepval = floor(16.0 * pow(11.0 / 10.0, (double)step));
-
-		/* loop over all nibbles and compute the difference */
-		for (nib = 0; nib < 16; nib++)
-		{
-			diff_lookup[step*16 + nib] = nbl2bit[nib][0] *
-				(stepval   * nbl2bit[nib][1] +
-				 stepval/2 * nbl2bit[nib][2] +
-				 stepval/4 * nbl2bit[nib][3] +
-				 stepval/8);
-		}
-	}
-
-	tables_computed = 1;
-}
-
-
-
-/**********************************************************************************************
-
-     reset_adpcm -- reset the ADPCM stream
-
-***********************************************************************************************/
-
-void reset_adpcm(struct adpcm_state *state)
-{
-	/* make sure we have our tables */
-	if (!tables_computed)
-		compute_tables();
-
-	/* reset the signal/step */
-	state->signal = -2;
-	state->step = 0;
-}
-
-
-
-/**********************************************************************************************
-
-     clock_adpcm -- clock the next ADPCM byte
-
-***********************************************************************************************/
-
-INT16 clock_adpcm(struct adpcm_state *state, UINT8 nibble)
-{
-	state->signal += diff_lookup[state->step * 16 + (nibble & 15)];
-
-	/* clamp to the maximum */
-	if (state->signal > 2047)
-		state->signal = 2047;
-	else if (state->signal < -2048)
-		state->signal = -2048;
-
-	/* adjust the step size and clamp */
-	state->step += index_shift[nibble & 7];
-	if (state->step > 48)
-		state->step = 48;
-	else if (state->step < 0)
-		state->step = 0;
-
-	/* return the signal */
-	return state->signal;
-}
-
-
-
 /**********************************************************************************************
 
      generate_adpcm -- general ADPCM decoding routine
@@ -208,23 +111,41 @@ static void generate_adpcm(okim6295_state *chip, struct ADPCMVoice *voice, INT16
 	/* if this voice is active */
 	if (voice->playing)
 	{
+		const address_space *space = chip->device->space[0];
 		offs_t base = voice->base_offset;
 		int sample = voice->sample;
 		int count = voice->count;
+		UINT8 block[ADPCM_BLOCK_BYTES];
 
 		/* loop while we still have samples to generate */
 		while (samples)
 		{
-			/* compute the new amplitude and update the current step */
-			int nibble = memory_raw_read_byte(chip->device->space[0], base + sample / 2) >> (((sample & 1) << 2) ^ 4);
+			int first = sample & 1;
+			int nibbles = MIN(samples, count - sample);
+			int bytes, i;
 
-			/* output to the buffer, scaling by the volume */
+			/* fetch a block of data and decode as much of it as we need */
+			nibbles = MIN(nibbles, ADPCM_BLOCK_BYTES * 2 - first);
+			if (nibbles <= 0)
+			{
+				voice->playing = 0;
+				break;
+			}
+			bytes = (first + nibbles + 1) / 2;
+			for (i = 0; i < bytes; i++)
+				block[i] = memory_raw_read_byte(space, base + sample / 2 + i);
+			decode_adpcm(&voice->adpcm, block, first, buffer, nibbles);
+
+			/* scale by the volume */
 			/* signal in range -2048..2047, volume in range 2..32 => signal * volume / 2 in range -32768..32767 */
-			*buffer++ = clock_adpcm(&voice->adpcm, nibble) * voice->volume / 2;
-			samples--;
+			for (i = 0; i < nibbles; i++)
+				buffer[i] = buffer[i] * voice->volume / 2;
+			buffer += nibbles;
+			samples -= nibbles;
 
 			/* next! */
-			if (++sample >= count)
+			sample += nibbles;
+			if (sample >= count)
 			{
 				voice->playing = 0;
 				break;
@@ -270,7 +191,7 @@ static void generate_adpcm(okim6295_state *chip, struct ADPCMVoice *voice, INT16
 static STREAM_UPDATE( okim6295_update )
 {
 	okim6295_state *chip = (okim6295_state *)param;
-	int i;
+	int i, playing = 0;
 
 	memset(outputs[0], 0, samples * sizeof(*outputs[0]));
 
@@ -293,7 +214,12 @@ static STREAM_UPDATE( okim6295_update )
 
 			remaining -= samples;
 		}
+		playing |= voice->playing;
 	}
+
+	/* nothing more to play until the next start command */
+	if (!playing)
+		stream_set_idle(chip->stream);
 }
 
 
@@ -349,8 +275,6 @@ static DEVICE_START( okim6295 )
 	int divisor = intf->pin7 ? 132 : 165;
 	int voice;
 
-	compute_tables();
-
 	info->command = -1;
 	info->bank_num = -1;
 	info->bank_offs = 0;
@@ -539,6 +463,9 @@ WRITE8_DEVICE_HANDLER( okim6295_w )
 			}
 		}
 
+		/* a voice may have started, so the stream has to run again */
+		stream_wake(info->stream);
+
 		/* reset the command */
 		info->command = -1;
 	}
@@ -3,6 +3,8 @@
 #ifndef __OKIM6295_H__
 #define __OKIM6295_H__
 
+#include "okiadpcm.h"
+
 /* an interface for the OKIM6295 and similar chips */
 
 /*
@@ -28,15 +30,8 @@ WRITE8_DEVICE_HANDLER( okim6295_w );
 
 /*
     To help the various custom ADPCM generators out there,
-    the following routines may be used.
+    the routines in okiadpcm.h may be used.
 */
-struct adpcm_state
-{
-	INT32	signal;
-	INT32	step;
-};
-void reset_adpcm(struct adpcm_state *state);
-INT16 clock_adpcm(struct adpcm_state *state, UINT8 nibble);
 
 DEVICE_GET_INFO( okim6295 );
 #define SOUND_OKIM6295 DEVICE_GET_INFO_NAME( okim6295 )
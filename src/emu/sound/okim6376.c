@@ -10,11 +10,10 @@
  **********************************************************************************************/
 
 
-#include <math.h>
-
 #include "sndintrf.h"
 #include "streams.h"
 #include "okim6376.h"
+#include "okiadpcm.h"
 
 #define MAX_SAMPLE_CHUNK	10000
 #define MAX_WORDS           111
@@ -45,11 +44,8 @@ struct _okim6376_state
 	UINT32 master_clock;	/* master clock frequency */
 };
 
-/* step size index shift table */
-static const int index_shift[8] = { -1, -1, -1, -1, 2, 4, 6, 8 };
-
-/* lookup table for the precomputed difference */
-static int diff_lookup[49*16];
+/* shared ADPCM decode table */
+static const adpcm_lookup *lookup;
 
 /* volume lookup table. Upon configuration, the number of ST pulses determine how much
    attenuation to apply to the sound signal. */
@@ -61,9 +57,6 @@ static const int volume_table[4] =
 	0x04,	// -24.0 dB
 };
 
-/* tables computed? */
-static int tables_computed = 0;
-
 
 INLINE okim6376_state *get_safe_token(const device_config *device)
 {
@@ -78,56 +71,14 @@ INLINE okim6376_state *get_safe_token(const device_config *device)
 
 /**********************************************************************************************
 
-     compute_tables -- compute the difference tables
+     reset_voice -- reset the ADPCM stream
 
 ***********************************************************************************************/
 
-static void compute_tables(void)
-{
-	/* nibble to bit map */
-	static const int nbl2bit[16][4] =
-	{
-		{ 1, 0, 0, 0}, { 1, 0, 0, 1}, { 1, 0, 1, 0}, { 1, 0, 1, 1},
-		{ 1, 1, 0, 0}, { 1, 1, 0, 1}, { 1, 1, 1, 0}, { 1, 1, 1, 1},
-		{-1, 0, 0, 0}, {-1, 0, 0, 1}, {-1, 0, 1, 0}, {-1, 0, 1, 1},
-		{-1, 1, 0, 0}, {-1, 1, 0, 1}, {-1, 1, 1, 0}, {-1, 1, 1, 1}
-	};
-
-	int step, nib;
-
-	/* loop over all possible steps */
-	for (step = 0; step <= 48; step++)
-	{
-		/* compute the step value */
-		int stepval = floor(16.0 * pow(11.0 / 10.0, (double)step));
-
-		/* loop over all nibbles and compute the difference */
-		for (nib = 0; nib < 16; nib++)
-		{
-			diff_lookup[step*16 + nib] = nbl2bit[nib][0] *
-				(stepval   * nbl2bit[nib][1] +
-				 stepval/2 * nbl2bit[nib][2] +
-				 stepval/4 * nbl2bit[nib][3] +
-				 stepval/8);
-		}
-	}
-
-	tables_computed = 1;
-}
-
-
-
-/**********************************************************************************************
-
-     reset_adpcm -- reset the ADPCM stream
-
-***********************************************************************************************/
-
-static void reset_adpcm(struct ADPCMVoice *voice)
+static void reset_voice(struct ADPCMVoice *voice)
 {
 	/* make sure we have our tables */
-	if (!tables_computed)
-		compute_tables();
+	lookup = adpcm_get_lookup();
 
 	/* reset the signal/step */
 	voice->signal = -2;
@@ -138,13 +89,15 @@ static void reset_adpcm(struct ADPCMVoice *voice)
 
 /**********************************************************************************************
 
-     clock_adpcm -- clock the next ADPCM byte
+     clock_voice -- clock the next ADPCM byte
 
 ***********************************************************************************************/
 
-static INT16 clock_adpcm(struct ADPCMVoice *voice, UINT8 nibble)
+static INT16 clock_voice(struct ADPCMVoice *voice, UINT8 nibble)
 {
-	voice->signal += diff_lookup[voice->step * 16 + (nibble & 15)];
+	const adpcm_lookup *entry = &lookup[voice->step * 16 + (nibble & 15)];
+
+	voice->signal += entry->diff;
 
 	/* clamp to the maximum 12bit */
 	if (voice->signal > 2047)
@@ -152,12 +105,8 @@ static INT16 clock_adpcm(struct ADPCMVoice *voice, UINT8 nibble)
 	else if (voice->signal < -2048)
 		voice->signal = -2048;
 
-	/* adjust the step size and clamp */
-	voice->step += index_shift[nibble & 7];
-	if (voice->step > 48)
-		voice->step = 48;
-	else if (voice->step < 0)
-		voice->step = 0;
+	/* adjust the step size */
+	voice->step = entry->next;
 
 	/* return the signal */
 	return voice->signal;
@@ -208,7 +157,7 @@ static void generate_adpcm(okim6376_state *chip, struct ADPCMVoice *voice, INT16
 
 			/* output to the buffer, scaling by the volume */
 			/* signal in range -4096..4095, volume in range 2..16 => signal * volume / 2 in range -32768..32767 */
-			*buffer++ = clock_adpcm(voice, nibble) * voice->volume / 2;
+			*buffer++ = clock_voice(voice, nibble) * voice->volume / 2;
 
 			++sample;
 			--count;
@@ -304,7 +253,7 @@ static DEVICE_START( okim6376 )
 	int voice;
 	int divisor = 165;
 
-	compute_tables();
+	lookup = adpcm_get_lookup();
 
 	info->command = -1;
 	info->region_base = device->region;
@@ -318,7 +267,7 @@ static DEVICE_START( okim6376 )
 	{
 		/* initialize the rest of the structure */
 		info->voice[voice].volume = 0;
-		reset_adpcm(&info->voice[voice]);
+		reset_voice(&info->voice[voice]);
 	}
 
 	okim6376_state_save_register(info, device);
@@ -425,7 +374,7 @@ WRITE8_DEVICE_HANDLER( okim6376_w )
 						voice->count = 0;
 
 						/* also reset the ADPCM parameters */
-						reset_adpcm(voice);
+						reset_voice(voice);
 						/* FIX: no attenuation for now */
 						voice->volume = volume_table[0];
 					}
@@ -187,6 +187,7 @@ WRITE8_DEVICE_HANDLER( qsound_w )
 			break;
 
 		case 2:
+			stream_wake(chip->stream);
 			qsound_set_command(chip, data, chip->data);
 			break;
 
@@ -318,7 +319,7 @@ static void qsound_set_command(qsound_state *chip, int data, int value)
 static STREAM_UPDATE( qsound_update )
 {
 	qsound_state *chip = (qsound_state *)param;
-	int i,j;
+	int i,j,keyed=0;
 	int rvol, lvol, count;
 	struct QSOUND_CHANNEL *pC=&chip->channel[0];
 	stream_sample_t  *datap[2];
@@ -365,9 +366,14 @@ static STREAM_UPDATE( qsound_update )
 				pC->offset += pC->pitch;
 			}
 		}
+		keyed |= pC->key;
 		pC++;
 	}
 
+	/* every channel is keyed off; sleep until the next command (unless logging raw data) */
+	if (!keyed && chip->fpRawDataL == NULL && chip->fpRawDataR == NULL)
+		stream_set_idle(chip->stream);
+
 	if (chip->fpRawDataL)
 		fwrite(datap[0], samples*sizeof(QSOUND_SAMPLE), 1, chip->fpRawDataL);
 	if (chip->fpRawDataR)
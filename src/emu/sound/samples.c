@@ -1,6 +1,7 @@
 #include "driver.h"
 #include "streams.h"
 #include "samples.h"
+#include "samplesrc.h"
 
 
 typedef struct _sample_channel sample_channel;
@@ -16,6 +17,13 @@ struct _sample_channel
 	UINT32		basefreq;
 	UINT8		loop;
 	UINT8		paused;
+	UINT8		streaming;		/* playing a sample decoded from its file */
+	INT16		first;			/* first frame, for interpolating across the loop point */
+	sample_source *reader;		/* decode buffer for streamed samples */
+	mame_file *	file;			/* file being streamed from */
+	INT32		file_num;		/* sample the file belongs to */
+	UINT32		file_offset;	/* offset of the PCM data within the file */
+	int			file_bits;		/* 8 or 16 bits per sample */
 };
 
 
@@ -45,12 +53,27 @@ INLINE samples_info *get_safe_token(const device_config *device)
 #define FRAC_MASK		(FRAC_ONE - 1)
 #define MAX_CHANNELS    100
 
+/* samples with more PCM data than this are streamed instead of loaded */
+#define STREAM_THRESHOLD	(256 * 1024)
+
+/* frames decoded at a time for a streamed sample */
+#define STREAM_FRAMES		4096
+
+
+INLINE int channel_active(const sample_channel *chan)
+{
+	return (chan->source != NULL || chan->streaming);
+}
+
 
 /*-------------------------------------------------
-    read_wav_sample - read a WAV file as a sample
+    read_wav_sample - read a WAV file as a sample;
+    if a filename is given and the sample is long,
+    only note where its data lives so it can be
+    streamed
 -------------------------------------------------*/
 
-static int read_wav_sample(running_machine *machine, mame_file *f, loaded_sample *sample)
+static int read_wav_sample(running_machine *machine, mame_file *f, loaded_sample *sample, const char *filename)
 {
 	unsigned long offset = 0;
 	UINT32 length, rate, filesize;
@@ -147,6 +170,16 @@ static int read_wav_sample(running_machine *machine, mame_file *f, loaded_sample
 	sample->length = length;
 	sample->frequency = rate;
 
+	/* long samples are decoded as they play */
+	if (filename != NULL && length > STREAM_THRESHOLD)
+	{
+		sample->filename = auto_strdup(machine, filename);
+		sample->offset = mame_ftell(f);
+		sample->bits = bits;
+		sample->length = length / (bits / 8);
+		return 1;
+	}
+
 	/* read the data in */
 	if (bits == 8)
 	{
@@ -176,10 +209,11 @@ static int read_wav_sample(running_machine *machine, mame_file *f, loaded_sample
 
 
 /*-------------------------------------------------
-    readsamples - load all samples
+    load_samples - load all samples, leaving long
+    ones to be streamed if allowed
 -------------------------------------------------*/
 
-loaded_samples *readsamples(running_machine *machine, const char *const *samplenames, const char *basename)
+static loaded_samples *load_samples(running_machine *machine, const char *const *samplenames, const char *basename, int allow_streaming)
 {
 	loaded_samples *samples;
 	int skipfirst = 0;
@@ -222,7 +256,7 @@ loaded_samples *readsamples(running_machine *machine, const char *const *samplen
 			}
 			if (filerr == FILERR_NONE)
 			{
-				read_wav_sample(machine, f, &samples->sample[i]);
+				read_wav_sample(machine, f, &samples->sample[i], allow_streaming ? astring_c(fname) : NULL);
 				mame_fclose(f);
 			}
 
@@ -233,6 +267,89 @@ loaded_samples *readsamples(running_machine *machine, const char *const *samplen
 }
 
 
+/*-------------------------------------------------
+    readsamples - load all samples fully into
+    memory
+-------------------------------------------------*/
+
+loaded_samples *readsamples(running_machine *machine, const char *const *samplenames, const char *basename)
+{
+	return load_samples(machine, samplenames, basename, FALSE);
+}
+
+
+/*-------------------------------------------------
+    stream_read - sample source callback that
+    decodes PCM data from a channel's file
+-------------------------------------------------*/
+
+static UINT32 stream_read(void *param, UINT32 position, INT16 *dest, UINT32 frames)
+{
+	sample_channel *chan = (sample_channel *)param;
+	UINT32 sindex;
+
+	if (chan->file == NULL)
+		return 0;
+
+	if (chan->file_bits == 8)
+	{
+		/* read into the top half of the buffer and expand downwards */
+		UINT8 *tempptr = (UINT8 *)dest + frames;
+
+		mame_fseek(chan->file, chan->file_offset + position, SEEK_SET);
+		frames = mame_fread(chan->file, tempptr, frames);
+		for (sindex = 0; sindex < frames; sindex++)
+			dest[sindex] = (INT8)(tempptr[sindex] ^ 0x80) * 256;
+	}
+	else
+	{
+		mame_fseek(chan->file, chan->file_offset + position * 2, SEEK_SET);
+		frames = mame_fread(chan->file, dest, frames * 2) / 2;
+		if (ENDIANNESS_NATIVE != ENDIANNESS_LITTLE)
+			for (sindex = 0; sindex < frames; sindex++)
+				dest[sindex] = LITTLE_ENDIANIZE_INT16(dest[sindex]);
+	}
+	return frames;
+}
+
+
+/*-------------------------------------------------
+    stream_attach - open the file behind a
+    streamed sample and prime the channel's
+    decode buffer
+-------------------------------------------------*/
+
+static int stream_attach(sample_channel *chan, const loaded_sample *sample, int samplenum)
+{
+	const INT16 *data;
+	UINT32 frames;
+
+	/* keep the file open while the same sample is retriggered */
+	if (chan->file_num != samplenum)
+	{
+		if (chan->file != NULL)
+			mame_fclose(chan->file);
+		chan->file_num = -1;
+		if (mame_fopen(SEARCHPATH_SAMPLE, sample->filename, OPEN_FLAG_READ, &chan->file) != FILERR_NONE)
+		{
+			chan->file = NULL;
+			return FALSE;
+		}
+		chan->file_num = samplenum;
+		chan->file_offset = sample->offset;
+		chan->file_bits = sample->bits;
+	}
+
+	/* the first frame is needed whenever we interpolate across the end */
+	sample_source_flush(chan->reader);
+	data = sample_source_fetch(chan->reader, 0, 1, &frames);
+	if (frames == 0)
+		return FALSE;
+	chan->first = data[0];
+	return TRUE;
+}
+
+
 
 
 /* Start one of the samples loaded from disk. Note: channel must be in the range */
@@ -261,6 +378,14 @@ void sample_start(const device_config *device,int channel,int samplenum,int loop
 	chan->source = sample->data;
 	chan->source_length = sample->length;
 	chan->source_num = sample->data ? samplenum : -1;
+	chan->streaming = FALSE;
+	if (sample->data != NULL)
+		chan->first = sample->data[0];
+	else if (sample->filename != NULL && stream_attach(chan, sample, samplenum))
+	{
+		chan->streaming = TRUE;
+		chan->source_num = samplenum;
+	}
 	chan->pos = 0;
 	chan->frac = 0;
 	chan->basefreq = sample->frequency;
@@ -285,6 +410,8 @@ void sample_start_raw(const device_config *device,int channel,const INT16 *sampl
 	chan->source = sampledata;
 	chan->source_length = samples;
 	chan->source_num = -1;
+	chan->streaming = FALSE;
+	chan->first = (sampledata != NULL && samples > 0) ? sampledata[0] : 0;
 	chan->pos = 0;
 	chan->frac = 0;
 	chan->basefreq = frequency;
@@ -351,6 +478,7 @@ void sample_stop(const device_config *device,int channel)
     stream_update(chan->stream);
     chan->source = NULL;
     chan->source_num = -1;
+    chan->streaming = FALSE;
 }
 
 
@@ -380,7 +508,7 @@ int sample_playing(const device_config *device,int channel)
 
 	/* force an update before we start */
 	stream_update(chan->stream);
-	return (chan->source != NULL);
+	return channel_active(chan);
 }
 
 
@@ -389,7 +517,7 @@ static STREAM_UPDATE( sample_update_sound )
 	sample_channel *chan = (sample_channel *)param;
 	stream_sample_t *buffer = outputs[0];
 
-	if (chan->source && !chan->paused)
+	if (channel_active(chan) && !chan->paused)
 	{
 		/* load some info locally */
 		UINT32 pos = chan->pos;
@@ -397,13 +525,39 @@ static STREAM_UPDATE( sample_update_sound )
 		UINT32 step = chan->step;
 		const INT16 *sample = chan->source;
 		UINT32 sample_length = chan->source_length;
+		INT32 first = chan->first;
+		UINT32 base = 0, end = sample_length;
+
+		/* streamed samples start with nothing decoded */
+		if (chan->streaming)
+			end = 0;
 
 		while (samples--)
 		{
+			INT32 sample1, sample2, fracmult;
+
+			/* make sure both frames we interpolate between are decoded */
+			if (pos < base || pos >= end || (pos + 1 == end && end < sample_length))
+			{
+				UINT32 frames;
+
+				sample = sample_source_fetch(chan->reader, pos, 2, &frames);
+				if (frames == 0)
+				{
+					/* the file came up short; treat it as the end of the sample */
+					chan->streaming = FALSE;
+					chan->source_num = -1;
+					memset(buffer, 0, (samples + 1) * sizeof(*buffer));
+					break;
+				}
+				base = pos;
+				end = pos + frames;
+			}
+
 			/* do a linear interp on the sample */
-			INT32 sample1 = sample[pos];
-			INT32 sample2 = sample[(pos + 1) % sample_length];
-			INT32 fracmult = frac >> (FRAC_BITS - 14);
+			sample1 = sample[pos - base];
+			sample2 = (pos + 1 < sample_length) ? sample[pos + 1 - base] : first;
+			fracmult = frac >> (FRAC_BITS - 14);
 			*buffer++ = ((0x4000 - fracmult) * sample1 + fracmult * sample2) >> 14;
 
 			/* advance */
@@ -420,6 +574,7 @@ static STREAM_UPDATE( sample_update_sound )
 				{
 					chan->source = NULL;
 					chan->source_num = -1;
+					chan->streaming = FALSE;
 					if (samples > 0)
 						memset(buffer, 0, samples * sizeof(*buffer));
 					break;
@@ -447,17 +602,22 @@ static STATE_POSTLOAD( samples_postload )
 		sample_channel *chan = &info->channel[i];
 
 		/* attach any samples that were loaded and playing */
+		chan->streaming = FALSE;
 		if (chan->source_num >= 0 && chan->source_num < info->samples->total)
 		{
 			loaded_sample *sample = &info->samples->sample[chan->source_num];
 			chan->source = sample->data;
 			chan->source_length = sample->length;
-			if (!sample->data)
+			if (sample->data != NULL)
+				chan->first = sample->data[0];
+			else if (sample->filename != NULL && stream_attach(chan, sample, chan->source_num))
+				chan->streaming = TRUE;
+			else
 				chan->source_num = -1;
 		}
 
 		/* validate the position against the length in case the sample is smaller */
-		if (chan->source && chan->pos >= chan->source_length)
+		if (channel_active(chan) && chan->pos >= chan->source_length)
 		{
 			if (chan->loop)
 				chan->pos %= chan->source_length;
@@ -465,6 +625,7 @@ static STATE_POSTLOAD( samples_postload )
 			{
 				chan->source = NULL;
 				chan->source_num = -1;
+				chan->streaming = FALSE;
 			}
 		}
 	}
@@ -473,15 +634,19 @@ static STATE_POSTLOAD( samples_postload )
 
 static DEVICE_START( samples )
 {
-	int i;
+	int i, streamed = FALSE;
 	const samples_interface *intf = (const samples_interface *)device->static_config;
 	samples_info *info = get_safe_token(device);
 
 	info->device = device;
 
-	/* read audio samples */
+	/* read audio samples, noting whether any of them are streamed */
 	if (intf->samplenames)
-		info->samples = readsamples(device->machine, intf->samplenames,device->machine->gamedrv->name);
+		info->samples = load_samples(device->machine, intf->samplenames, device->machine->gamedrv->name, TRUE);
+	if (info->samples != NULL)
+		for (i = 0; i < info->samples->total; i++)
+			if (info->samples->sample[i].filename != NULL)
+				streamed = TRUE;
 
 	/* allocate channels */
 	info->numchannels = intf->channels;
@@ -496,6 +661,12 @@ static DEVICE_START( samples )
 		info->channel[i].step = 0;
 		info->channel[i].loop = 0;
 		info->channel[i].paused = 0;
+		info->channel[i].streaming = FALSE;
+		info->channel[i].reader = NULL;
+		info->channel[i].file = NULL;
+		info->channel[i].file_num = -1;
+		if (streamed)
+			info->channel[i].reader = sample_source_alloc(device->machine, 1, STREAM_FRAMES, stream_read, &info->channel[i]);
 
 		/* register with the save state system */
         state_save_register_device_item(device, i, info->channel[i].source_length);
@@ -514,6 +685,18 @@ static DEVICE_START( samples )
 }
 
 
+static DEVICE_STOP( samples )
+{
+	samples_info *info = get_safe_token(device);
+	int i;
+
+	/* close any files still open for streaming */
+	for (i = 0; i < info->numchannels; i++)
+		if (info->channel[i].file != NULL)
+			mame_fclose(info->channel[i].file);
+}
+
+
 
 /**************************************************************************
  * Generic get_info
@@ -528,7 +711,7 @@ DEVICE_GET_INFO( samples )
 
 		/* --- the following bits of info are returned as pointers to data or functions --- */
         case DEVINFO_FCT_START:                         info->start = DEVICE_START_NAME( samples );		break;
-        case DEVINFO_FCT_STOP:                          /* Nothing */                           		break;
+        case DEVINFO_FCT_STOP:                          info->stop = DEVICE_STOP_NAME( samples );		break;
         case DEVINFO_FCT_RESET:                         /* Nothing */                           		break;
 
 		/* --- the following bits of info are returned as NULL-terminated strings --- */
@@ -9,6 +9,12 @@ struct _loaded_sample
     int         length;         /* length in samples */
     int         frequency;      /* frequency of the sample */
     INT16 *     data;           /* 16-bit signed data */
+
+    /* long samples played through the samples device leave data NULL */
+    /* and are decoded from their file as they play */
+    const char *filename;       /* file to stream from */
+    UINT32      offset;         /* offset of the PCM data within the file */
+    int         bits;           /* 8 or 16 bits per sample */
 };
 
 typedef struct _loaded_samples loaded_samples;
@@ -0,0 +1,107 @@
+/***************************************************************************
+
+    samplesrc.c
+
+    Streaming sample sources decoded on demand into a small buffer.
+
+    Copyright Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+***************************************************************************/
+
+#include "driver.h"
+#include "sound/samplesrc.h"
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+struct _sample_source
+{
+	sample_source_read_func read;		/* decode callback */
+	void *				param;			/* callback parameter */
+	int					channels;		/* samples per frame */
+	UINT32				size;			/* buffer size, in frames */
+	INT16 *				buffer;			/* decoded frames */
+	UINT32				start;			/* position of the first buffered frame */
+	UINT32				count;			/* number of frames buffered */
+	UINT8				ended;			/* the callback ran out of data after the last buffered frame */
+};
+
+
+
+/***************************************************************************
+    CORE IMPLEMENTATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    sample_source_alloc - allocate a new sample
+    source
+-------------------------------------------------*/
+
+sample_source *sample_source_alloc(running_machine *machine, int channels, UINT32 frames, sample_source_read_func read, void *param)
+{
+	sample_source *source = auto_alloc_clear(machine, sample_source);
+
+	assert(channels > 0);
+	assert(frames > 0);
+	assert(read != NULL);
+
+	source->read = read;
+	source->param = param;
+	source->channels = channels;
+	source->size = frames;
+	source->buffer = auto_alloc_array(machine, INT16, frames * channels);
+	return source;
+}
+
+
+/*-------------------------------------------------
+    sample_source_flush - discard all buffered
+    frames
+-------------------------------------------------*/
+
+void sample_source_flush(sample_source *source)
+{
+	source->start = 0;
+	source->count = 0;
+	source->ended = FALSE;
+}
+
+
+/*-------------------------------------------------
+    sample_source_fetch - return a pointer to the
+    frame at the given position, decoding more
+    as needed
+-------------------------------------------------*/
+
+const INT16 *sample_source_fetch(sample_source *source, UINT32 position, UINT32 minframes, UINT32 *frames)
+{
+	UINT32 keep = 0;
+
+	assert(minframes <= source->size);
+
+	/* count how many frames from the requested position are already buffered */
+	if (position >= source->start && position - source->start < source->count)
+		keep = source->count - (position - source->start);
+
+	/* if that's enough, or all there is, we're done */
+	if (keep >= minframes || (keep > 0 && source->ended))
+	{
+		*frames = keep;
+		return &source->buffer[(position - source->start) * source->channels];
+	}
+
+	/* slide the frames we still need to the front */
+	if (keep > 0 && position != source->start)
+		memmove(source->buffer, &source->buffer[(position - source->start) * source->channels], keep * source->channels * sizeof(source->buffer[0]));
+	source->start = position;
+
+	/* and decode the rest of the buffer after them */
+	source->count = keep + (*source->read)(source->param, position + keep, &source->buffer[keep * source->channels], source->size - keep);
+	source->ended = (source->count < source->size);
+
+	*frames = source->count;
+	return source->buffer;
+}
@@ -0,0 +1,60 @@
+/***************************************************************************
+
+    samplesrc.h
+
+    Streaming sample sources decoded on demand into a small buffer.
+
+    Copyright Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+****************************************************************************
+
+    A sample source wraps a read callback that decodes interleaved 16-bit
+    frames at an arbitrary position, and keeps a window of recently
+    decoded frames so that a voice playing through a long sample only
+    ever holds a few thousand frames in memory. Positions are in frames
+    and are chosen by the owner: samples.c uses the offset within a WAV
+    file, cdda.c uses the absolute frame on the disc.
+
+    sample_source_fetch() returns a pointer to the frame at the requested
+    position. When fewer than the requested minimum are buffered, the
+    frames still needed are slid to the front of the buffer and the rest
+    of it is refilled from the callback, so sequential playback reads
+    each frame exactly once and a loop or seek costs one refill.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __SAMPLESRC_H__
+#define __SAMPLESRC_H__
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+/* decode up to 'frames' interleaved frames starting at 'position' into */
+/* 'dest', returning how many were decoded (fewer only at the end of the data) */
+typedef UINT32 (*sample_source_read_func)(void *param, UINT32 position, INT16 *dest, UINT32 frames);
+
+typedef struct _sample_source sample_source;
+
+
+
+/***************************************************************************
+    FUNCTION PROTOTYPES
+***************************************************************************/
+
+/* allocate a source buffering up to 'frames' frames of 'channels' samples each */
+sample_source *sample_source_alloc(running_machine *machine, int channels, UINT32 frames, sample_source_read_func read, void *param);
+
+/* discard everything buffered, e.g. after the data behind the callback changed */
+void sample_source_flush(sample_source *source);
+
+/* return the frame at 'position', decoding so that at least 'minframes' */
+/* are available if the data allows; '*frames' receives the count available */
+const INT16 *sample_source_fetch(sample_source *source, UINT32 position, UINT32 minframes, UINT32 *frames);
+
+
+#endif	/* __SAMPLESRC_H__ */
@@ -907,7 +907,10 @@ static void SCSP_w16(struct _SCSP *SCSP,unsigned int addr,unsigned short val)
 		else if(addr<0x800)
 			*((unsigned short *) (SCSP->DSP.MADRS+(addr-0x780)/2))=val;
 		else if(addr<0xC00)
+		{
 			*((unsigned short *) (SCSP->DSP.MPRO+(addr-0x800)/2))=val;
+			SCSP->DSP.Dirty=1;
+		}
 
 		if(addr==0xBF0)
 		{
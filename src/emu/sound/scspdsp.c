@@ -62,7 +62,25 @@ void SCSPDSP_Init(struct _SCSPDSP *DSP)
 	DSP->Stopped=1;
 }
 
-void SCSPDSP_Step(struct _SCSPDSP *DSP)
+/*
+    The microprogram is decoded into OPS[] whenever MPRO changes, so the
+    per-sample loop below only reads pre-extracted fields. Set
+    SCSPDSP_VALIDATE to 1 to also run the original field-decoding
+    interpreter every sample and log any difference in the results.
+*/
+#define SCSPDSP_VALIDATE	0
+
+#if SCSPDSP_VALIDATE
+struct _SCSPDSP_UNDO
+{
+	UINT32 addr[128];	//address of each memory write, in program order
+	UINT16 data[128];	//word it overwrote
+	UINT16 final[128];	//word left there once the program finished
+	int count;
+};
+
+/* reference interpreter, decoding every field from MPRO each sample */
+static void SCSPDSP_Interpret(struct _SCSPDSP *DSP, struct _SCSPDSP_UNDO *undo)
 {
 	INT32 ACC=0;	//26 bit
 	INT32 SHIFTED=0;	//24 bit
@@ -307,6 +325,8 @@ void SCSPDSP_Step(struct _SCSPDSP *DSP)
 			}
 			if(MWT && (step&1))
 			{
+				undo->addr[undo->count]=ADDR;
+				undo->data[undo->count++]=DSP->SCSPRAM[ADDR];
 				if(NOFL)
 			      		DSP->SCSPRAM[ADDR]=SHIFTED>>8;
 				else
@@ -331,6 +351,266 @@ void SCSPDSP_Step(struct _SCSPDSP *DSP)
 //  if(f)
 //      fclose(f);
 }
+#endif	/* SCSPDSP_VALIDATE */
+
+static void SCSPDSP_Decode(struct _SCSPDSP *DSP)
+{
+	int step;
+
+	for(step=0;step<128;++step)
+	{
+		const UINT16 *IPtr=DSP->MPRO+step*4;
+		struct _SCSPDSP_OP *op=&DSP->OPS[step];
+
+		op->TRA=(IPtr[0]>>8)&0x7F;
+		op->TWT=(IPtr[0]>>7)&0x01;
+		op->TWA=(IPtr[0]>>0)&0x7F;
+
+		op->XSEL=(IPtr[1]>>15)&0x01;
+		op->YSEL=(IPtr[1]>>13)&0x03;
+		op->IRA=(IPtr[1]>>6)&0x3F;
+		op->IWT=(IPtr[1]>>5)&0x01;
+		op->IWA=(IPtr[1]>>0)&0x1F;
+
+		op->TABLE=(IPtr[2]>>15)&0x01;
+		op->EWT=(IPtr[2]>>12)&0x01;
+		op->EWA=(IPtr[2]>>8)&0x0F;
+		op->ADRL=(IPtr[2]>>7)&0x01;
+		op->FRCL=(IPtr[2]>>6)&0x01;
+		op->SHIFT=(IPtr[2]>>4)&0x03;
+		op->YRL=(IPtr[2]>>3)&0x01;
+		op->NEGB=(IPtr[2]>>2)&0x01;
+		op->ZERO=(IPtr[2]>>1)&0x01;
+		op->BSEL=(IPtr[2]>>0)&0x01;
+
+		op->NOFL=(IPtr[3]>>15)&1;
+		op->COEF=(IPtr[3]>>9)&0x3f;
+		op->MASA=(IPtr[3]>>2)&0x1f;
+		op->ADREB=(IPtr[3]>>1)&0x1;
+		op->NXADR=(IPtr[3]>>0)&0x1;
+
+		//memory is only accessed on odd steps, so even steps never touch it
+		op->MRD=((IPtr[2]>>13)&0x01) && (step&1);
+		op->MWT=((IPtr[2]>>14)&0x01) && (step&1);
+	}
+	DSP->Dirty=0;
+}
+
+static void SCSPDSP_Execute(struct _SCSPDSP *DSP)
+{
+	INT32 ACC=0;	//26 bit
+	INT32 SHIFTED=0;	//24 bit
+	INT32 X=0;	//24 bit
+	INT32 Y=0;	//13 bit
+	INT32 B=0;	//26 bit
+	INT32 INPUTS=0;	//24 bit
+	INT32 MEMVAL=0;
+	INT32 FRC_REG=0;	//13 bit
+	INT32 Y_REG=0;		//24 bit
+	UINT32 ADDR=0;
+	UINT32 ADRS_REG=0;	//13 bit
+	const struct _SCSPDSP_OP *op=DSP->OPS;
+	const struct _SCSPDSP_OP *last=op+DSP->LastStep;
+
+	memset(DSP->EFREG,0,2*16);
+	for(;op<last;++op)
+	{
+		INT64 v;
+
+		//INPUTS RW
+		if(op->IRA<=0x1f)
+			INPUTS=DSP->MEMS[op->IRA];
+		else if(op->IRA<=0x2F)
+			INPUTS=DSP->MIXS[op->IRA-0x20]<<4;	//MIXS is 20 bit
+		else if(op->IRA<=0x31)
+			INPUTS=0;
+		else
+			return;
+
+		INPUTS<<=8;
+		INPUTS>>=8;
+
+		if(op->IWT)
+		{
+			DSP->MEMS[op->IWA]=MEMVAL;	//MEMVAL was selected in previous MRD
+			if(op->IRA==op->IWA)
+				INPUTS=MEMVAL;
+		}
+
+		//Operand sel
+		//B
+		if(!op->ZERO)
+		{
+			if(op->BSEL)
+				B=ACC;
+			else
+			{
+				B=DSP->TEMP[(op->TRA+DSP->DEC)&0x7F];
+				B<<=8;
+				B>>=8;
+			}
+			if(op->NEGB)
+				B=0-B;
+		}
+		else
+			B=0;
+
+		//X
+		if(op->XSEL)
+			X=INPUTS;
+		else
+		{
+			X=DSP->TEMP[(op->TRA+DSP->DEC)&0x7F];
+			X<<=8;
+			X>>=8;
+		}
+
+		//Y
+		switch(op->YSEL)
+		{
+			case 0:	Y=FRC_REG;						break;
+			case 1:	Y=DSP->COEF[op->COEF]>>3;		break;	//COEF is 16 bits
+			case 2:	Y=(Y_REG>>11)&0x1FFF;			break;
+			case 3:	Y=(Y_REG>>4)&0x0FFF;			break;
+		}
+
+		if(op->YRL)
+			Y_REG=INPUTS;
+
+		//Shifter
+		switch(op->SHIFT)
+		{
+			case 0:
+				SHIFTED=ACC;
+				if(SHIFTED>0x007FFFFF)
+					SHIFTED=0x007FFFFF;
+				if(SHIFTED<(-0x00800000))
+					SHIFTED=-0x00800000;
+				break;
+
+			case 1:
+				SHIFTED=ACC*2;
+				if(SHIFTED>0x007FFFFF)
+					SHIFTED=0x007FFFFF;
+				if(SHIFTED<(-0x00800000))
+					SHIFTED=-0x00800000;
+				break;
+
+			case 2:
+				SHIFTED=ACC*2;
+				SHIFTED<<=8;
+				SHIFTED>>=8;
+				break;
+
+			case 3:
+				SHIFTED=ACC;
+				SHIFTED<<=8;
+				SHIFTED>>=8;
+				break;
+		}
+
+		//ACCUM
+		Y<<=19;
+		Y>>=19;
+
+		v=(((INT64) X*(INT64) Y)>>12);
+		ACC=(int) v+B;
+
+		if(op->TWT)
+			DSP->TEMP[(op->TWA+DSP->DEC)&0x7F]=SHIFTED;
+
+		if(op->FRCL)
+		{
+			if(op->SHIFT==3)
+				FRC_REG=SHIFTED&0x0FFF;
+			else
+				FRC_REG=(SHIFTED>>11)&0x1FFF;
+		}
+
+		if(op->MRD || op->MWT)
+		{
+			ADDR=DSP->MADRS[op->MASA];
+			if(!op->TABLE)
+				ADDR+=DSP->DEC;
+			if(op->ADREB)
+				ADDR+=ADRS_REG&0x0FFF;
+			if(op->NXADR)
+				ADDR++;
+			if(!op->TABLE)
+				ADDR&=DSP->RBL-1;
+			else
+				ADDR&=0xFFFF;
+			ADDR+=DSP->RBP<<12;
+			if (ADDR > 0x7ffff) ADDR = 0;
+			if(op->MRD)
+			{
+				if(op->NOFL)
+					MEMVAL=DSP->SCSPRAM[ADDR]<<8;
+				else
+					MEMVAL=UNPACK(DSP->SCSPRAM[ADDR]);
+			}
+			if(op->MWT)
+			{
+				if(op->NOFL)
+					DSP->SCSPRAM[ADDR]=SHIFTED>>8;
+				else
+					DSP->SCSPRAM[ADDR]=PACK(SHIFTED);
+			}
+		}
+
+		if(op->ADRL)
+		{
+			if(op->SHIFT==3)
+				ADRS_REG=(SHIFTED>>12)&0xFFF;
+			else
+				ADRS_REG=(INPUTS>>16);
+		}
+
+		if(op->EWT)
+			DSP->EFREG[op->EWA]+=SHIFTED>>8;
+	}
+	--DSP->DEC;
+	memset(DSP->MIXS,0,4*16);
+}
+
+void SCSPDSP_Step(struct _SCSPDSP *DSP)
+{
+#if SCSPDSP_VALIDATE
+	struct _SCSPDSP *ref;
+	struct _SCSPDSP_UNDO undo;
+	int i;
+#endif
+
+	if(DSP->Stopped)
+		return;
+
+	if(DSP->Dirty)
+		SCSPDSP_Decode(DSP);
+
+#if SCSPDSP_VALIDATE
+	//run the interpreter on a copy, then roll its memory writes back
+	ref=(struct _SCSPDSP *)malloc(sizeof(*ref));
+	*ref=*DSP;
+	undo.count=0;
+	SCSPDSP_Interpret(ref,&undo);
+	for(i=0;i<undo.count;++i)
+		undo.final[i]=DSP->SCSPRAM[undo.addr[i]];
+	for(i=undo.count-1;i>=0;--i)
+		DSP->SCSPRAM[undo.addr[i]]=undo.data[i];
+#endif
+
+	SCSPDSP_Execute(DSP);
+
+#if SCSPDSP_VALIDATE
+	if(memcmp(ref->TEMP,DSP->TEMP,sizeof(DSP->TEMP)) || memcmp(ref->MEMS,DSP->MEMS,sizeof(DSP->MEMS)) ||
+	   memcmp(ref->EFREG,DSP->EFREG,sizeof(DSP->EFREG)) || ref->DEC!=DSP->DEC)
+		logerror("SCSPDSP: decoded program diverged from interpreter (DEC=%04X)\n",DSP->DEC);
+	for(i=0;i<undo.count;++i)
+		if(DSP->SCSPRAM[undo.addr[i]]!=undo.final[i])
+			logerror("SCSPDSP: decoded program left %04X at %05X, interpreter left %04X\n",DSP->SCSPRAM[undo.addr[i]],undo.addr[i],undo.final[i]);
+	free(ref);
+#endif
+}
 
 void SCSPDSP_SetSample(struct _SCSPDSP *DSP,INT32 sample,int SEL,int MXL)
 {
@@ -352,5 +632,6 @@ void SCSPDSP_Start(struct _SCSPDSP *DSP)
 			break;
 	}
 	DSP->LastStep=i+1;
+	SCSPDSP_Decode(DSP);
 
 }
@@ -3,6 +3,15 @@
 #ifndef __SCSPDSP_H__
 #define __SCSPDSP_H__
 
+//a pre-decoded microprogram step
+struct _SCSPDSP_OP
+{
+	UINT8 TRA, TWT, TWA;
+	UINT8 XSEL, YSEL, IRA, IWT, IWA;
+	UINT8 TABLE, MWT, MRD, EWT, EWA, ADRL, FRCL, SHIFT, YRL, NEGB, ZERO, BSEL;
+	UINT8 NOFL, COEF, MASA, ADREB, NXADR;
+};
+
 //the DSP Context
 struct _SCSPDSP
 {
@@ -30,6 +39,10 @@ struct _SCSPDSP
 
 	int Stopped;
 	int LastStep;
+
+//decoded program, rebuilt from MPRO when Dirty is set
+	struct _SCSPDSP_OP OPS[128];
+	int Dirty;
 };
 
 void SCSPDSP_Init(struct _SCSPDSP *DSP);
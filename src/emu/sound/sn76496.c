@@ -325,6 +325,7 @@ static int SN76496_init(const device_config *device, sn76496_state *R)
 	int i;
 
 	R->Channel = stream_create(device,0,1,sample_rate,R,SN76496Update);
+	stream_set_thread_safe(R->Channel);
 
 	for (i = 0;i < 4;i++) R->Volume[i] = 0;
 
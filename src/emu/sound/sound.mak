@@ -397,7 +397,7 @@ SOUNDDEFS += -DHAS_OKIM6295=$(if $(filter OKIM6295,$(SOUNDS)),1,0)
 SOUNDDEFS += -DHAS_OKIM6258=$(if $(filter OKIM6258,$(SOUNDS)),1,0)
 
 ifneq ($(filter MSM5205,$(SOUNDS)),)
-SOUNDOBJS += $(SOUNDOBJ)/msm5205.o
+SOUNDOBJS += $(SOUNDOBJ)/msm5205.o $(SOUNDOBJ)/okiadpcm.o
 endif
 
 ifneq ($(filter MSM5232,$(SOUNDS)),)
@@ -405,15 +405,15 @@ SOUNDOBJS += $(SOUNDOBJ)/msm5232.o
 endif
 
 ifneq ($(filter OKIM6376,$(SOUNDS)),)
-SOUNDOBJS += $(SOUNDOBJ)/okim6376.o
+SOUNDOBJS += $(SOUNDOBJ)/okim6376.o $(SOUNDOBJ)/okiadpcm.o
 endif
 
 ifneq ($(filter OKIM6295,$(SOUNDS)),)
-SOUNDOBJS += $(SOUNDOBJ)/okim6295.o
+SOUNDOBJS += $(SOUNDOBJ)/okim6295.o $(SOUNDOBJ)/okiadpcm.o
 endif
 
 ifneq ($(filter OKIM6258,$(SOUNDS)),)
-SOUNDOBJS += $(SOUNDOBJ)/okim6258.o
+SOUNDOBJS += $(SOUNDOBJ)/okim6258.o $(SOUNDOBJ)/okiadpcm.o
 endif
 
 
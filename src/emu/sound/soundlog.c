@@ -0,0 +1,226 @@
+/***************************************************************************
+
+    soundlog.c
+
+    Sound chip register write logging.
+
+    Copyright Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+***************************************************************************/
+
+#include "driver.h"
+#include "sound/soundlog.h"
+#include <zlib.h>
+
+
+/***************************************************************************
+    GLOBAL VARIABLES
+***************************************************************************/
+
+static FILE *logfile;
+static running_machine *logmachine;
+static const device_config *logdevice[SOUNDLOG_MAX_DEVICES];
+static int logdevices;
+
+
+
+/***************************************************************************
+    FUNCTION PROTOTYPES
+***************************************************************************/
+
+static void soundlog_exit(running_machine *machine);
+
+
+
+/***************************************************************************
+    INLINE FUNCTIONS
+***************************************************************************/
+
+INLINE void put8(UINT8 value)
+{
+	fputc(value, logfile);
+}
+
+
+INLINE void put32(UINT32 value)
+{
+	UINT8 buffer[4];
+	buffer[0] = value;
+	buffer[1] = value >> 8;
+	buffer[2] = value >> 16;
+	buffer[3] = value >> 24;
+	fwrite(buffer, 1, 4, logfile);
+}
+
+
+INLINE void put64(UINT64 value)
+{
+	put32((UINT32)value);
+	put32((UINT32)(value >> 32));
+}
+
+
+INLINE void putstring(const char *string)
+{
+	int length = MIN(strlen(string), 255);
+	put8(length);
+	fwrite(string, 1, length, logfile);
+}
+
+
+INLINE void putregion(const UINT8 *base, UINT32 length)
+{
+	put32(length);
+	put32(crc32(0, base, length));
+	fwrite(base, 1, length, logfile);
+}
+
+
+/*-------------------------------------------------
+    current_time - the current emulated time in
+    nanoseconds
+-------------------------------------------------*/
+
+INLINE UINT64 current_time(void)
+{
+	attotime now = timer_get_time(logmachine);
+	return (UINT64)now.seconds * 1000000000 + now.attoseconds / ATTOSECONDS_PER_NANOSECOND;
+}
+
+
+
+/***************************************************************************
+    INITIALIZATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    soundlog_init - open the log file if one
+    was requested
+-------------------------------------------------*/
+
+void soundlog_init(running_machine *machine, const char *filename)
+{
+	logdevices = 0;
+	if (filename[0] == 0)
+		return;
+
+	logfile = fopen(filename, "wb");
+	if (logfile == NULL)
+	{
+		mame_printf_warning("Unable to open sound log '%s'\n", filename);
+		return;
+	}
+	logmachine = machine;
+
+	fwrite(SOUNDLOG_MAGIC, 1, 8, logfile);
+	put32(SOUNDLOG_VERSION);
+
+	add_exit_callback(machine, soundlog_exit);
+}
+
+
+/*-------------------------------------------------
+    soundlog_exit - mark the end time and close
+    the log
+-------------------------------------------------*/
+
+static void soundlog_exit(running_machine *machine)
+{
+	put8(SOUNDLOG_END);
+	put64(current_time());
+	fclose(logfile);
+	logfile = NULL;
+}
+
+
+
+/***************************************************************************
+    LOGGING
+***************************************************************************/
+
+/*-------------------------------------------------
+    device_index - find the log index of a
+    device, writing its description (and the
+    contents of its ROM regions so the log can
+    be replayed on its own) the first time
+-------------------------------------------------*/
+
+static int device_index(const device_config *device)
+{
+	const UINT8 *deltat;
+	UINT32 deltatbytes;
+	astring *name;
+	int index;
+
+	for (index = 0; index < logdevices; index++)
+		if (logdevice[index] == device)
+			return index;
+	if (logdevices == SOUNDLOG_MAX_DEVICES)
+		return -1;
+	logdevice[logdevices] = device;
+
+	/* the Delta-T chips keep their second ADPCM ROM in a "<tag>.deltat" region */
+	name = astring_alloc();
+	astring_printf(name, "%s.deltat", device->tag);
+	deltat = memory_region(logmachine, astring_c(name));
+	deltatbytes = memory_region_length(logmachine, astring_c(name));
+	astring_free(name);
+
+	put8(SOUNDLOG_DEVICE);
+	put8(logdevices);
+	put32(device->clock);
+	putstring(device_get_name(device));
+	putstring(device->tag);
+	put8((device->region != NULL) + (deltat != NULL));
+	if (device->region != NULL)
+		putregion(device->region, device->regionbytes);
+	if (deltat != NULL)
+		putregion(deltat, deltatbytes);
+
+	return logdevices++;
+}
+
+
+/*-------------------------------------------------
+    soundlog_write - log a write to a sound
+    device's write handler
+-------------------------------------------------*/
+
+void soundlog_write(const device_config *device, offs_t offset, UINT8 data)
+{
+	int index;
+
+	if (logfile == NULL)
+		return;
+	index = device_index(device);
+	if (index < 0)
+		return;
+
+	put8(SOUNDLOG_WRITE);
+	put8(index);
+	put64(current_time());
+	put32(offset);
+	put8(data);
+}
+
+
+/*-------------------------------------------------
+    soundlog_reset - log a reset of a sound
+    device
+-------------------------------------------------*/
+
+void soundlog_reset(const device_config *device)
+{
+	int index;
+
+	if (logfile == NULL)
+		return;
+	index = device_index(device);
+	if (index < 0)
+		return;
+
+	put8(SOUNDLOG_RESET);
+	put8(index);
+	put64(current_time());
+}
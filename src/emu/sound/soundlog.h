@@ -0,0 +1,69 @@
+/***************************************************************************
+
+    soundlog.h
+
+    Sound chip register write logging.
+
+    Copyright Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+****************************************************************************
+
+    The log is a stream of little-endian records following an 8-byte
+    SOUNDLOG_MAGIC and a 32-bit SOUNDLOG_VERSION:
+
+    SOUNDLOG_DEVICE: UINT8 index, UINT32 clock, UINT8 length + name,
+        UINT8 length + tag, UINT8 region count, then for each region
+        UINT32 length, UINT32 crc32 and the region contents. Written the
+        first time a device shows up in the log.
+
+    SOUNDLOG_WRITE: UINT8 index, UINT64 time in nanoseconds, UINT32
+        offset, UINT8 data. One per write to the device's write handler.
+
+    SOUNDLOG_RESET: UINT8 index, UINT64 time in nanoseconds.
+
+    SOUNDLOG_END: UINT64 time in nanoseconds when the log was closed.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __SOUNDLOG_H__
+#define __SOUNDLOG_H__
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+#define SOUNDLOG_MAGIC			"MAMESLOG"
+#define SOUNDLOG_VERSION		1
+
+#define SOUNDLOG_MAX_DEVICES	32
+#define SOUNDLOG_MAX_REGIONS	2
+
+enum
+{
+	SOUNDLOG_END = 0,
+	SOUNDLOG_DEVICE,
+	SOUNDLOG_WRITE,
+	SOUNDLOG_RESET
+};
+
+
+
+/***************************************************************************
+    FUNCTION PROTOTYPES
+***************************************************************************/
+
+/* open the log file; logging stays off if the filename is empty */
+void soundlog_init(running_machine *machine, const char *filename);
+
+/* log a write to a sound device's write handler */
+void soundlog_write(const device_config *device, offs_t offset, UINT8 data);
+
+/* log a reset of a sound device */
+void soundlog_reset(const device_config *device);
+
+
+#endif	/* __SOUNDLOG_H__ */
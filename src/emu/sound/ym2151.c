@@ -1684,6 +1684,26 @@ INLINE signed int op_calc1(YM2151Operator * OP, unsigned int env, signed int pm)
 
 #define volume_calc(OP) ((OP)->tl + ((UINT32)(OP)->volume) + (AM & (OP)->AMmask))
 
+/* a channel can be left out of a whole update when all four operators are
+   off (only a register write or CSM can key them on again) and its feedback
+   and MEM delays have drained; its phase still moves on in advance() */
+static UINT32 silent_channels(void)
+{
+	UINT32 mask = 0;
+	int c;
+
+	if ((PSG->irq_enable & 0x80) || PSG->csm_req)
+		return 0;
+	for (c = 0; c < 8; c++)
+	{
+		YM2151Operator *op = &PSG->oper[c*4];
+		if (op[0].state == EG_OFF && op[1].state == EG_OFF && op[2].state == EG_OFF && op[3].state == EG_OFF &&
+			!op->fb_out_prev && !op->fb_out_curr && !op->mem_value)
+			mask |= 1 << c;
+	}
+	return mask;
+}
+
 INLINE void chan_calc(unsigned int chan)
 {
 	YM2151Operator *op;
@@ -2373,6 +2393,7 @@ void ym2151_update_one(void *chip, SAMP **buffers, int length)
 	int i;
 	signed int outl,outr;
 	SAMP *bufL, *bufR;
+	UINT32 silent;
 
 	bufL = buffers[0];
 	bufR = buffers[1];
@@ -2398,6 +2419,9 @@ void ym2151_update_one(void *chip, SAMP **buffers, int length)
 	}
 #endif
 
+	/* leave out the channels that are silent for this whole update */
+	silent = silent_channels();
+
 	for (i=0; i<length; i++)
 	{
 		advance_eg();
@@ -2411,21 +2435,21 @@ void ym2151_update_one(void *chip, SAMP **buffers, int length)
 		chanout[6] = 0;
 		chanout[7] = 0;
 
-		chan_calc(0);
+		if (!(silent & 0x01)) chan_calc(0);
 		SAVE_SINGLE_CHANNEL(0)
-		chan_calc(1);
+		if (!(silent & 0x02)) chan_calc(1);
 		SAVE_SINGLE_CHANNEL(1)
-		chan_calc(2);
+		if (!(silent & 0x04)) chan_calc(2);
 		SAVE_SINGLE_CHANNEL(2)
-		chan_calc(3);
+		if (!(silent & 0x08)) chan_calc(3);
 		SAVE_SINGLE_CHANNEL(3)
-		chan_calc(4);
+		if (!(silent & 0x10)) chan_calc(4);
 		SAVE_SINGLE_CHANNEL(4)
-		chan_calc(5);
+		if (!(silent & 0x20)) chan_calc(5);
 		SAVE_SINGLE_CHANNEL(5)
-		chan_calc(6);
+		if (!(silent & 0x40)) chan_calc(6);
 		SAVE_SINGLE_CHANNEL(6)
-		chan7_calc();
+		if (!(silent & 0x80)) chan7_calc();
 		SAVE_SINGLE_CHANNEL(7)
 
 		outl = chanout[0] & PSG->pan[0];
@@ -2481,6 +2505,25 @@ void ym2151_update_one(void *chip, SAMP **buffers, int length)
 	}
 }
 
+
+/*  Check if the chip has gone silent
+*
+*   All 32 operators have finished their release and CSM mode cannot
+*   key them on again, so updating would only produce silence
+*/
+int ym2151_is_idle(void *chip)
+{
+	YM2151 *PSG = (YM2151 *)chip;
+	int i;
+
+	if ((PSG->irq_enable & 0x80) || PSG->csm_req)
+		return 0;
+	for (i = 0; i < 32; i++)
+		if (PSG->oper[i].state != EG_OFF)
+			return 0;
+	return 1;
+}
+
 void ym2151_set_irq_handler(void *chip, void(*handler)(const device_config *device, int irq))
 {
 	YM2151 *PSG = (YM2151 *)chip;
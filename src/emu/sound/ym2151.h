@@ -71,6 +71,9 @@ void ym2151_reset_chip(void *chip);
 */
 void ym2151_update_one(void *chip, SAMP **buffers, int length);
 
+/* check if all operators on YM2151 chip number 'n' are silent */
+int ym2151_is_idle(void *chip);
+
 /* write 'v' to register 'r' on YM2151 chip number 'n'*/
 void ym2151_write_reg(void *chip, int r, int v);
 
@@ -2499,6 +2499,43 @@ int ymf262_timer_over(void *chip, int c)
 	return OPL3TimerOver((OPL3 *)chip, c);
 }
 
+/* TRUE if all 36 operators have finished their release (there is no CSM mode) */
+int ymf262_is_idle(void *_chip)
+{
+	OPL3 *chip = (OPL3 *)_chip;
+	int c,s;
+
+	for( c=0; c<18; c++ )
+		for( s=0; s<2; s++ )
+			if( chip->P_CH[c].SLOT[s].state != EG_OFF )
+				return 0;
+	return 1;
+}
+
+/* mask of the channels that can be left out of a whole update: both slots
+   off and the SLOT1 feedback delay drained.  The halves of a 4-op channel
+   share phase_modulation2 so they are only left out together */
+static UINT32 OPL3SilentChannels(OPL3 *chip)
+{
+	UINT32 mask = 0;
+	int c;
+
+	for( c=0; c<18; c++ )
+	{
+		OPL3_CH *CH = &chip->P_CH[c];
+		if( CH->SLOT[SLOT1].state == EG_OFF && CH->SLOT[SLOT2].state == EG_OFF &&
+			!CH->SLOT[SLOT1].op1_out[0] && !CH->SLOT[SLOT1].op1_out[1] )
+			mask |= 1 << c;
+	}
+	for( c=0; c<12; c++ )
+	{
+		UINT32 pair = (1 << c) | (1 << (c+3));
+		if( (c%9) < 3 && chip->P_CH[c].extended && (mask & pair) != pair )
+			mask &= ~pair;
+	}
+	return mask;
+}
+
 void ymf262_set_timer_handler(void *chip, OPL3_TIMERHANDLER timer_handler, void *param)
 {
 	OPL3SetTimerHandler((OPL3 *)chip, timer_handler, param);
@@ -2531,6 +2568,7 @@ void ymf262_update_one(void *_chip, OPL3SAMPLE **buffers, int length)
 	OPL3SAMPLE	*ch_d = buffers[3];
 
 	int i;
+	UINT32		silent;
 
 	if( (void *)chip != cur_chip ){
 		cur_chip = (void *)chip;
@@ -2540,6 +2578,9 @@ void ymf262_update_one(void *_chip, OPL3SAMPLE **buffers, int length)
 		SLOT8_1 = &chip->P_CH[8].SLOT[SLOT1];
 		SLOT8_2 = &chip->P_CH[8].SLOT[SLOT2];
 	}
+	/* leave out the channels that are silent for this whole update */
+	silent = OPL3SilentChannels(chip);
+
 	for( i=0; i < length ; i++ )
 	{
 		int a,b,c,d;
@@ -2552,32 +2593,38 @@ void ymf262_update_one(void *_chip, OPL3SAMPLE **buffers, int length)
 
 #if 1
 	/* register set #1 */
-		chan_calc(&chip->P_CH[0]);			/* extended 4op ch#0 part 1 or 2op ch#0 */
+		if (!(silent & 0x00001)) chan_calc(&chip->P_CH[ 0]);			/* extended 4op ch#0 part 1 or 2op ch#0 */
 		if (chip->P_CH[0].extended)
-			chan_calc_ext(&chip->P_CH[3]);	/* extended 4op ch#0 part 2 */
+		{
+			if (!(silent & 0x00008)) chan_calc_ext(&chip->P_CH[3]);	/* extended 4op ch#0 part 2 */
+		}
 		else
-			chan_calc(&chip->P_CH[3]);		/* standard 2op ch#3 */
+			if (!(silent & 0x00008)) chan_calc(&chip->P_CH[ 3]);		/* standard 2op ch#3 */
 
 
-		chan_calc(&chip->P_CH[1]);			/* extended 4op ch#1 part 1 or 2op ch#1 */
+		if (!(silent & 0x00002)) chan_calc(&chip->P_CH[ 1]);			/* extended 4op ch#1 part 1 or 2op ch#1 */
 		if (chip->P_CH[1].extended)
-			chan_calc_ext(&chip->P_CH[4]);	/* extended 4op ch#1 part 2 */
+		{
+			if (!(silent & 0x00010)) chan_calc_ext(&chip->P_CH[4]);	/* extended 4op ch#1 part 2 */
+		}
 		else
-			chan_calc(&chip->P_CH[4]);		/* standard 2op ch#4 */
+			if (!(silent & 0x00010)) chan_calc(&chip->P_CH[ 4]);		/* standard 2op ch#4 */
 
 
-		chan_calc(&chip->P_CH[2]);			/* extended 4op ch#2 part 1 or 2op ch#2 */
+		if (!(silent & 0x00004)) chan_calc(&chip->P_CH[ 2]);			/* extended 4op ch#2 part 1 or 2op ch#2 */
 		if (chip->P_CH[2].extended)
-			chan_calc_ext(&chip->P_CH[5]);	/* extended 4op ch#2 part 2 */
+		{
+			if (!(silent & 0x00020)) chan_calc_ext(&chip->P_CH[5]);	/* extended 4op ch#2 part 2 */
+		}
 		else
-			chan_calc(&chip->P_CH[5]);		/* standard 2op ch#5 */
+			if (!(silent & 0x00020)) chan_calc(&chip->P_CH[ 5]);		/* standard 2op ch#5 */
 
 
 		if(!rhythm)
 		{
-			chan_calc(&chip->P_CH[6]);
-			chan_calc(&chip->P_CH[7]);
-			chan_calc(&chip->P_CH[8]);
+			if (!(silent & 0x00040)) chan_calc(&chip->P_CH[ 6]);
+			if (!(silent & 0x00080)) chan_calc(&chip->P_CH[ 7]);
+			if (!(silent & 0x00100)) chan_calc(&chip->P_CH[ 8]);
 		}
 		else		/* Rhythm part */
 		{
@@ -2585,31 +2632,37 @@ void ymf262_update_one(void *_chip, OPL3SAMPLE **buffers, int length)
 		}
 
 	/* register set #2 */
-		chan_calc(&chip->P_CH[ 9]);
+		if (!(silent & 0x00200)) chan_calc(&chip->P_CH[ 9]);
 		if (chip->P_CH[9].extended)
-			chan_calc_ext(&chip->P_CH[12]);
+		{
+			if (!(silent & 0x01000)) chan_calc_ext(&chip->P_CH[12]);
+		}
 		else
-			chan_calc(&chip->P_CH[12]);
+			if (!(silent & 0x01000)) chan_calc(&chip->P_CH[12]);
 
 
-		chan_calc(&chip->P_CH[10]);
+		if (!(silent & 0x00400)) chan_calc(&chip->P_CH[10]);
 		if (chip->P_CH[10].extended)
-			chan_calc_ext(&chip->P_CH[13]);
+		{
+			if (!(silent & 0x02000)) chan_calc_ext(&chip->P_CH[13]);
+		}
 		else
-			chan_calc(&chip->P_CH[13]);
+			if (!(silent & 0x02000)) chan_calc(&chip->P_CH[13]);
 
 
-		chan_calc(&chip->P_CH[11]);
+		if (!(silent & 0x00800)) chan_calc(&chip->P_CH[11]);
 		if (chip->P_CH[11].extended)
-			chan_calc_ext(&chip->P_CH[14]);
+		{
+			if (!(silent & 0x04000)) chan_calc_ext(&chip->P_CH[14]);
+		}
 		else
-			chan_calc(&chip->P_CH[14]);
+			if (!(silent & 0x04000)) chan_calc(&chip->P_CH[14]);
 
 
         /* channels 15,16,17 are fixed 2-operator channels only */
-		chan_calc(&chip->P_CH[15]);
-		chan_calc(&chip->P_CH[16]);
-		chan_calc(&chip->P_CH[17]);
+		if (!(silent & 0x08000)) chan_calc(&chip->P_CH[15]);
+		if (!(silent & 0x10000)) chan_calc(&chip->P_CH[16]);
+		if (!(silent & 0x20000)) chan_calc(&chip->P_CH[17]);
 #endif
 
 		/* accumulator register set #1 */
@@ -41,6 +41,20 @@
     These sample buffers can then be further resampled and passed to
     other streams, or output as desired.
 
+    A stream with no inputs whose chip has gone quiet (all channels
+    keyed off and fully attenuated) can call stream_set_idle() from its
+    callback. From then on the engine fills its outputs with silence
+    without calling the callback, until the chip calls stream_wake()
+    from the register write path. Waking brings the stream up to date
+    first, so the silence ends exactly at the time of the write.
+
+    A stream with no inputs whose callback touches nothing but its own
+    chip state (no timers, no interrupts, no memory system reads) can
+    be marked with stream_set_thread_safe() after it is created. Such
+    streams may be brought up to date on a worker thread ahead of the
+    speaker mix, one sound core at a time. Everything else is updated
+    serially on the calling thread.
+
 ***************************************************************************/
 
 #include "driver.h"
@@ -57,6 +71,9 @@
 
 #define VPRINTF(x)	do { if (VERBOSE) mame_printf_debug x; } while (0)
 
+/* set to 0 to force all streams to update serially on the calling thread */
+#define PARALLEL_STREAMS	(1)
+
 
 
 /***************************************************************************
@@ -146,6 +163,30 @@ struct _sound_stream
 	/* callback information */
 	stream_update_func 	callback;				/* callback function */
 	void *				param;					/* callback function parameter */
+
+	/* graph information */
+	int					level;					/* 0 for streams with no sources, else 1 + deepest source */
+	UINT8				thread_safe;			/* TRUE if the callback may run on a worker thread */
+
+	/* idle information */
+	UINT8				idle;					/* TRUE if the callback reported silence until woken */
+	UINT64				idle_samples;			/* total samples filled with silence while idle */
+	UINT64				total_samples;			/* total samples generated */
+
+	/* timing information */
+	osd_ticks_t			callback_ticks;			/* total ticks spent in the callback */
+	osd_ticks_t			resample_ticks;			/* total ticks spent resampling the inputs */
+	UINT32				callback_calls;			/* number of callbacks made */
+};
+
+
+/* a set of leaf streams sharing one sound core, updated together by one work item */
+typedef struct _stream_leaf_group stream_leaf_group;
+struct _stream_leaf_group
+{
+	streams_private *	strdata;				/* pointer to the global streams data */
+	sound_stream **		stream;					/* first stream in the group */
+	int					count;					/* number of streams in the group */
 };
 
 
@@ -156,6 +197,17 @@ struct _streams_private
 	int					stream_index;			/* index of the current stream */
 	attoseconds_t		update_attoseconds;		/* attoseconds between global updates */
 	attotime			last_update;			/* last update time */
+
+	/* levelised graph */
+	UINT8				graph_dirty;			/* TRUE if streams or connections changed */
+	sound_stream **		leaf_list;				/* leaf streams, grouped by sound core */
+	stream_leaf_group *	leaf_group;				/* one entry per sound core that can run in parallel */
+	int					leaf_groups;			/* number of leaf groups */
+	int					leaf_alloc;				/* allocated size of leaf_list and leaf_group */
+
+	/* parallel updates */
+	osd_work_queue *	queue;					/* work queue for leaf streams */
+	attotime			update_time;			/* time being updated to by the work items */
 };
 
 
@@ -164,7 +216,10 @@ struct _streams_private
     FUNCTION PROTOTYPES
 ***************************************************************************/
 
+static void streams_exit(running_machine *machine);
 static STATE_POSTLOAD( stream_postload );
+static void levelise_streams(running_machine *machine);
+static void *leaf_group_update_callback(void *param, int threadid);
 static void allocate_resample_buffers(running_machine *machine, sound_stream *stream);
 static void allocate_output_buffers(running_machine *machine, sound_stream *stream);
 static void recompute_sample_rate_data(running_machine *machine, sound_stream *stream);
@@ -177,6 +232,31 @@ static stream_sample_t *generate_resampled_data(stream_input *input, UINT32 nums
     INLINE FUNCTIONS
 ***************************************************************************/
 
+/*-------------------------------------------------
+    stream_is_parallel_leaf - return TRUE if a
+    stream may be updated on a worker thread
+-------------------------------------------------*/
+
+INLINE int stream_is_parallel_leaf(const sound_stream *stream)
+{
+	return (stream->level == 0 && stream->thread_safe);
+}
+
+
+/*-------------------------------------------------
+    streams_share_core - return TRUE if two
+    streams may touch the same sound core state
+    and so must not be updated concurrently
+-------------------------------------------------*/
+
+INLINE int streams_share_core(const sound_stream *stream1, const sound_stream *stream2)
+{
+	/* chips of one family share their core's statics; devices without a family all
+       report the same default, which keeps them together as well */
+	return (stream1->device == stream2->device || strcmp(device_get_family(stream1->device), device_get_family(stream2->device)) == 0);
+}
+
+
 /*-------------------------------------------------
     time_to_sampindex - convert an absolute
     time to a sample index in a given stream
@@ -227,12 +307,190 @@ void streams_init(running_machine *machine)
 	/* set the global pointer */
 	machine->streams_data = strdata;
 
+	/* create a queue for updating independent streams in parallel */
+	if (PARALLEL_STREAMS)
+		strdata->queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	add_exit_callback(machine, streams_exit);
+
 	/* register global states */
 	state_save_register_global(machine, strdata->last_update.seconds);
 	state_save_register_global(machine, strdata->last_update.attoseconds);
 }
 
 
+/*-------------------------------------------------
+    streams_exit - clean up the streams engine and
+    report where the time went
+-------------------------------------------------*/
+
+static void streams_exit(running_machine *machine)
+{
+	streams_private *strdata = machine->streams_data;
+	osd_ticks_t total = 0;
+	sound_stream *stream;
+
+	/* free the work queue */
+	if (strdata->queue != NULL)
+		osd_work_queue_free(strdata->queue);
+
+	/* summarize the time spent in each stream */
+	for (stream = strdata->stream_head; stream != NULL; stream = stream->next)
+		total += stream->callback_ticks + stream->resample_ticks;
+	if (total != 0)
+		for (stream = strdata->stream_head; stream != NULL; stream = stream->next)
+			mame_printf_verbose("stream %d (%s, level %d): %5.1f%% of sound time (%5.1f%% resampling), %d updates, %5.1f%% idle\n",
+					stream->index, stream->device->tag, stream->level,
+					100.0 * (double)(stream->callback_ticks + stream->resample_ticks) / (double)total,
+					100.0 * (double)stream->resample_ticks / (double)total, stream->callback_calls,
+					(stream->total_samples != 0) ? 100.0 * (double)stream->idle_samples / (double)stream->total_samples : 0.0);
+}
+
+
+/*-------------------------------------------------
+    levelise_streams - compute the depth of each
+    stream in the graph and group the leaf
+    streams by sound core
+-------------------------------------------------*/
+
+static void levelise_streams(running_machine *machine)
+{
+	streams_private *strdata = machine->streams_data;
+	sound_stream *stream;
+	int changed, groupnum, count = 0;
+
+	/* iterate to a fixed point; the graph is acyclic, so this terminates */
+	for (stream = strdata->stream_head; stream != NULL; stream = stream->next)
+	{
+		stream->level = 0;
+		count++;
+	}
+	do
+	{
+		changed = FALSE;
+		for (stream = strdata->stream_head; stream != NULL; stream = stream->next)
+		{
+			int inputnum;
+			for (inputnum = 0; inputnum < stream->inputs; inputnum++)
+			{
+				stream_output *source = stream->input[inputnum].source;
+				if (source != NULL && source->owner->level + 1 > stream->level)
+				{
+					stream->level = source->owner->level + 1;
+					changed = TRUE;
+				}
+			}
+			assert(stream->level <= count);
+		}
+	} while (changed);
+
+	/* make sure we have room for the worst case */
+	if (strdata->leaf_alloc < count)
+	{
+		strdata->leaf_alloc = count;
+		strdata->leaf_list = auto_extend_array(machine, strdata->leaf_list, sound_stream *, count);
+		strdata->leaf_group = auto_extend_array(machine, strdata->leaf_group, stream_leaf_group, count);
+	}
+
+	/* gather the leaves, keeping all streams from one sound core together; cores
+       such as fm.c and fmopl.c keep per-sample scratch in statics shared by every
+       chip of that family, so those chips can never run concurrently */
+	strdata->leaf_groups = 0;
+	count = 0;
+	for (stream = strdata->stream_head; stream != NULL; stream = stream->next)
+		if (stream_is_parallel_leaf(stream))
+		{
+			sound_stream *other;
+
+			/* skip if this core has already been grouped */
+			for (groupnum = 0; groupnum < strdata->leaf_groups; groupnum++)
+				if (streams_share_core(strdata->leaf_group[groupnum].stream[0], stream))
+					break;
+			if (groupnum < strdata->leaf_groups)
+				continue;
+
+			/* add a new group with all of this core's leaf streams */
+			strdata->leaf_group[groupnum].strdata = strdata;
+			strdata->leaf_group[groupnum].stream = &strdata->leaf_list[count];
+			strdata->leaf_group[groupnum].count = 0;
+			for (other = stream; other != NULL; other = other->next)
+				if (stream_is_parallel_leaf(other) && streams_share_core(other, stream))
+				{
+					strdata->leaf_list[count++] = other;
+					strdata->leaf_group[groupnum].count++;
+				}
+			strdata->leaf_groups++;
+		}
+
+	/* a core that also drives streams which must run on this thread stays serial */
+	for (stream = strdata->stream_head; stream != NULL; stream = stream->next)
+		if (!stream_is_parallel_leaf(stream))
+			for (groupnum = 0; groupnum < strdata->leaf_groups; groupnum++)
+				if (strdata->leaf_group[groupnum].count != 0 && streams_share_core(strdata->leaf_group[groupnum].stream[0], stream))
+					strdata->leaf_group[groupnum].count = 0;
+
+	/* drop the groups that were left to the serial pass */
+	for (groupnum = count = 0; groupnum < strdata->leaf_groups; groupnum++)
+		if (strdata->leaf_group[groupnum].count != 0)
+			strdata->leaf_group[count++] = strdata->leaf_group[groupnum];
+	strdata->leaf_groups = count;
+
+	strdata->graph_dirty = FALSE;
+	VPRINTF(("levelise_streams: %d leaf groups\n", strdata->leaf_groups));
+}
+
+
+/*-------------------------------------------------
+    leaf_group_update_callback - work item that
+    brings all streams of a leaf group up to the
+    update time
+-------------------------------------------------*/
+
+static void *leaf_group_update_callback(void *param, int threadid)
+{
+	stream_leaf_group *group = (stream_leaf_group *)param;
+	int streamnum;
+
+	/* leaf streams have no inputs, so this touches only the streams of one core; the
+       bookkeeping matches stream_update so the serial walk sees the same state */
+	for (streamnum = 0; streamnum < group->count; streamnum++)
+	{
+		sound_stream *stream = group->stream[streamnum];
+		INT32 update_sampindex = time_to_sampindex(group->strdata, stream, group->strdata->update_time);
+
+		assert(stream->output_sampindex - stream->output_base_sampindex >= 0);
+		assert(update_sampindex - stream->output_base_sampindex <= stream->output_bufalloc);
+		generate_samples(stream, update_sampindex - stream->output_sampindex);
+		stream->output_sampindex = update_sampindex;
+	}
+	return NULL;
+}
+
+
+/*-------------------------------------------------
+    streams_update_leaves - bring the independent
+    leaf streams up to the current time in
+    parallel; called ahead of the speaker pull so
+    that the serial walk finds them current
+-------------------------------------------------*/
+
+void streams_update_leaves(running_machine *machine)
+{
+	streams_private *strdata = machine->streams_data;
+
+	/* re-levelise the graph if it changed */
+	if (strdata->graph_dirty)
+		levelise_streams(machine);
+
+	/* only worth queueing if more than one core can run */
+	if (strdata->queue != NULL && strdata->leaf_groups > 1)
+	{
+		strdata->update_time = timer_get_time(machine);
+		osd_work_item_queue_multiple(strdata->queue, leaf_group_update_callback, strdata->leaf_groups, strdata->leaf_group, sizeof(strdata->leaf_group[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		osd_work_queue_wait(strdata->queue, osd_ticks_per_second() * 10);
+	}
+}
+
+
 /*-------------------------------------------------
     streams_update - update all the streams
     periodically
@@ -393,6 +651,7 @@ sound_stream *stream_create(const device_config *device, int inputs, int outputs
 	/* hook us into the master stream list */
 	*strdata->stream_tailptr = stream;
 	strdata->stream_tailptr = &stream->next;
+	strdata->graph_dirty = TRUE;
 
 	/* force an update to the sample rates; this will cause everything to be recomputed
        and will generate the initial resample buffers for our inputs */
@@ -489,6 +748,7 @@ void stream_set_input(sound_stream *stream, int index, sound_stream *input_strea
 	/* update the dependent info */
 	if (input->source != NULL)
 		input->source->dependents++;
+	stream->device->machine->streams_data->graph_dirty = TRUE;
 
 	/* update sample rates now that we know the input */
 	recompute_sample_rate_data(stream->device->machine, stream);
@@ -537,6 +797,48 @@ const stream_sample_t *stream_get_output_since_last_update(sound_stream *stream,
 }
 
 
+/*-------------------------------------------------
+    stream_set_idle - called from a stream's
+    callback to report that it has gone silent
+    and will stay that way until woken
+-------------------------------------------------*/
+
+void stream_set_idle(sound_stream *stream)
+{
+	/* streams with inputs must keep running to consume them */
+	if (stream->inputs == 0)
+		stream->idle = TRUE;
+}
+
+
+/*-------------------------------------------------
+    stream_set_thread_safe - mark a stream whose
+    callback touches only its own chip, so that
+    it may be updated on a worker thread
+-------------------------------------------------*/
+
+void stream_set_thread_safe(sound_stream *stream)
+{
+	stream->thread_safe = TRUE;
+	stream->device->machine->streams_data->graph_dirty = TRUE;
+}
+
+
+/*-------------------------------------------------
+    stream_wake - bring an idle stream up to the
+    current time and resume calling its callback
+-------------------------------------------------*/
+
+void stream_wake(sound_stream *stream)
+{
+	if (stream->idle)
+	{
+		stream_update(stream);
+		stream->idle = FALSE;
+	}
+}
+
+
 
 /***************************************************************************
     STREAM TIMING
@@ -680,6 +982,35 @@ void stream_set_output_gain(sound_stream *stream, int output, float gain)
 }
 
 
+/*-------------------------------------------------
+    stream_get_profile - fetch the timing
+    counters of the nth stream
+-------------------------------------------------*/
+
+int stream_get_profile(running_machine *machine, int index, stream_profile *profile)
+{
+	streams_private *strdata = machine->streams_data;
+	sound_stream *stream;
+
+	/* find the stream */
+	for (stream = strdata->stream_head; stream != NULL && index > 0; stream = stream->next)
+		index--;
+	if (stream == NULL)
+		return FALSE;
+
+	profile->device = stream->device;
+	profile->index = stream->index;
+	profile->level = stream->level;
+	profile->sample_rate = stream->sample_rate;
+	profile->callback_ticks = stream->callback_ticks;
+	profile->resample_ticks = stream->resample_ticks;
+	profile->callback_calls = stream->callback_calls;
+	profile->total_samples = stream->total_samples;
+	profile->idle_samples = stream->idle_samples;
+	return TRUE;
+}
+
+
 
 /***************************************************************************
     STREAM BUFFER MAINTENANCE
@@ -698,6 +1029,9 @@ static STATE_POSTLOAD( stream_postload )
 	/* recompute the same rate information */
 	recompute_sample_rate_data(machine, stream);
 
+	/* the chip state was just replaced, so let the callback decide again */
+	stream->idle = FALSE;
+
 	/* make sure our output buffers are fully cleared */
 	for (outputnum = 0; outputnum < stream->outputs; outputnum++)
 		memset(stream->output[outputnum].buffer, 0, stream->output_bufalloc * sizeof(stream->output[outputnum].buffer[0]));
@@ -836,12 +1170,23 @@ static void recompute_sample_rate_data(running_machine *machine, sound_stream *s
 static void generate_samples(sound_stream *stream, int samples)
 {
 	int inputnum, outputnum;
+	osd_ticks_t start;
 
 	/* if we're already there, skip it */
 	if (samples <= 0)
 		return;
 
 	VPRINTF(("generate_samples(%p, %d)\n", stream, samples));
+	stream->total_samples += samples;
+
+	/* an idle stream just produces silence */
+	if (stream->idle)
+	{
+		for (outputnum = 0; outputnum < stream->outputs; outputnum++)
+			memset(stream->output[outputnum].buffer + (stream->output_sampindex - stream->output_base_sampindex), 0, samples * sizeof(stream_sample_t));
+		stream->idle_samples += samples;
+		return;
+	}
 
 	/* ensure all inputs are up to date and generate resampled data */
 	for (inputnum = 0; inputnum < stream->inputs; inputnum++)
@@ -853,7 +1198,9 @@ static void generate_samples(sound_stream *stream, int samples)
 			stream_update(input->source->owner);
 
 		/* generate the resampled data */
+		start = osd_ticks();
 		stream->input_array[inputnum] = generate_resampled_data(input, samples);
+		stream->resample_ticks += osd_ticks() - start;
 	}
 
 	/* loop over all outputs and compute the output pointer */
@@ -865,7 +1212,10 @@ static void generate_samples(sound_stream *stream, int samples)
 
 	/* run the callback */
 	VPRINTF(("  callback(%p, %d)\n", stream, samples));
+	start = osd_ticks();
 	(*stream->callback)(stream->device, stream->param, stream->input_array, stream->output_array, samples);
+	stream->callback_ticks += osd_ticks() - start;
+	stream->callback_calls++;
 	VPRINTF(("  callback done\n"));
 }
 
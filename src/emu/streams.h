@@ -13,6 +13,7 @@
 #define STREAMS_H
 
 #include "mamecore.h"
+#include "osdcore.h"
 
 
 /***************************************************************************
@@ -35,6 +36,22 @@ typedef void (*stream_update_func)(const device_config *device, void *param, str
 #define STREAM_UPDATE(name) void name(const device_config *device, void *param, stream_sample_t **inputs, stream_sample_t **outputs, int samples)
 
 
+/* timing counters accumulated by a stream since it was created */
+typedef struct _stream_profile stream_profile;
+struct _stream_profile
+{
+	const device_config *device;				/* owning device */
+	int					index;					/* index of the stream */
+	int					level;					/* 0 for streams with no sources, else 1 + deepest source */
+	int					sample_rate;			/* current sample rate */
+	osd_ticks_t			callback_ticks;			/* total ticks spent in the callback */
+	osd_ticks_t			resample_ticks;			/* total ticks spent resampling the inputs */
+	UINT32				callback_calls;			/* number of callbacks made */
+	UINT64				total_samples;			/* total samples generated */
+	UINT64				idle_samples;			/* total samples filled with silence while idle */
+};
+
+
 
 /***************************************************************************
     FUNCTION PROTOTYPES
@@ -49,6 +66,9 @@ void streams_init(running_machine *machine);
 /* update all the streams periodically */
 void streams_update(running_machine *machine);
 
+/* bring the independent leaf streams up to date ahead of the speaker mix */
+void streams_update_leaves(running_machine *machine);
+
 
 
 /* ----- stream configuration and setup ----- */
@@ -71,6 +91,15 @@ void stream_update(sound_stream *stream);
 /* return a pointer to the output buffer and the number of samples since the last global update */
 const stream_sample_t *stream_get_output_since_last_update(sound_stream *stream, int outputnum, int *numsamples);
 
+/* from within a callback, report that the stream will produce silence until it is woken */
+void stream_set_idle(sound_stream *stream);
+
+/* bring an idle stream up to date and resume calling its callback */
+void stream_wake(sound_stream *stream);
+
+/* allow a stream whose callback touches only its own chip to be updated on a worker thread */
+void stream_set_thread_safe(sound_stream *stream);
+
 
 
 /* ----- stream timing ----- */
@@ -109,5 +138,8 @@ void stream_set_input_gain(sound_stream *stream, int input, float gain);
 /* set the output gain on a given stream */
 void stream_set_output_gain(sound_stream *stream, int output, float gain);
 
+/* fetch the timing counters of the nth stream; returns FALSE past the last one */
+int stream_get_profile(running_machine *machine, int index, stream_profile *profile);
+
 
 #endif
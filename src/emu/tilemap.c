@@ -14,6 +14,18 @@
 #include "profiler.h"
 
 
+/***************************************************************************
+    DEBUGGING
+***************************************************************************/
+
+/* keep statistics */
+#define KEEP_STATISTICS					0
+
+/* force a full invalidation of every tilemap once per frame */
+#define TILEMAP_BENCHMARK				0
+
+
+
 /***************************************************************************
     CONSTANTS
 ***************************************************************************/
@@ -27,6 +39,12 @@
 /* maximum index in each array */
 #define MAX_PEN_TO_FLAGS				256
 
+/* minimum number of dirty tiles before a batch is handed to the work queue */
+#define MIN_TILES_PER_WORK_ITEM			64
+
+/* maximum number of row ranges a batch is split into */
+#define MAX_BATCH_RANGES				16
+
 
 /***************************************************************************
     TYPE DEFINITIONS
@@ -45,23 +63,77 @@ typedef enum
 } trans_t;
 
 
+/* destination formats the rasterizers are specialized for */
+enum
+{
+	BLIT_FORMAT_NULL = 0,
+	BLIT_FORMAT_IND16,
+	BLIT_FORMAT_RGB16,
+	BLIT_FORMAT_RGB16_ALPHA,
+	BLIT_FORMAT_RGB32,
+	BLIT_FORMAT_RGB32_ALPHA,
+	BLIT_FORMAT_COUNT
+};
+
+
 /* internal blitting callbacks */
+typedef struct _blit_parameters blit_parameters;
 typedef void (*blitmask_func)(void *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha);
 typedef void (*blitopaque_func)(void *dest, const UINT16 *source, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha);
+typedef void (*blitroz_func)(tilemap *tmap, const blit_parameters *blit, UINT32 startx, UINT32 starty, int incxx, int incxy, int incyx, int incyy, int wraparound);
+
+
+/* a set of rasterizers specialized for one format and priority combination */
+typedef struct _blit_rasterizers blit_rasterizers;
+struct _blit_rasterizers
+{
+	const char *		name;
+	blitmask_func 		draw_masked;
+	blitopaque_func		draw_opaque;
+	blitroz_func		draw_roz;
+};
 
 
 /* blitting parameters for rendering */
-typedef struct _blit_parameters blit_parameters;
 struct _blit_parameters
 {
 	bitmap_t *			bitmap;
 	rectangle			cliprect;
 	blitmask_func 		draw_masked;
 	blitopaque_func		draw_opaque;
+	blitroz_func		draw_roz;
 	UINT32 				tilemap_priority_code;
 	UINT8				mask;
 	UINT8				value;
 	UINT8				alpha;
+	UINT8				format;
+	UINT8				dopri;
+};
+
+
+/* a single dirty tile, captured on the calling thread for deferred rendering */
+typedef struct _tile_batch_entry tile_batch_entry;
+struct _tile_batch_entry
+{
+	const UINT8 *		pen_data;			/* pointer to the tile's pen data */
+	const UINT8 *		mask_data;			/* pointer to the tile's mask data, or NULL; only valid until the next get_info */
+	tilemap_logical_index logindex;			/* logical index of the tile */
+	UINT32				x0, y0;				/* upper-left pixel of the tile within the pixmap */
+	UINT32				palette_base;		/* palette base for the tile */
+	UINT8				category;			/* tile category */
+	UINT8				group;				/* tile group */
+	UINT8				flags;				/* flags, with the global flip applied */
+	UINT8				pen_mask;			/* pen mask */
+};
+
+
+/* a contiguous run of batch entries covering whole tile rows, rendered by one work item */
+typedef struct _tile_batch_range tile_batch_range;
+struct _tile_batch_range
+{
+	tilemap *			tmap;				/* owning tilemap */
+	const tile_batch_entry *entry;			/* first entry in the range */
+	UINT32				count;				/* number of entries in the range */
 };
 
 
@@ -118,6 +190,14 @@ struct _tilemap
 	bitmap_t *					flagsmap;			/* per-pixel flags */
 	UINT8 *						tileflags;			/* per-tile flags */
 	UINT8 *						pen_to_flags; 		/* mapping of pens to flags */
+
+	/* batched tile updates */
+	UINT8 *						rowdirty;			/* per-row summary: non-zero if any tile in the row may be dirty */
+	tile_batch_entry *			batch;				/* dirty tiles captured for a batched update */
+
+#if TILEMAP_BENCHMARK
+	UINT64						bench_frame;		/* last frame we forced an invalidation on */
+#endif
 };
 
 
@@ -126,6 +206,17 @@ struct _tilemap_private
 	tilemap *		list;
 	tilemap **		tailptr;
 	int				instance;
+	osd_work_queue *work_queue;
+
+#if KEEP_STATISTICS
+	UINT32			tiles_updated;		/* total tiles rendered */
+	UINT32			tiles_threaded;		/* tiles rendered via the work queue */
+	UINT32			rows_skipped;		/* clean rows skipped by the row summary */
+	UINT32			batches;			/* batches rendered */
+	UINT32			threaded_batches;	/* batches handed to the work queue */
+	UINT32			draw_hits[BLIT_FORMAT_COUNT][2]; /* draws per rasterizer specialization */
+	UINT32			roz_hits[BLIT_FORMAT_COUNT][2]; /* roz draws per rasterizer specialization */
+#endif
 };
 
 
@@ -146,28 +237,18 @@ static void mappings_update(tilemap *tmap);
 /* tile rendering */
 static void pixmap_update(tilemap *tmap, const rectangle *cliprect);
 static void tile_update(tilemap *tmap, tilemap_logical_index logindex, UINT32 cached_col, UINT32 cached_row);
+static void tile_capture(tilemap *tmap, tile_batch_entry *entry, tilemap_logical_index logindex, UINT32 col, UINT32 row);
+static void tile_render(tilemap *tmap, const tile_batch_entry *entry);
+static void batch_render(tilemap *tmap, UINT32 count);
+static void *batch_range_callback(void *param, int threadid);
 static UINT8 tile_draw(tilemap *tmap, const UINT8 *pendata, UINT32 x0, UINT32 y0, UINT32 palette_base, UINT8 category, UINT8 group, UINT8 flags, UINT8 pen_mask);
 static UINT8 tile_apply_bitmask(tilemap *tmap, const UINT8 *maskdata, UINT32 x0, UINT32 y0, UINT8 category, UINT8 flags);
 
 /* drawing helpers */
 static void configure_blit_parameters(blit_parameters *blit, tilemap *tmap, bitmap_t *dest, const rectangle *cliprect, UINT32 flags, UINT8 priority, UINT8 priority_mask);
 static void tilemap_draw_instance(tilemap *tmap, const blit_parameters *blit, int xpos, int ypos);
-static void tilemap_draw_roz_core(tilemap *tmap, const blit_parameters *blit,
-		UINT32 startx, UINT32 starty, int incxx, int incxy, int incyx, int incyy, int wraparound);
-
-/* scanline rasterizers for drawing to the pixmap */
-static void scanline_draw_opaque_null(void *dest, const UINT16 *source, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha);
-static void scanline_draw_masked_null(void *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha);
-static void scanline_draw_opaque_ind16(void *dest, const UINT16 *source, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha);
-static void scanline_draw_masked_ind16(void *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha);
-static void scanline_draw_opaque_rgb16(void *dest, const UINT16 *source, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha);
-static void scanline_draw_masked_rgb16(void *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha);
-static void scanline_draw_opaque_rgb16_alpha(void *dest, const UINT16 *source, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha);
-static void scanline_draw_masked_rgb16_alpha(void *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha);
-static void scanline_draw_opaque_rgb32(void *dest, const UINT16 *source, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha);
-static void scanline_draw_masked_rgb32(void *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha);
-static void scanline_draw_opaque_rgb32_alpha(void *dest, const UINT16 *source, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha);
-static void scanline_draw_masked_rgb32_alpha(void *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha);
+/* scanline rasterizers for drawing to the pixmap, indexed by format and priority */
+static const blit_rasterizers rasterizer_table[BLIT_FORMAT_COUNT][2];
 
 
 
@@ -233,6 +314,38 @@ INLINE INT32 effective_colscroll(tilemap *tmap, int index, UINT32 screen_height)
 }
 
 
+/*-------------------------------------------------
+    blit_pixel - write a single pixel to the
+    destination in the given format
+-------------------------------------------------*/
+
+INLINE void blit_pixel(void *dest, int index, UINT16 srcpix, const pen_t *clut, int pal, UINT8 alpha, const int format)
+{
+	switch (format)
+	{
+		case BLIT_FORMAT_IND16:
+			((UINT16 *)dest)[index] = srcpix + pal;
+			break;
+
+		case BLIT_FORMAT_RGB16:
+			((UINT16 *)dest)[index] = clut[srcpix];
+			break;
+
+		case BLIT_FORMAT_RGB16_ALPHA:
+			((UINT16 *)dest)[index] = alpha_blend_r16(((UINT16 *)dest)[index], clut[srcpix], alpha);
+			break;
+
+		case BLIT_FORMAT_RGB32:
+			((UINT32 *)dest)[index] = clut[srcpix];
+			break;
+
+		case BLIT_FORMAT_RGB32_ALPHA:
+			((UINT32 *)dest)[index] = alpha_blend_r32(((UINT32 *)dest)[index], clut[srcpix], alpha);
+			break;
+	}
+}
+
+
 /*-------------------------------------------------
     indexed_tilemap - return a tilemap by index
 -------------------------------------------------*/
@@ -275,6 +388,42 @@ INLINE int gfx_elements_changed(tilemap *tmap)
 }
 
 
+/*-------------------------------------------------
+    expand_all_dirty - if the whole tilemap is
+    marked dirty, expand that into the per-tile
+    flags and per-row summary
+-------------------------------------------------*/
+
+INLINE void expand_all_dirty(tilemap *tmap)
+{
+	if (tmap->all_tiles_dirty || gfx_elements_changed(tmap))
+	{
+		memset(tmap->tileflags, TILE_FLAG_DIRTY, tmap->max_logical_index);
+		memset(tmap->rowdirty, 1, tmap->rows);
+		tmap->all_tiles_dirty = FALSE;
+		tmap->gfx_used = 0;
+	}
+}
+
+
+/*-------------------------------------------------
+    benchmark_invalidate - when benchmarking,
+    invalidate the whole tilemap once per frame
+-------------------------------------------------*/
+
+INLINE void benchmark_invalidate(tilemap *tmap)
+{
+#if TILEMAP_BENCHMARK
+	UINT64 frame = video_screen_get_frame_number(tmap->machine->primary_screen);
+	if (frame != tmap->bench_frame)
+	{
+		tmap->bench_frame = frame;
+		tilemap_mark_all_tiles_dirty(tmap);
+	}
+#endif
+}
+
+
 /***************************************************************************
     SYSTEM-WIDE MANAGEMENT
 ***************************************************************************/
@@ -299,6 +448,7 @@ void tilemap_init(running_machine *machine)
 		machine->tilemap_data->tailptr = &machine->tilemap_data->list;
 
 		machine->priority_bitmap = auto_bitmap_alloc(machine, screen_width, screen_height, BITMAP_FORMAT_INDEXED8);
+		machine->tilemap_data->work_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
 		add_exit_callback(machine, tilemap_exit);
 	}
 }
@@ -357,6 +507,8 @@ tilemap *tilemap_create(running_machine *machine, tile_get_info_func tile_get_in
 
 	/* allocate transparency mapping data */
 	tmap->tileflags = alloc_array_or_die(UINT8, tmap->max_logical_index);
+	tmap->rowdirty = alloc_array_clear_or_die(UINT8, tmap->rows);
+	tmap->batch = alloc_array_or_die(tile_batch_entry, tmap->max_logical_index);
 	tmap->flagsmap = bitmap_alloc(tmap->width, tmap->height, BITMAP_FORMAT_INDEXED8);
 	tmap->pen_to_flags = alloc_array_clear_or_die(UINT8, MAX_PEN_TO_FLAGS * TILEMAP_NUM_GROUPS);
 	for (group = 0; group < TILEMAP_NUM_GROUPS; group++)
@@ -472,6 +624,7 @@ void tilemap_mark_tile_dirty(tilemap *tmap, tilemap_memory_index memindex)
 		if (logindex != INVALID_LOGICAL_INDEX)
 		{
 			tmap->tileflags[logindex] = TILE_FLAG_DIRTY;
+			tmap->rowdirty[logindex / tmap->cols] = 1;
 			tmap->all_tiles_clean = FALSE;
 		}
 	}
@@ -786,12 +939,12 @@ profiler_mark_start(PROFILER_TILEMAP_DRAW);
 	configure_blit_parameters(&blit, tmap, dest, cliprect, flags, priority, priority_mask);
 
 	/* if the whole map is dirty, mark it as such */
-	if (tmap->all_tiles_dirty || gfx_elements_changed(tmap))
-	{
-		memset(tmap->tileflags, TILE_FLAG_DIRTY, tmap->max_logical_index);
-		tmap->all_tiles_dirty = FALSE;
-		tmap->gfx_used = 0;
-	}
+	benchmark_invalidate(tmap);
+	expand_all_dirty(tmap);
+
+#if KEEP_STATISTICS
+	tmap->machine->tilemap_data->draw_hits[blit.format][blit.dopri]++;
+#endif
 
 	width  = video_screen_get_width(tmap->machine->primary_screen);
 	height = video_screen_get_height(tmap->machine->primary_screen);
@@ -920,14 +1073,20 @@ void tilemap_draw_roz_primask(bitmap_t *dest, const rectangle *cliprect, tilemap
 	}
 
 profiler_mark_start(PROFILER_TILEMAP_DRAW_ROZ);
+	benchmark_invalidate(tmap);
+
 	/* configure the blit parameters */
 	configure_blit_parameters(&blit, tmap, dest, cliprect, flags, priority, priority_mask);
 
 	/* get the full pixmap for the tilemap */
 	tilemap_get_pixmap(tmap);
 
+#if KEEP_STATISTICS
+	tmap->machine->tilemap_data->roz_hits[blit.format][blit.dopri]++;
+#endif
+
 	/* then do the roz copy */
-	tilemap_draw_roz_core(tmap, &blit, startx, starty, incxx, incxy, incyx, incyy, wraparound);
+	(*blit.draw_roz)(tmap, &blit, startx, starty, incxx, incxy, incyx, incyy, wraparound);
 profiler_mark_end();
 }
 
@@ -986,12 +1145,7 @@ void tilemap_draw_by_index(running_machine *machine, bitmap_t *dest, int number,
 	scrolly = tmap->height - scrolly % tmap->height;
 
 	/* if the whole map is dirty, mark it as such */
-	if (tmap->all_tiles_dirty || gfx_elements_changed(tmap))
-	{
-		memset(tmap->tileflags, TILE_FLAG_DIRTY, tmap->max_logical_index);
-		tmap->all_tiles_dirty = FALSE;
-		tmap->gfx_used = 0;
-	}
+	expand_all_dirty(tmap);
 
 	/* iterate to handle wraparound */
 	for (ypos = scrolly - tmap->height; ypos <= blit.cliprect.max_y; ypos += tmap->height)
@@ -1077,6 +1231,21 @@ static void tilemap_exit(running_machine *machine)
 {
 	tilemap_private *tilemap_data = machine->tilemap_data;
 
+#if KEEP_STATISTICS
+	printf("Tiles updated    = %d (%d via work queue)\n", tilemap_data->tiles_updated, tilemap_data->tiles_threaded);
+	printf("Batches          = %d (%d via work queue)\n", tilemap_data->batches, tilemap_data->threaded_batches);
+	printf("Clean rows skipped = %d\n", tilemap_data->rows_skipped);
+{
+	int format, dopri;
+	printf("Rasterizers used by %s:\n", machine->gamedrv->name);
+	for (format = 0; format < BLIT_FORMAT_COUNT; format++)
+		for (dopri = 0; dopri < 2; dopri++)
+			if (tilemap_data->draw_hits[format][dopri] != 0 || tilemap_data->roz_hits[format][dopri] != 0)
+				printf("  %-11s %-6s %9d draws, %9d roz draws\n", rasterizer_table[format][dopri].name, dopri ? "pri" : "no pri",
+						tilemap_data->draw_hits[format][dopri], tilemap_data->roz_hits[format][dopri]);
+}
+#endif
+
 	/* free all the tilemaps in the list */
 	while (tilemap_data->list != NULL)
 	{
@@ -1085,6 +1254,11 @@ static void tilemap_exit(running_machine *machine)
 		tilemap_data->list = next;
 	}
 	tilemap_data->tailptr = &tilemap_data->list;
+
+	/* free the work queue */
+	if (tilemap_data->work_queue != NULL)
+		osd_work_queue_free(tilemap_data->work_queue);
+	tilemap_data->work_queue = NULL;
 }
 
 
@@ -1118,6 +1292,8 @@ static void tilemap_dispose(tilemap *tmap)
 		}
 
 	/* free allocated memory */
+	free(tmap->batch);
+	free(tmap->rowdirty);
 	free(tmap->pen_to_flags);
 	free(tmap->tileflags);
 	bitmap_free(tmap->flagsmap);
@@ -1218,6 +1394,8 @@ static void mappings_update(tilemap *tmap)
 static void pixmap_update(tilemap *tmap, const rectangle *cliprect)
 {
 	int mincol, maxcol, minrow, maxrow;
+	int fullwidth;
+	UINT32 count = 0;
 	int row, col;
 
 	/* if the graphics changed, we need to mark everything dirty */
@@ -1228,7 +1406,7 @@ static void pixmap_update(tilemap *tmap, const rectangle *cliprect)
 	if (tmap->all_tiles_clean)
 		return;
 
-profiler_mark_start(PROFILER_TILEMAP_DRAW);
+profiler_mark_start(PROFILER_TILEMAP_UPDATE);
 
 	/* compute which columns and rows to update */
 	if (cliprect != NULL)
@@ -1244,61 +1422,188 @@ profiler_mark_start(PROFILER_TILEMAP_DRAW);
 		maxcol = tmap->cols - 1;
 		maxrow = tmap->rows - 1;
 	}
+	fullwidth = (mincol == 0 && maxcol == tmap->cols - 1);
 
 	/* if the whole map is dirty, mark it as such */
 	if (tmap->all_tiles_dirty)
 	{
 		memset(tmap->tileflags, TILE_FLAG_DIRTY, tmap->max_logical_index);
+		memset(tmap->rowdirty, 1, tmap->rows);
 		tmap->all_tiles_dirty = FALSE;
 		tmap->gfx_used = 0;
 	}
 
-	/* iterate over rows */
+	/* iterate over rows, capturing the dirty tiles; tile_get_info callbacks */
+	/* are not thread-safe, so this part always happens on our thread */
 	for (row = minrow; row <= maxrow; row++)
 	{
 		tilemap_logical_index logindex = row * tmap->cols;
 
+		/* skip rows that the summary says are clean */
+		if (!tmap->rowdirty[row])
+		{
+#if KEEP_STATISTICS
+			tmap->machine->tilemap_data->rows_skipped++;
+#endif
+			continue;
+		}
+
 		/* iterate over colums */
 		for (col = mincol; col <= maxcol; col++)
 			if (tmap->tileflags[logindex + col] == TILE_FLAG_DIRTY)
-				tile_update(tmap, logindex + col, col, row);
+			{
+				tile_capture(tmap, &tmap->batch[count], logindex + col, col, row);
+
+				/* mask data may live in a buffer that get_info reuses for every */
+				/* tile (namcona1 does this), so masked tiles are drawn right away */
+				if (tmap->batch[count].mask_data != NULL)
+				{
+					tile_render(tmap, &tmap->batch[count]);
+					continue;
+				}
+				count++;
+
+				/* pooled gfx can only keep so many tiles decoded; render before */
+				/* further captures could evict the pen data we are holding */
+				if (count == GFX_POOL_MIN_SLOTS)
+				{
+					batch_render(tmap, count);
+					count = 0;
+				}
+			}
+
+		/* if we covered the whole row, it is now clean */
+		if (fullwidth)
+			tmap->rowdirty[row] = 0;
 	}
 
+	/* render everything we captured */
+	if (count > 0)
+		batch_render(tmap, count);
+
 	/* mark it all clean */
-	if (mincol == 0 && minrow == 0 && maxcol == tmap->cols - 1 && maxcol == tmap->rows - 1)
+	if (fullwidth && minrow == 0 && maxrow == tmap->rows - 1)
 		tmap->all_tiles_clean = TRUE;
 
 profiler_mark_end();
 }
 
 
+/*-------------------------------------------------
+    batch_render - render a batch of captured
+    tiles, fanning it out across the work queue
+    by row ranges if it is large enough
+-------------------------------------------------*/
+
+static void batch_render(tilemap *tmap, UINT32 count)
+{
+	tilemap_private *tilemap_data = tmap->machine->tilemap_data;
+	tile_batch_range range[MAX_BATCH_RANGES];
+	UINT32 numranges, rangenum, start;
+
+#if KEEP_STATISTICS
+	tilemap_data->tiles_updated += count;
+	tilemap_data->batches++;
+#endif
+
+	/* small batches are cheaper to do directly */
+	if (tilemap_data->work_queue == NULL || count < 2 * MIN_TILES_PER_WORK_ITEM)
+	{
+		UINT32 entrynum;
+		for (entrynum = 0; entrynum < count; entrynum++)
+			tile_render(tmap, &tmap->batch[entrynum]);
+		return;
+	}
+
+	/* split the batch into ranges of roughly equal size, breaking only between */
+	/* rows so that each work item owns whole rows of the pixmap and flagsmap */
+	numranges = MIN(count / MIN_TILES_PER_WORK_ITEM, MAX_BATCH_RANGES);
+	for (rangenum = start = 0; rangenum < numranges && start < count; rangenum++)
+	{
+		UINT32 end = (rangenum == numranges - 1) ? count : start + (count - start) / (numranges - rangenum);
+
+		/* extend the range to the end of the current row */
+		while (end < count && end > start && tmap->batch[end].y0 == tmap->batch[end - 1].y0)
+			end++;
+
+		range[rangenum].tmap = tmap;
+		range[rangenum].entry = &tmap->batch[start];
+		range[rangenum].count = end - start;
+		start = end;
+	}
+	numranges = rangenum;
+
+	/* queue the ranges and wait for them to complete */
+	osd_work_item_queue_multiple(tilemap_data->work_queue, batch_range_callback, numranges, range, sizeof(range[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+	osd_work_queue_wait(tilemap_data->work_queue, osd_ticks_per_second() * 10);
+
+#if KEEP_STATISTICS
+	tilemap_data->tiles_threaded += count;
+	tilemap_data->threaded_batches++;
+#endif
+}
+
+
+/*-------------------------------------------------
+    batch_range_callback - work queue callback to
+    render a range of captured tiles
+-------------------------------------------------*/
+
+static void *batch_range_callback(void *param, int threadid)
+{
+	const tile_batch_range *range = (const tile_batch_range *)param;
+	UINT32 entrynum;
+
+	for (entrynum = 0; entrynum < range->count; entrynum++)
+		tile_render(range->tmap, &range->entry[entrynum]);
+	return NULL;
+}
+
+
 /*-------------------------------------------------
     tile_update - update a single dirty tile
 -------------------------------------------------*/
 
 static void tile_update(tilemap *tmap, tilemap_logical_index logindex, UINT32 col, UINT32 row)
 {
-	UINT32 x0 = tmap->tilewidth * col;
-	UINT32 y0 = tmap->tileheight * row;
-	tilemap_memory_index memindex;
-	UINT32 flags;
+	tile_batch_entry entry;
 
 profiler_mark_start(PROFILER_TILEMAP_UPDATE);
 
+	tile_capture(tmap, &entry, logindex, col, row);
+	tile_render(tmap, &entry);
+
+profiler_mark_end();
+}
+
+
+/*-------------------------------------------------
+    tile_capture - fetch the information for a
+    single dirty tile and record what is needed
+    to render it later
+-------------------------------------------------*/
+
+static void tile_capture(tilemap *tmap, tile_batch_entry *entry, tilemap_logical_index logindex, UINT32 col, UINT32 row)
+{
+	tilemap_memory_index memindex;
+
 	/* call the get info callback for the associated memory index */
 	memindex = tmap->logical_to_memory[logindex];
 	(*tmap->tile_get_info)(tmap->machine, &tmap->tileinfo, memindex, tmap->user_data);
 
-	/* apply the global tilemap flip to the returned flip flags */
-	flags = tmap->tileinfo.flags ^ (tmap->attributes & 0x03);
+	/* record everything we need to draw it */
+	entry->pen_data = tmap->tileinfo.pen_data + tmap->pen_data_offset;
+	entry->mask_data = tmap->tileinfo.mask_data;
+	entry->logindex = logindex;
+	entry->x0 = tmap->tilewidth * col;
+	entry->y0 = tmap->tileheight * row;
+	entry->palette_base = tmap->tileinfo.palette_base;
+	entry->category = tmap->tileinfo.category;
+	entry->group = tmap->tileinfo.group;
+	entry->pen_mask = tmap->tileinfo.pen_mask;
 
-	/* draw the tile, using either direct or transparent */
-	tmap->tileflags[logindex] = tile_draw(tmap, tmap->tileinfo.pen_data + tmap->pen_data_offset, x0, y0,
-		tmap->tileinfo.palette_base, tmap->tileinfo.category, tmap->tileinfo.group, flags, tmap->tileinfo.pen_mask);
-
-	/* if mask data is specified, apply it */
-	if ((flags & (TILE_FORCE_LAYER0 | TILE_FORCE_LAYER1 | TILE_FORCE_LAYER2)) == 0 && tmap->tileinfo.mask_data != NULL)
-		tmap->tileflags[logindex] = tile_apply_bitmask(tmap, tmap->tileinfo.mask_data, x0, y0, tmap->tileinfo.category, flags);
+	/* apply the global tilemap flip to the returned flip flags */
+	entry->flags = tmap->tileinfo.flags ^ (tmap->attributes & 0x03);
 
 	/* track which gfx have been used for this tilemap */
 	if (tmap->tileinfo.gfxnum != 0xff && (tmap->gfx_used & (1 << tmap->tileinfo.gfxnum)) == 0)
@@ -1306,8 +1611,25 @@ profiler_mark_start(PROFILER_TILEMAP_UPDATE);
 		tmap->gfx_used |= 1 << tmap->tileinfo.gfxnum;
 		tmap->gfx_dirtyseq[tmap->tileinfo.gfxnum] = tmap->machine->gfx[tmap->tileinfo.gfxnum]->dirtyseq;
 	}
+}
 
-profiler_mark_end();
+
+/*-------------------------------------------------
+    tile_render - draw a captured tile into the
+    pixmap and flagsmap; this touches only the
+    tile's own pixels and flags, so it may be
+    called from any thread
+-------------------------------------------------*/
+
+static void tile_render(tilemap *tmap, const tile_batch_entry *entry)
+{
+	/* draw the tile, using either direct or transparent */
+	tmap->tileflags[entry->logindex] = tile_draw(tmap, entry->pen_data, entry->x0, entry->y0,
+		entry->palette_base, entry->category, entry->group, entry->flags, entry->pen_mask);
+
+	/* if mask data is specified, apply it */
+	if ((entry->flags & (TILE_FORCE_LAYER0 | TILE_FORCE_LAYER1 | TILE_FORCE_LAYER2)) == 0 && entry->mask_data != NULL)
+		tmap->tileflags[entry->logindex] = tile_apply_bitmask(tmap, entry->mask_data, entry->x0, entry->y0, entry->category, entry->flags);
 }
 
 
@@ -1502,10 +1824,7 @@ static void configure_blit_parameters(blit_parameters *blit, tilemap *tmap, bitm
 
 	/* if no destination, just render priority */
 	if (dest == NULL)
-	{
-		blit->draw_masked = scanline_draw_masked_null;
-		blit->draw_opaque = scanline_draw_opaque_null;
-	}
+		blit->format = BLIT_FORMAT_NULL;
 
 	/* otherwise get the appropriate callbacks for the format and flags */
 	else
@@ -1513,18 +1832,15 @@ static void configure_blit_parameters(blit_parameters *blit, tilemap *tmap, bitm
 		switch (dest->format)
 		{
 			case BITMAP_FORMAT_RGB32:
-				blit->draw_masked = (blit->alpha < 0xff) ? scanline_draw_masked_rgb32_alpha : scanline_draw_masked_rgb32;
-				blit->draw_opaque = (blit->alpha < 0xff) ? scanline_draw_opaque_rgb32_alpha : scanline_draw_opaque_rgb32;
+				blit->format = (blit->alpha < 0xff) ? BLIT_FORMAT_RGB32_ALPHA : BLIT_FORMAT_RGB32;
 				break;
 
 			case BITMAP_FORMAT_RGB15:
-				blit->draw_masked = (blit->alpha < 0xff) ? scanline_draw_masked_rgb16_alpha : scanline_draw_masked_rgb16;
-				blit->draw_opaque = (blit->alpha < 0xff) ? scanline_draw_opaque_rgb16_alpha : scanline_draw_opaque_rgb16;
+				blit->format = (blit->alpha < 0xff) ? BLIT_FORMAT_RGB16_ALPHA : BLIT_FORMAT_RGB16;
 				break;
 
 			case BITMAP_FORMAT_INDEXED16:
-				blit->draw_masked = scanline_draw_masked_ind16;
-				blit->draw_opaque = scanline_draw_opaque_ind16;
+				blit->format = BLIT_FORMAT_IND16;
 				break;
 
 			default:
@@ -1533,6 +1849,12 @@ static void configure_blit_parameters(blit_parameters *blit, tilemap *tmap, bitm
 		}
 	}
 
+	/* pick the rasterizers specialized for this format and for whether we touch priority */
+	blit->dopri = ((blit->tilemap_priority_code & 0xffff) != 0xff00);
+	blit->draw_masked = rasterizer_table[blit->format][blit->dopri].draw_masked;
+	blit->draw_opaque = rasterizer_table[blit->format][blit->dopri].draw_opaque;
+	blit->draw_roz = rasterizer_table[blit->format][blit->dopri].draw_roz;
+
 	/* tile priority; unless otherwise specified, draw anything in layer 0 */
 	blit->mask = TILEMAP_PIXEL_CATEGORY_MASK;
 	blit->value	= flags & TILEMAP_PIXEL_CATEGORY_MASK;
@@ -1607,6 +1929,17 @@ static void tilemap_draw_instance(tilemap *tmap, const blit_parameters *blit, in
 	x2 -= xpos;
 	y2 -= ypos;
 
+	/* bring all the dirty tiles in the area we are about to draw up to date in one batch */
+	if (!tmap->all_tiles_clean)
+	{
+		rectangle area;
+		area.min_x = x1;
+		area.max_x = x2 - 1;
+		area.min_y = y1;
+		area.max_y = y2 - 1;
+		pixmap_update(tmap, &area);
+	}
+
 	/* get tilemap pixels */
 	source_baseaddr = BITMAP_ADDR16(tmap->pixmap, y1, 0);
 	mask_baseaddr = BITMAP_ADDR8(tmap->flagsmap, y1, 0);
@@ -1728,25 +2061,13 @@ static void tilemap_draw_instance(tilemap *tmap, const blit_parameters *blit, in
 /*-------------------------------------------------
     tilemap_draw_roz_core - render the tilemap's
     pixmap to the destination with rotation
-    and zoom
+    and zoom; format is always a constant, so
+    each of the wrappers below gets its own
+    copy with the pixel writer folded in
 -------------------------------------------------*/
 
-#define ROZ_PLOT_PIXEL(INPUT_VAL)											\
-do {																		\
-	if (blit->draw_masked == scanline_draw_masked_ind16)					\
-		*(UINT16 *)dest = (INPUT_VAL) + (priority >> 16);					\
-	else if (blit->draw_masked == scanline_draw_masked_rgb32)				\
-		*(UINT32 *)dest = clut[INPUT_VAL];									\
-	else if (blit->draw_masked == scanline_draw_masked_rgb16)				\
-		*(UINT16 *)dest = clut[INPUT_VAL];									\
-	else if (blit->draw_masked == scanline_draw_masked_rgb32_alpha)			\
-		*(UINT32 *)dest = alpha_blend_r32(*(UINT32 *)dest, clut[INPUT_VAL], alpha);	\
-	else if (blit->draw_masked == scanline_draw_masked_rgb16_alpha)			\
-		*(UINT16 *)dest = alpha_blend_r16(*(UINT16 *)dest, clut[INPUT_VAL], alpha);	\
-} while (0)
-
-static void tilemap_draw_roz_core(tilemap *tmap, const blit_parameters *blit,
-		UINT32 startx, UINT32 starty, int incxx, int incxy, int incyx, int incyy, int wraparound)
+INLINE void tilemap_draw_roz_core(tilemap *tmap, const blit_parameters *blit,
+		UINT32 startx, UINT32 starty, int incxx, int incxy, int incyx, int incyy, int wraparound, const int format)
 {
 	const pen_t *clut = &tmap->machine->pens[blit->tilemap_priority_code >> 16];
 	bitmap_t *priority_bitmap = tmap->machine->priority_bitmap;
@@ -1772,7 +2093,7 @@ static void tilemap_draw_roz_core(tilemap *tmap, const blit_parameters *blit,
 	UINT8 *pri;
 	const UINT16 *src;
 	const UINT8 *maskptr;
-	int destadvance = destbitmap->bpp / 8;
+	int destadvance = (format == BLIT_FORMAT_NULL) ? 0 : destbitmap->bpp / 8;
 
 	/* pre-advance based on the cliprect */
 	startx += blit->cliprect.min_x * incxx + blit->cliprect.min_y * incyx;
@@ -1813,7 +2134,7 @@ static void tilemap_draw_roz_core(tilemap *tmap, const blit_parameters *blit,
 				pri = BITMAP_ADDR8(priority_bitmap, sy, sx);
 				src = BITMAP_ADDR16(srcbitmap, cy, 0);
 				maskptr = BITMAP_ADDR8(flagsmap, cy, 0);
-				dest = (UINT8 *)destbitmap->base + (destbitmap->rowpixels * sy + sx) * destadvance;
+				dest = (format == BLIT_FORMAT_NULL) ? NULL : (UINT8 *)destbitmap->base + (destbitmap->rowpixels * sy + sx) * destadvance;
 
 				/* loop over columns */
 				while (x <= ex && cx < widthshifted)
@@ -1821,7 +2142,7 @@ static void tilemap_draw_roz_core(tilemap *tmap, const blit_parameters *blit,
 					/* plot if we match the mask */
 					if ((maskptr[cx >> 16] & mask) == value)
 					{
-						ROZ_PLOT_PIXEL(src[cx >> 16]);
+						blit_pixel(dest, 0, src[cx >> 16], clut, priority >> 16, alpha, format);
 						*pri = (*pri & (priority >> 8)) | priority;
 					}
 
@@ -1851,7 +2172,7 @@ static void tilemap_draw_roz_core(tilemap *tmap, const blit_parameters *blit,
 			cy = starty;
 
 			/* get dest and priority pointers */
-			dest = (UINT8 *)destbitmap->base + (destbitmap->rowpixels * sy + sx) * destadvance;
+			dest = (format == BLIT_FORMAT_NULL) ? NULL : (UINT8 *)destbitmap->base + (destbitmap->rowpixels * sy + sx) * destadvance;
 			pri = BITMAP_ADDR8(priority_bitmap, sy, sx);
 
 			/* loop over columns */
@@ -1860,7 +2181,7 @@ static void tilemap_draw_roz_core(tilemap *tmap, const blit_parameters *blit,
 				/* plot if we match the mask */
 				if ((*BITMAP_ADDR8(flagsmap, (cy >> 16) & ymask, (cx >> 16) & xmask) & mask) == value)
 				{
-					ROZ_PLOT_PIXEL(*BITMAP_ADDR16(srcbitmap, (cy >> 16) & ymask, (cx >> 16) & xmask));
+					blit_pixel(dest, 0, *BITMAP_ADDR16(srcbitmap, (cy >> 16) & ymask, (cx >> 16) & xmask), clut, priority >> 16, alpha, format);
 					*pri = (*pri & (priority >> 8)) | priority;
 				}
 
@@ -1891,7 +2212,7 @@ static void tilemap_draw_roz_core(tilemap *tmap, const blit_parameters *blit,
 			cy = starty;
 
 			/* get dest and priority pointers */
-			dest = (UINT8 *)destbitmap->base + (destbitmap->rowpixels * sy + sx) * destadvance;
+			dest = (format == BLIT_FORMAT_NULL) ? NULL : (UINT8 *)destbitmap->base + (destbitmap->rowpixels * sy + sx) * destadvance;
 			pri = BITMAP_ADDR8(priority_bitmap, sy, sx);
 
 			/* loop over columns */
@@ -1901,7 +2222,7 @@ static void tilemap_draw_roz_core(tilemap *tmap, const blit_parameters *blit,
 				if (cx < widthshifted && cy < heightshifted)
 					if ((*BITMAP_ADDR8(flagsmap, cy >> 16, cx >> 16) & mask) == value)
 					{
-						ROZ_PLOT_PIXEL(*BITMAP_ADDR16(srcbitmap, cy >> 16, cx >> 16));
+						blit_pixel(dest, 0, *BITMAP_ADDR16(srcbitmap, cy >> 16, cx >> 16), clut, priority >> 16, alpha, format);
 						*pri = (*pri & (priority >> 8)) | priority;
 					}
 
@@ -1928,364 +2249,148 @@ static void tilemap_draw_roz_core(tilemap *tmap, const blit_parameters *blit,
 ***************************************************************************/
 
 /*-------------------------------------------------
-    scanline_draw_opaque_null - draw to a NULL
-    bitmap, setting priority only
+    scanline_draw_opaque_core - draw a run of
+    pixels with no mask; format and dopri are
+    always constants so that each specialization
+    compiles down to a branch-free inner loop
 -------------------------------------------------*/
 
-static void scanline_draw_opaque_null(void *dest, const UINT16 *source, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha)
+INLINE void scanline_draw_opaque_core(void *dest, const UINT16 *source, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha, const int format, const int dopri)
 {
-	int i;
-
-	/* skip entirely if not changing priority */
-	if (pcode != 0xff00)
-	{
-		for (i = 0; i < count; i++)
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-	}
-}
-
-
-/*-------------------------------------------------
-    scanline_draw_masked_null - draw to a NULL
-    bitmap using a mask, setting priority only
--------------------------------------------------*/
-
-static void scanline_draw_masked_null(void *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha)
-{
-	int i;
-
-	/* skip entirely if not changing priority */
-	if (pcode != 0xff00)
-	{
-		for (i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-	}
-}
-
-
-
-/*-------------------------------------------------
-    scanline_draw_opaque_ind16 - draw to a 16bpp
-    indexed bitmap
--------------------------------------------------*/
-
-static void scanline_draw_opaque_ind16(void *_dest, const UINT16 *source, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha)
-{
-	UINT16 *dest = (UINT16 *)_dest;
+	const pen_t *clut = &pens[pcode >> 16];
 	int pal = pcode >> 16;
-	int i;
+	int i = 0;
 
-	/* special case for no palette offset */
-	if (pal == 0)
-	{
+	/* special case for no palette offset; the pixels are just a copy */
+	if (format == BLIT_FORMAT_IND16 && pal == 0)
 		memcpy(dest, source, count * 2);
 
-		/* priority if necessary */
-		if (pcode != 0xff00)
-		{
-			for (i = 0; i < count; i++)
-				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-		}
-	}
-
-	/* priority case */
-	else if ((pcode & 0xffff) != 0xff00)
+	/* everything else goes 4 pixels at a time, then mops up the remainder */
+	else if (format != BLIT_FORMAT_NULL)
 	{
-		for (i = 0; i < count; i++)
+		for ( ; i + 4 <= count; i += 4)
 		{
-			dest[i] = source[i] + pal;
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
+			blit_pixel(dest, i + 0, source[i + 0], clut, pal, alpha, format);
+			blit_pixel(dest, i + 1, source[i + 1], clut, pal, alpha, format);
+			blit_pixel(dest, i + 2, source[i + 2], clut, pal, alpha, format);
+			blit_pixel(dest, i + 3, source[i + 3], clut, pal, alpha, format);
 		}
+		for ( ; i < count; i++)
+			blit_pixel(dest, i, source[i], clut, pal, alpha, format);
 	}
 
-	/* no priority case */
-	else
-	{
+	/* priority if necessary */
+	if (dopri)
 		for (i = 0; i < count; i++)
-			dest[i] = source[i] + pal;
-	}
+			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
 }
 
 
 /*-------------------------------------------------
-    scanline_draw_masked_ind16 - draw to a 16bpp
-    indexed bitmap using a mask
+    scanline_draw_masked_core - draw a run of
+    pixels through the flags mask; groups of 4
+    pixels that are all in or all out of the
+    mask skip the per-pixel tests
 -------------------------------------------------*/
 
-static void scanline_draw_masked_ind16(void *_dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha)
+INLINE void scanline_draw_masked_core(void *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha, const int format, const int dopri)
 {
-	UINT16 *dest = (UINT16 *)_dest;
+	const pen_t *clut = &pens[pcode >> 16];
 	int pal = pcode >> 16;
-	int i;
+	int i = 0;
 
-	/* priority case */
-	if ((pcode & 0xffff) != 0xff00)
+	for ( ; i + 4 <= count; i += 4)
 	{
-		for (i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-			{
-				dest[i] = source[i] + pal;
-				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-			}
-	}
+		int hit = (((maskptr[i + 0] & mask) == value) << 0) |
+				  (((maskptr[i + 1] & mask) == value) << 1) |
+				  (((maskptr[i + 2] & mask) == value) << 2) |
+				  (((maskptr[i + 3] & mask) == value) << 3);
 
-	/* no priority case */
-	else
-	{
-		for (i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-				dest[i] = source[i] + pal;
-	}
-}
-
-
-
-/*-------------------------------------------------
-    scanline_draw_opaque_rgb16 - draw to a 16bpp
-    RGB bitmap
--------------------------------------------------*/
-
-static void scanline_draw_opaque_rgb16(void *_dest, const UINT16 *source, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha)
-{
-	const pen_t *clut = &pens[pcode >> 16];
-	UINT16 *dest = (UINT16 *)_dest;
-	int i;
-
-	/* priority case */
-	if ((pcode & 0xffff) != 0xff00)
-	{
-		for (i = 0; i < count; i++)
+		/* all 4 in: draw them unconditionally */
+		if (hit == 0x0f)
 		{
-			dest[i] = clut[source[i]];
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-		}
-	}
-
-	/* no priority case */
-	else
-	{
-		for (i = 0; i < count; i++)
-			dest[i] = clut[source[i]];
-	}
-}
-
-
-/*-------------------------------------------------
-    scanline_draw_masked_rgb16 - draw to a 16bpp
-    RGB bitmap using a mask
--------------------------------------------------*/
-
-static void scanline_draw_masked_rgb16(void *_dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha)
-{
-	const pen_t *clut = &pens[pcode >> 16];
-	UINT16 *dest = (UINT16 *)_dest;
-	int i;
-
-	/* priority case */
-	if ((pcode & 0xffff) != 0xff00)
-	{
-		for (i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
+			if (format != BLIT_FORMAT_NULL)
 			{
-				dest[i] = clut[source[i]];
-				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
+				blit_pixel(dest, i + 0, source[i + 0], clut, pal, alpha, format);
+				blit_pixel(dest, i + 1, source[i + 1], clut, pal, alpha, format);
+				blit_pixel(dest, i + 2, source[i + 2], clut, pal, alpha, format);
+				blit_pixel(dest, i + 3, source[i + 3], clut, pal, alpha, format);
 			}
-	}
-
-	/* no priority case */
-	else
-	{
-		for (i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-				dest[i] = clut[source[i]];
-	}
-}
-
-
-/*-------------------------------------------------
-    scanline_draw_opaque_rgb16_alpha - draw to a
-    16bpp RGB bitmap with alpha blending
--------------------------------------------------*/
-
-static void scanline_draw_opaque_rgb16_alpha(void *_dest, const UINT16 *source, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha)
-{
-	const pen_t *clut = &pens[pcode >> 16];
-	UINT16 *dest = (UINT16 *)_dest;
-	int i;
-
-	/* priority case */
-	if ((pcode & 0xffff) != 0xff00)
-	{
-		for (i = 0; i < count; i++)
-		{
-			dest[i] = alpha_blend_r16(dest[i], clut[source[i]], alpha);
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-		}
-	}
-
-	/* no priority case */
-	else
-	{
-		for (i = 0; i < count; i++)
-			dest[i] = alpha_blend_r16(dest[i], clut[source[i]], alpha);
-	}
-}
-
-
-/*-------------------------------------------------
-    scanline_draw_masked_rgb16_alpha - draw to a
-    16bpp RGB bitmap using a mask and alpha
-    blending
--------------------------------------------------*/
-
-static void scanline_draw_masked_rgb16_alpha(void *_dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha)
-{
-	const pen_t *clut = &pens[pcode >> 16];
-	UINT16 *dest = (UINT16 *)_dest;
-	int i;
-
-	/* priority case */
-	if ((pcode & 0xffff) != 0xff00)
-	{
-		for (i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
+			if (dopri)
 			{
-				dest[i] = alpha_blend_r16(dest[i], clut[source[i]], alpha);
-				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
+				pri[i + 0] = (pri[i + 0] & (pcode >> 8)) | pcode;
+				pri[i + 1] = (pri[i + 1] & (pcode >> 8)) | pcode;
+				pri[i + 2] = (pri[i + 2] & (pcode >> 8)) | pcode;
+				pri[i + 3] = (pri[i + 3] & (pcode >> 8)) | pcode;
 			}
-	}
-
-	/* no priority case */
-	else
-	{
-		for (i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-				dest[i] = alpha_blend_r16(dest[i], clut[source[i]], alpha);
-	}
-}
-
-
-/*-------------------------------------------------
-    scanline_draw_opaque_rgb32 - draw to a 32bpp
-    RGB bitmap
--------------------------------------------------*/
-
-static void scanline_draw_opaque_rgb32(void *_dest, const UINT16 *source, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha)
-{
-	const pen_t *clut = &pens[pcode >> 16];
-	UINT32 *dest = (UINT32 *)_dest;
-	int i;
+		}
 
-	/* priority case */
-	if ((pcode & 0xffff) != 0xff00)
-	{
-		for (i = 0; i < count; i++)
+		/* some in: test each one */
+		else if (hit != 0)
 		{
-			dest[i] = clut[source[i]];
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
+			int j;
+			for (j = 0; j < 4; j++)
+				if (hit & (1 << j))
+				{
+					if (format != BLIT_FORMAT_NULL)
+						blit_pixel(dest, i + j, source[i + j], clut, pal, alpha, format);
+					if (dopri)
+						pri[i + j] = (pri[i + j] & (pcode >> 8)) | pcode;
+				}
 		}
 	}
 
-	/* no priority case */
-	else
-	{
-		for (i = 0; i < count; i++)
-			dest[i] = clut[source[i]];
-	}
-}
-
-
-/*-------------------------------------------------
-    scanline_draw_masked_rgb32 - draw to a 32bpp
-    RGB bitmap using a mask
--------------------------------------------------*/
-
-static void scanline_draw_masked_rgb32(void *_dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha)
-{
-	const pen_t *clut = &pens[pcode >> 16];
-	UINT32 *dest = (UINT32 *)_dest;
-	int i;
-
-	/* priority case */
-	if ((pcode & 0xffff) != 0xff00)
-	{
-		for (i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-			{
-				dest[i] = clut[source[i]];
-				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-			}
-	}
-
-	/* no priority case */
-	else
-	{
-		for (i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-				dest[i] = clut[source[i]];
-	}
-}
-
-
-/*-------------------------------------------------
-    scanline_draw_opaque_rgb32_alpha - draw to a
-    32bpp RGB bitmap with alpha blending
--------------------------------------------------*/
-
-static void scanline_draw_opaque_rgb32_alpha(void *_dest, const UINT16 *source, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha)
-{
-	const pen_t *clut = &pens[pcode >> 16];
-	UINT32 *dest = (UINT32 *)_dest;
-	int i;
-
-	/* priority case */
-	if ((pcode & 0xffff) != 0xff00)
-	{
-		for (i = 0; i < count; i++)
+	/* mop up the remainder */
+	for ( ; i < count; i++)
+		if ((maskptr[i] & mask) == value)
 		{
-			dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
+			if (format != BLIT_FORMAT_NULL)
+				blit_pixel(dest, i, source[i], clut, pal, alpha, format);
+			if (dopri)
+				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
 		}
-	}
-
-	/* no priority case */
-	else
-	{
-		for (i = 0; i < count; i++)
-			dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
-	}
 }
 
 
 /*-------------------------------------------------
-    scanline_draw_masked_rgb32_alpha - draw to a
-    32bpp RGB bitmap using a mask and alpha
-    blending
+    specialized rasterizers; the _pri variants
+    update the priority bitmap, the others leave
+    it alone
 -------------------------------------------------*/
 
-static void scanline_draw_masked_rgb32_alpha(void *_dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha)
-{
-	const pen_t *clut = &pens[pcode >> 16];
-	UINT32 *dest = (UINT32 *)_dest;
-	int i;
-
-	/* priority case */
-	if ((pcode & 0xffff) != 0xff00)
-	{
-		for (i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-			{
-				dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
-				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-			}
-	}
-
-	/* no priority case */
-	else
-	{
-		for (i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-				dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
-	}
-}
+#define SCANLINE_RASTERIZERS(NAME, FORMAT)																											\
+static void scanline_draw_opaque_##NAME(void *dest, const UINT16 *source, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha)				\
+{ scanline_draw_opaque_core(dest, source, count, pens, pri, pcode, alpha, FORMAT, FALSE); }																		\
+static void scanline_draw_opaque_##NAME##_pri(void *dest, const UINT16 *source, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha)			\
+{ scanline_draw_opaque_core(dest, source, count, pens, pri, pcode, alpha, FORMAT, TRUE); }																		\
+static void scanline_draw_masked_##NAME(void *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha)		\
+{ scanline_draw_masked_core(dest, source, maskptr, mask, value, count, pens, pri, pcode, alpha, FORMAT, FALSE); }												\
+static void scanline_draw_masked_##NAME##_pri(void *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha)	\
+{ scanline_draw_masked_core(dest, source, maskptr, mask, value, count, pens, pri, pcode, alpha, FORMAT, TRUE); }												\
+static void tilemap_draw_roz_##NAME(tilemap *tmap, const blit_parameters *blit, UINT32 startx, UINT32 starty, int incxx, int incxy, int incyx, int incyy, int wraparound)	\
+{ tilemap_draw_roz_core(tmap, blit, startx, starty, incxx, incxy, incyx, incyy, wraparound, FORMAT); }
+
+SCANLINE_RASTERIZERS(null,        BLIT_FORMAT_NULL)
+SCANLINE_RASTERIZERS(ind16,       BLIT_FORMAT_IND16)
+SCANLINE_RASTERIZERS(rgb16,       BLIT_FORMAT_RGB16)
+SCANLINE_RASTERIZERS(rgb16_alpha, BLIT_FORMAT_RGB16_ALPHA)
+SCANLINE_RASTERIZERS(rgb32,       BLIT_FORMAT_RGB32)
+SCANLINE_RASTERIZERS(rgb32_alpha, BLIT_FORMAT_RGB32_ALPHA)
+
+
+/* table of rasterizers, indexed by format and then priority */
+static const blit_rasterizers rasterizer_table[BLIT_FORMAT_COUNT][2] =
+{
+	{ { "null",        scanline_draw_masked_null,        scanline_draw_opaque_null,        tilemap_draw_roz_null },
+	  { "null",        scanline_draw_masked_null_pri,    scanline_draw_opaque_null_pri,    tilemap_draw_roz_null } },
+	{ { "ind16",       scanline_draw_masked_ind16,       scanline_draw_opaque_ind16,       tilemap_draw_roz_ind16 },
+	  { "ind16",       scanline_draw_masked_ind16_pri,   scanline_draw_opaque_ind16_pri,   tilemap_draw_roz_ind16 } },
+	{ { "rgb16",       scanline_draw_masked_rgb16,       scanline_draw_opaque_rgb16,       tilemap_draw_roz_rgb16 },
+	  { "rgb16",       scanline_draw_masked_rgb16_pri,   scanline_draw_opaque_rgb16_pri,   tilemap_draw_roz_rgb16 } },
+	{ { "rgb16_alpha", scanline_draw_masked_rgb16_alpha, scanline_draw_opaque_rgb16_alpha, tilemap_draw_roz_rgb16_alpha },
+	  { "rgb16_alpha", scanline_draw_masked_rgb16_alpha_pri, scanline_draw_opaque_rgb16_alpha_pri, tilemap_draw_roz_rgb16_alpha } },
+	{ { "rgb32",       scanline_draw_masked_rgb32,       scanline_draw_opaque_rgb32,       tilemap_draw_roz_rgb32 },
+	  { "rgb32",       scanline_draw_masked_rgb32_pri,   scanline_draw_opaque_rgb32_pri,   tilemap_draw_roz_rgb32 } },
+	{ { "rgb32_alpha", scanline_draw_masked_rgb32_alpha, scanline_draw_opaque_rgb32_alpha, tilemap_draw_roz_rgb32_alpha },
+	  { "rgb32_alpha", scanline_draw_masked_rgb32_alpha_pri, scanline_draw_opaque_rgb32_alpha_pri, tilemap_draw_roz_rgb32_alpha } }
+};
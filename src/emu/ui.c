@@ -1165,6 +1165,9 @@ static UINT32 handler_ingame(running_machine *machine, UINT32 state)
 	if (show_profiler)
 	{
 		astring *profilertext = profiler_get_text(machine, astring_alloc());
+		astring *soundtext = sound_get_profile_text(machine, astring_alloc());
+		astring_cat(profilertext, soundtext);
+		astring_free(soundtext);
 		ui_draw_text_full(astring_c(profilertext), 0.0f, 0.0f, 1.0f, JUSTIFY_LEFT, WRAP_WORD, DRAW_OPAQUE, ARGB_WHITE, ARGB_BLACK, NULL, NULL);
 		astring_free(profilertext);
 	}
@@ -42,6 +42,13 @@
 #define DEFAULT_FRAME_RATE			60
 #define DEFAULT_FRAME_PERIOD		ATTOTIME_IN_HZ(DEFAULT_FRAME_RATE)
 
+/* frame pacing histograms hold intervals up to 64ms in 1/4ms buckets */
+#define FRAME_HISTOGRAM_BUCKETS		(256)
+#define FRAME_HISTOGRAM_US_PER_BUCKET (250)
+
+/* never spin for more than 2ms before a frame when pacing */
+#define MAX_PACING_SPIN_US			(2000)
+
 
 
 /***************************************************************************
@@ -124,6 +131,21 @@ struct _video_global
 	UINT8					skipping_this_frame;	/* flag: TRUE if we are skipping the current frame */
 	osd_ticks_t				average_oversleep;		/* average number of ticks the OSD oversleeps */
 
+	/* frame pacing */
+	UINT8					frame_pacing;			/* flag: TRUE if predictive frame pacing is enabled */
+	osd_ticks_t				pacing_frame_start;		/* ticks when work on the current frame began */
+	osd_ticks_t				pacing_last_present;	/* ticks at the last displayed frame */
+	osd_ticks_t				pacing_last_cost;		/* work ticks for the most recent frame */
+	UINT32					pacing_frames;			/* emulated frames since the last displayed frame */
+	double					pacing_cost[2];			/* average work ticks for drawn [0] and skipped [1] frames */
+	double					pacing_cost_dev[2];		/* average deviation of the above */
+	double					pacing_oversleep;		/* average ticks the OSD oversleeps a request by */
+	double					pacing_oversleep_dev;	/* average deviation of the above */
+	UINT32					frame_histogram[FRAME_HISTOGRAM_BUCKETS]; /* histogram of displayed frame intervals */
+	UINT32					jitter_histogram[FRAME_HISTOGRAM_BUCKETS]; /* histogram of interval error versus the ideal */
+	UINT32					histogram_frames;		/* number of intervals in the histograms */
+	mame_file *				framelog;				/* per-frame timing log, or NULL */
+
 	/* snapshot stuff */
 	render_target *			snap_target;			/* screen shapshot target */
 	bitmap_t *				snap_bitmap;			/* screen snapshot bitmap */
@@ -193,6 +215,10 @@ static int finish_screen_updates(running_machine *machine);
 static void update_throttle(running_machine *machine, attotime emutime);
 static osd_ticks_t throttle_until_ticks(running_machine *machine, osd_ticks_t target_ticks);
 static void update_frameskip(running_machine *machine);
+static void update_frameskip_predictive(running_machine *machine);
+static osd_ticks_t frame_period_ticks(running_machine *machine);
+static void pacing_frame_done(running_machine *machine, int skipped);
+static UINT32 histogram_percentile_us(const UINT32 *histogram, UINT32 total, int percent);
 static void recompute_speed(running_machine *machine, attotime emutime);
 static void update_refresh_speed(running_machine *machine);
 
@@ -330,6 +356,17 @@ void video_init(running_machine *machine)
 	global.auto_frameskip = options_get_bool(mame_options(), OPTION_AUTOFRAMESKIP);
 	global.frameskip_level = options_get_int(mame_options(), OPTION_FRAMESKIP);
 	global.seconds_to_run = options_get_int(mame_options(), OPTION_SECONDS_TO_RUN);
+	global.frame_pacing = options_get_bool(mame_options(), OPTION_FRAMEPACING);
+
+	/* open the frame timing log if requested */
+	filename = options_get_string(mame_options(), OPTION_FRAMELOG);
+	if (filename[0] != 0)
+	{
+		if (mame_fopen(SEARCHPATH_MOVIE, filename, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS, &global.framelog) == FILERR_NONE)
+			mame_fprintf(global.framelog, "frame,interval_us,cost_us,skipped_before\n");
+		else
+			global.framelog = NULL;
+	}
 
 	/* create spriteram buffers if necessary */
 	if (machine->config->video_attributes & VIDEO_BUFFERS_SPRITERAM)
@@ -413,6 +450,21 @@ static void video_exit(running_machine *machine)
 	if (global.snap_bitmap != NULL)
 		bitmap_free(global.snap_bitmap);
 
+	/* summarize frame timing in the log and close it */
+	if (global.framelog != NULL)
+	{
+		mame_fprintf(global.framelog, "# frames=%d interval_p50_us=%d interval_p95_us=%d interval_p99_us=%d jitter_p50_us=%d jitter_p95_us=%d jitter_p99_us=%d\n",
+				global.histogram_frames,
+				histogram_percentile_us(global.frame_histogram, global.histogram_frames, 50),
+				histogram_percentile_us(global.frame_histogram, global.histogram_frames, 95),
+				histogram_percentile_us(global.frame_histogram, global.histogram_frames, 99),
+				histogram_percentile_us(global.jitter_histogram, global.histogram_frames, 50),
+				histogram_percentile_us(global.jitter_histogram, global.histogram_frames, 95),
+				histogram_percentile_us(global.jitter_histogram, global.histogram_frames, 99));
+		mame_fclose(global.framelog);
+		global.framelog = NULL;
+	}
+
 	/* print a final result if we have at least 5 seconds' worth of data */
 	if (global.overall_emutime.seconds >= 5)
 	{
@@ -469,8 +521,15 @@ static void init_buffered_spriteram(running_machine *machine)
 
 static void allocate_graphics(running_machine *machine, const gfx_decode_entry *gfxdecodeinfo)
 {
+	int poolmb = options_get_int(mame_options(), OPTION_GFXPOOL);
+	UINT32 poolbytes = 0;
 	int curgfx;
 
+	/* the pool limit is in MB; clamp it so the byte count fits in 32 bits, and */
+	/* leave pooling off for drivers that read gfxdata directly */
+	if (poolmb > 0 && !(machine->config->video_attributes & VIDEO_NEEDS_GFXDATA))
+		poolbytes = (UINT32)MIN(poolmb, 4095) * 1024 * 1024;
+
 	/* loop over all elements */
 	for (curgfx = 0; curgfx < MAX_GFX_ELEMENTS && gfxdecodeinfo[curgfx].gfxlayout != NULL; curgfx++)
 	{
@@ -587,8 +646,8 @@ static void allocate_graphics(running_machine *machine, const gfx_decode_entry *
 		glcopy.height = height;
 		glcopy.total = total;
 
-		/* allocate the graphics */
-		machine->gfx[curgfx] = gfx_element_alloc(machine, &glcopy, (region_base != NULL) ? region_base + gfxdecode->start : NULL, gfxdecode->total_color_codes, gfxdecode->color_codes_start);
+		/* allocate the graphics; large sets decode on demand into a bounded pool if enabled */
+		machine->gfx[curgfx] = gfx_element_alloc_pooled(machine, &glcopy, (region_base != NULL) ? region_base + gfxdecode->start : NULL, gfxdecode->total_color_codes, gfxdecode->color_codes_start, poolbytes);
 	}
 }
 
@@ -1450,6 +1509,10 @@ void video_frame_update(running_machine *machine, int debug)
 	/* draw the user interface */
 	ui_update_and_render(machine);
 
+	/* account for the cost of this frame before we wait */
+	if (!debug && (global.frame_pacing || global.framelog != NULL))
+		pacing_frame_done(machine, skipped_it);
+
 	/* if we're throttling, synchronize before rendering */
 	if (!debug && !skipped_it && effective_throttle(machine))
 		update_throttle(machine, current_time);
@@ -1459,6 +1522,35 @@ void video_frame_update(running_machine *machine, int debug)
 	osd_update(machine, !debug && skipped_it);
 	profiler_mark_end();
 
+	/* record the interval between displayed frames */
+	if (!debug && !skipped_it && (global.frame_pacing || global.framelog != NULL))
+	{
+		osd_ticks_t now = osd_ticks();
+
+		if (global.pacing_last_present != 0)
+		{
+			osd_ticks_t tps = osd_ticks_per_second();
+			osd_ticks_t interval = now - global.pacing_last_present;
+			osd_ticks_t ideal = frame_period_ticks(machine) * global.pacing_frames;
+			osd_ticks_t error = (interval > ideal) ? interval - ideal : ideal - interval;
+			UINT32 interval_us = (UINT32)MIN(interval * 1000000 / tps, 0xffffffff);
+			UINT32 error_us = (UINT32)MIN(error * 1000000 / tps, 0xffffffff);
+
+			global.frame_histogram[MIN(interval_us / FRAME_HISTOGRAM_US_PER_BUCKET, FRAME_HISTOGRAM_BUCKETS - 1)]++;
+			global.jitter_histogram[MIN(error_us / FRAME_HISTOGRAM_US_PER_BUCKET, FRAME_HISTOGRAM_BUCKETS - 1)]++;
+			global.histogram_frames++;
+
+			if (global.framelog != NULL)
+				mame_fprintf(global.framelog, "%d,%d,%d,%d\n", global.histogram_frames, interval_us,
+						(int)(global.pacing_last_cost * 1000000 / tps), global.pacing_frames - 1);
+		}
+		global.pacing_last_present = now;
+		global.pacing_frames = 0;
+	}
+
+	/* the next frame's work starts now */
+	global.pacing_frame_start = osd_ticks();
+
 	/* perform tasks for this frame */
 	if (!debug)
 		mame_frame_update(machine);
@@ -1633,6 +1725,16 @@ const char *video_get_speed_text(running_machine *machine)
 	if (!paused)
 		dest += sprintf(dest, "%4d%%", (int)(100 * global.speed_percent + 0.5));
 
+	/* display frame pacing statistics if enabled */
+	if (global.frame_pacing && global.histogram_frames != 0)
+		dest += sprintf(dest, "\nframe %d/%d/%dms jitter %d/%d/%dms",
+				(histogram_percentile_us(global.frame_histogram, global.histogram_frames, 50) + 500) / 1000,
+				(histogram_percentile_us(global.frame_histogram, global.histogram_frames, 95) + 500) / 1000,
+				(histogram_percentile_us(global.frame_histogram, global.histogram_frames, 99) + 500) / 1000,
+				(histogram_percentile_us(global.jitter_histogram, global.histogram_frames, 50) + 500) / 1000,
+				(histogram_percentile_us(global.jitter_histogram, global.histogram_frames, 95) + 500) / 1000,
+				(histogram_percentile_us(global.jitter_histogram, global.histogram_frames, 99) + 500) / 1000);
+
 	/* display the number of partial updates as well */
 	if (global.partial_updates_this_frame > 1)
 		dest += sprintf(dest, "\n%d partial updates", global.partial_updates_this_frame);
@@ -1900,6 +2002,7 @@ static osd_ticks_t throttle_until_ticks(running_machine *machine, osd_ticks_t ta
 {
 	osd_ticks_t minimum_sleep = osd_ticks_per_second() / 1000;
 	osd_ticks_t current_ticks = osd_ticks();
+	osd_ticks_t spin_margin = 0;
 	osd_ticks_t new_ticks;
 	int allowed_to_sleep = FALSE;
 
@@ -1910,6 +2013,15 @@ static osd_ticks_t throttle_until_ticks(running_machine *machine, osd_ticks_t ta
     if (mame_is_paused(machine))
     	allowed_to_sleep = TRUE;
 
+	/* when pacing, stop sleeping early enough that a typical oversleep still
+       lands before the target, and spin for the remainder */
+	if (global.frame_pacing)
+	{
+		osd_ticks_t max_spin = osd_ticks_per_second() * MAX_PACING_SPIN_US / 1000000;
+		spin_margin = (osd_ticks_t)(global.pacing_oversleep + 2 * global.pacing_oversleep_dev);
+		spin_margin = MIN(spin_margin, max_spin);
+	}
+
 	/* loop until we reach our target */
 	profiler_mark_start(PROFILER_IDLE);
 	while (current_ticks < target_ticks)
@@ -1918,7 +2030,10 @@ static osd_ticks_t throttle_until_ticks(running_machine *machine, osd_ticks_t ta
 		int slept = FALSE;
 
 		/* compute how much time to sleep for, taking into account the average oversleep */
-		delta = (target_ticks - current_ticks) * 1000 / (1000 + global.average_oversleep);
+		if (global.frame_pacing)
+			delta = (target_ticks - current_ticks > spin_margin) ? target_ticks - current_ticks - spin_margin : 0;
+		else
+			delta = (target_ticks - current_ticks) * 1000 / (1000 + global.average_oversleep);
 
 		/* see if we can sleep */
 		if (allowed_to_sleep && delta >= minimum_sleep)
@@ -1935,6 +2050,14 @@ static osd_ticks_t throttle_until_ticks(running_machine *machine, osd_ticks_t ta
 		{
 			osd_ticks_t actual_ticks = new_ticks - current_ticks;
 
+			/* track the absolute oversleep and its spread for pacing */
+			if (global.frame_pacing)
+			{
+				double error = (double)((actual_ticks > delta) ? actual_ticks - delta : 0) - global.pacing_oversleep;
+				global.pacing_oversleep += error / 16;
+				global.pacing_oversleep_dev += (fabs(error) - global.pacing_oversleep_dev) / 16;
+			}
+
 			/* if we overslept, keep an average of the amount */
 			if (actual_ticks > delta)
 			{
@@ -1962,8 +2085,15 @@ static osd_ticks_t throttle_until_ticks(running_machine *machine, osd_ticks_t ta
 
 static void update_frameskip(running_machine *machine)
 {
+	/* with frame pacing enabled, choose the level from the cost model instead */
+	if (global.frame_pacing)
+	{
+		if (effective_throttle(machine) && effective_autoframeskip(machine) && global.frameskip_counter == 0)
+			update_frameskip_predictive(machine);
+	}
+
 	/* if we're throttling and autoframeskip is on, adjust */
-	if (effective_throttle(machine) && effective_autoframeskip(machine) && global.frameskip_counter == 0)
+	else if (effective_throttle(machine) && effective_autoframeskip(machine) && global.frameskip_counter == 0)
 	{
 		double speed = global.speed * 0.01;
 
@@ -2006,6 +2136,116 @@ static void update_frameskip(running_machine *machine)
 }
 
 
+/*-------------------------------------------------
+    update_frameskip_predictive - pick the lowest
+    frameskip level whose predicted cost over a
+    full skip cycle fits in real time
+-------------------------------------------------*/
+
+static void update_frameskip_predictive(running_machine *machine)
+{
+	double budget = (double)frame_period_ticks(machine) * FRAMESKIP_LEVELS;
+	double drawn = global.pacing_cost[0] + global.pacing_cost_dev[0];
+	double skipped = global.pacing_cost[1] + global.pacing_cost_dev[1];
+	int level;
+
+	/* until we have measured a skipped frame, assume it costs half a drawn one */
+	if (global.pacing_cost[1] == 0)
+		skipped = drawn * 0.5;
+
+	/* find the lowest level that fits, leaving a little headroom; to avoid
+       bouncing between levels, dropping below the current level needs more */
+	for (level = 0; level < MAX_FRAMESKIP; level++)
+	{
+		double predicted = 0;
+		int frame;
+
+		for (frame = 0; frame < FRAMESKIP_LEVELS; frame++)
+			predicted += skiptable[level][frame] ? skipped : drawn;
+		if (predicted <= budget * ((level < global.frameskip_level) ? 0.90 : 0.97))
+			break;
+	}
+
+	if (LOG_THROTTLE && level != global.frameskip_level)
+		logerror("Predictive frameskip %d -> %d (drawn=%d skipped=%d budget=%d ticks)\n", global.frameskip_level, level, (int)drawn, (int)skipped, (int)(budget / FRAMESKIP_LEVELS));
+	global.frameskip_level = level;
+}
+
+
+/*-------------------------------------------------
+    frame_period_ticks - return the real time a
+    single emulated frame should take, in OSD
+    ticks, accounting for the speed factor
+-------------------------------------------------*/
+
+static osd_ticks_t frame_period_ticks(running_machine *machine)
+{
+	attoseconds_t period = DEFAULT_FRAME_PERIOD.attoseconds;
+	double ticks;
+
+	if (machine->primary_screen != NULL)
+		period = video_screen_get_frame_period(machine->primary_screen).attoseconds;
+
+	ticks = (double)period * (double)osd_ticks_per_second() / (double)ATTOSECONDS_PER_SECOND;
+	if (global.speed != 0 && global.speed != 100)
+		ticks = ticks * 100 / global.speed;
+	return (osd_ticks_t)ticks;
+}
+
+
+/*-------------------------------------------------
+    pacing_frame_done - update the per-frame cost
+    model with the work done on the frame that
+    just finished
+-------------------------------------------------*/
+
+static void pacing_frame_done(running_machine *machine, int skipped)
+{
+	osd_ticks_t cost = osd_ticks() - global.pacing_frame_start;
+	double *average = &global.pacing_cost[skipped ? 1 : 0];
+	double *deviation = &global.pacing_cost_dev[skipped ? 1 : 0];
+	double error;
+
+	global.pacing_last_cost = cost;
+	global.pacing_frames++;
+
+	/* ignore the very first frame and anything over a second, which is a stall */
+	if (global.pacing_frame_start == 0 || cost >= osd_ticks_per_second())
+		return;
+
+	/* seed with the first sample, then take 7/8 of the old value plus 1/8 of the new */
+	if (*average == 0)
+		*average = cost;
+	error = (double)cost - *average;
+	*average += error / 8;
+	*deviation += (fabs(error) - *deviation) / 8;
+}
+
+
+/*-------------------------------------------------
+    histogram_percentile_us - return the upper
+    bound in microseconds of the histogram bucket
+    containing the given percentile
+-------------------------------------------------*/
+
+static UINT32 histogram_percentile_us(const UINT32 *histogram, UINT32 total, int percent)
+{
+	UINT64 target = ((UINT64)total * percent + 99) / 100;
+	UINT64 sum = 0;
+	int bucket;
+
+	if (total == 0)
+		return 0;
+	for (bucket = 0; bucket < FRAME_HISTOGRAM_BUCKETS - 1; bucket++)
+	{
+		sum += histogram[bucket];
+		if (sum >= target)
+			break;
+	}
+	return (bucket + 1) * FRAME_HISTOGRAM_US_PER_BUCKET;
+}
+
+
 /*-------------------------------------------------
     update_refresh_speed - update the global.speed
     based on the maximum refresh rate supported
@@ -36,6 +36,7 @@
 #define CACHE_LINE_SIZE					64			/* this is a general guess */
 #define TOTAL_BUCKETS					(512 / SCANLINES_PER_BUCKET)
 #define UNITS_PER_POLY					(100 / SCANLINES_PER_BUCKET)
+#define TOTAL_STRIPS					(65536 / SCANLINES_PER_BUCKET)	/* strips covering every INT16 scanline */
 
 
 
@@ -97,9 +98,8 @@ struct _work_unit_shared
 	volatile UINT32		count_next;				/* number of scanlines and index of next item to process */
 	INT16				scanline;				/* starting scanline and count */
 	UINT16				previtem;				/* index of previous item in the same bucket */
-#ifndef PTR64
-	UINT32				dummy;					/* pad to 16 bytes */
-#endif
+	INT16				minx;					/* leftmost X covered by any extent */
+	INT16				maxx;					/* rightmost X covered by any extent (exclusive) */
 };
 
 
@@ -131,6 +131,16 @@ union _work_unit
 };
 
 
+/* tile_row describes a row of tiles, rendered left to right by a single work item */
+typedef struct _tile_row tile_row;
+struct _tile_row
+{
+	poly_manager *		poly;					/* pointer back to the poly manager */
+	UINT32				firststrip;				/* first strip in the row */
+	UINT32				laststrip;				/* last strip in the row (exclusive) */
+};
+
+
 /* polygon_info describes a single polygon, which includes the poly_params */
 struct _polygon_info
 {
@@ -177,10 +187,20 @@ struct _poly_manager
 
 	/* misc data */
 	UINT8				flags;					/* flags */
+	INT32				scale;					/* multiplier applied to vertex X/Y and cliprects */
 
 	/* buckets */
 	UINT16				unit_bucket[TOTAL_BUCKETS]; /* buckets for tracking unit usage */
 
+	/* tiles */
+	INT32				tile_width;				/* width of each tile, or 0 to render in strips */
+	UINT32				tile_strips;			/* number of strips in each row of tiles */
+	INT32				tile_minx;				/* left edge of the leftmost tile in use */
+	INT32				tile_maxx;				/* right edge of the rightmost tile in use */
+	UINT32 *			strip_start;			/* index in strip_unit of the first unit in each strip */
+	UINT32 *			strip_unit;				/* unit indexes sorted by strip, in submission order */
+	tile_row *			row;					/* array of tile rows handed to the work queue */
+
 	/* statistics */
 	UINT32				triangles;				/* number of triangles queued */
 	UINT32				quads;					/* number of quads queued */
@@ -206,6 +226,8 @@ struct _poly_manager
 static void **allocate_array(size_t *itemsize, UINT32 itemcount);
 static void free_array(void **array);
 static void *poly_item_callback(void *param, int threadid);
+static void render_tiles(poly_manager *poly);
+static void *poly_tile_callback(void *param, int threadid);
 static STATE_PRESAVE( poly_state_presave );
 
 
@@ -227,6 +249,56 @@ INLINE INT32 round_coordinate(float value)
 }
 
 
+/*-------------------------------------------------
+    strip_index - return the index of the strip
+    containing a scanline, counting from the
+    most negative INT16 scanline
+-------------------------------------------------*/
+
+INLINE UINT32 strip_index(INT32 scanline)
+{
+	return (UINT32)(scanline + 32768) / SCANLINES_PER_BUCKET;
+}
+
+
+/*-------------------------------------------------
+    scale_vertices - copy a set of vertices with
+    their X/Y coordinates multiplied by the
+    manager's scale
+-------------------------------------------------*/
+
+INLINE void scale_vertices(const poly_manager *poly, int numverts, const poly_vertex *v, poly_vertex *outv, int paramcount)
+{
+	float scale = (float)poly->scale;
+	int vertnum, paramnum;
+
+	for (vertnum = 0; vertnum < numverts; vertnum++)
+	{
+		outv[vertnum].x = v[vertnum].x * scale;
+		outv[vertnum].y = v[vertnum].y * scale;
+		for (paramnum = 0; paramnum < paramcount; paramnum++)
+			outv[vertnum].p[paramnum] = v[vertnum].p[paramnum];
+	}
+}
+
+
+/*-------------------------------------------------
+    scale_cliprect - scale a cliprect so that it
+    covers the same area at the manager's scale
+-------------------------------------------------*/
+
+INLINE const rectangle *scale_cliprect(const poly_manager *poly, const rectangle *cliprect, rectangle *outrect)
+{
+	if (cliprect == NULL)
+		return NULL;
+	outrect->min_x = cliprect->min_x * poly->scale;
+	outrect->max_x = (cliprect->max_x + 1) * poly->scale - 1;
+	outrect->min_y = cliprect->min_y * poly->scale;
+	outrect->max_y = (cliprect->max_y + 1) * poly->scale - 1;
+	return outrect;
+}
+
+
 /*-------------------------------------------------
     convert_tri_extent_to_poly_extent - convert
     a simple tri_extent to a full poly_extent
@@ -329,12 +401,25 @@ INLINE polygon_info *allocate_polygon(poly_manager *poly, int miny, int maxy)
 -------------------------------------------------*/
 
 poly_manager *poly_alloc(running_machine *machine, int max_polys, size_t extra_data_size, UINT8 flags)
+{
+	return poly_alloc_tiled(machine, max_polys, extra_data_size, flags, 0, 0);
+}
+
+
+/*-------------------------------------------------
+    poly_alloc_tiled - initialize a new polygon
+    manager that defers rendering until
+    poly_wait and then renders tile by tile
+-------------------------------------------------*/
+
+poly_manager *poly_alloc_tiled(running_machine *machine, int max_polys, size_t extra_data_size, UINT8 flags, int tilewidth, int tileheight)
 {
 	poly_manager *poly;
 
 	/* allocate the manager itself */
 	poly = alloc_clear_or_die(poly_manager);
 	poly->flags = flags;
+	poly->scale = 1;
 
 	/* allocate polygons */
 	poly->polygon_size = sizeof(polygon_info);
@@ -354,6 +439,16 @@ poly_manager *poly_alloc(running_machine *machine, int max_polys, size_t extra_d
 	poly->unit_next = 0;
 	poly->unit = (work_unit **)allocate_array(&poly->unit_size, poly->unit_count);
 
+	/* set up the tiles; their height is rounded up to a whole number of strips */
+	if (tilewidth > 0)
+	{
+		poly->tile_width = tilewidth;
+		poly->tile_strips = MAX((tileheight + SCANLINES_PER_BUCKET - 1) / SCANLINES_PER_BUCKET, 1);
+		poly->strip_start = alloc_array_or_die(UINT32, TOTAL_STRIPS + 2);
+		poly->strip_unit = alloc_array_or_die(UINT32, poly->unit_count);
+		poly->row = alloc_array_clear_or_die(tile_row, TOTAL_STRIPS / poly->tile_strips + 1);
+	}
+
 	/* create the work queue */
 	if (!(flags & POLYFLAG_NO_WORK_QUEUE))
 		poly->queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
@@ -399,6 +494,12 @@ void poly_free(poly_manager *poly)
 	free_array(poly->extra);
 	free_array((void **)poly->polygon);
 	free_array((void **)poly->unit);
+	if (poly->tile_width != 0)
+	{
+		free(poly->strip_start);
+		free(poly->strip_unit);
+		free(poly->row);
+	}
 
 	/* free the manager itself */
 	free(poly);
@@ -423,12 +524,16 @@ void poly_wait(poly_manager *poly, const char *debug_reason)
 	if (LOG_WAITS)
 		time = get_profile_ticks();
 
+	/* when tiling, nothing has been queued yet; bin and render everything now */
+	if (poly->tile_width != 0)
+		render_tiles(poly);
+
 	/* wait for all pending work items to complete */
 	if (poly->queue != NULL)
 		osd_work_queue_wait(poly->queue, osd_ticks_per_second() * 100);
 
 	/* if we don't have a queue, just run the whole list now */
-	else
+	else if (poly->tile_width == 0)
 	{
 		int unitnum;
 		for (unitnum = 0; unitnum < poly->unit_next; unitnum++)
@@ -479,6 +584,31 @@ void *poly_get_extra_data(poly_manager *poly)
 
 
 
+/*-------------------------------------------------
+    poly_set_scale - render subsequent polygons
+    at a multiple of the resolution their
+    vertices and cliprects are given in
+-------------------------------------------------*/
+
+void poly_set_scale(poly_manager *poly, int scale)
+{
+	assert(scale >= 1);
+	poly->scale = scale;
+}
+
+
+/*-------------------------------------------------
+    poly_get_scale - return the current
+    rendering scale
+-------------------------------------------------*/
+
+int poly_get_scale(poly_manager *poly)
+{
+	return poly->scale;
+}
+
+
+
 /***************************************************************************
     CORE TRIANGLE RENDERING
 ***************************************************************************/
@@ -498,6 +628,20 @@ UINT32 poly_render_triangle(poly_manager *poly, void *dest, const rectangle *cli
 	INT32 v1y, v3y, v1x;
 	INT32 pixels = 0;
 	UINT32 startunit;
+	poly_vertex scaledv[3];
+	rectangle scaledclip;
+
+	/* scale to the internal resolution */
+	if (poly->scale != 1)
+	{
+		scale_vertices(poly, 1, v1, &scaledv[0], paramcount);
+		scale_vertices(poly, 1, v2, &scaledv[1], paramcount);
+		scale_vertices(poly, 1, v3, &scaledv[2], paramcount);
+		v1 = &scaledv[0];
+		v2 = &scaledv[1];
+		v3 = &scaledv[2];
+		cliprect = scale_cliprect(poly, cliprect, &scaledclip);
+	}
 
 	/* first sort by Y */
 	if (v2->y < v1->y)
@@ -562,6 +706,7 @@ UINT32 poly_render_triangle(poly_manager *poly, void *dest, const rectangle *cli
 		UINT32 bucketnum = ((UINT32)curscan / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
 		UINT32 unit_index = poly->unit_next++;
 		tri_work_unit *unit = &poly->unit[unit_index]->tri;
+		INT32 minx = 0x7fff, maxx = -0x8000;
 		int extnum;
 
 		/* determine how much to advance to hit the next bucket */
@@ -619,7 +764,15 @@ UINT32 poly_render_triangle(poly_manager *poly, void *dest, const rectangle *cli
 			unit->extent[extnum].startx = istartx;
 			unit->extent[extnum].stopx = istopx;
 			pixels += istopx - istartx;
+			/* track the horizontal coverage of the unit for tiling */
+			if (istartx < istopx)
+			{
+				minx = MIN(minx, istartx);
+				maxx = MAX(maxx, istopx);
+			}
 		}
+		unit->shared.minx = minx;
+		unit->shared.maxx = maxx;
 	}
 #if KEEP_STATISTICS
 	poly->unit_max = MAX(poly->unit_max, poly->unit_next);
@@ -656,7 +809,7 @@ UINT32 poly_render_triangle(poly_manager *poly, void *dest, const rectangle *cli
 	}
 
 	/* enqueue the work items */
-	if (poly->queue != NULL)
+	if (poly->queue != NULL && poly->tile_width == 0)
 		osd_work_item_queue_multiple(poly->queue, poly_item_callback, poly->unit_next - startunit, poly->unit[startunit], poly->unit_size, WORK_ITEM_FLAG_AUTO_RELEASE);
 
 	/* return the total number of pixels in the triangle */
@@ -728,6 +881,7 @@ UINT32 poly_render_triangle_custom(poly_manager *poly, void *dest, const rectang
 		UINT32 bucketnum = ((UINT32)curscan / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
 		UINT32 unit_index = poly->unit_next++;
 		tri_work_unit *unit = &poly->unit[unit_index]->tri;
+		INT32 minx = 0x7fff, maxx = -0x8000;
 		int extnum;
 
 		/* determine how much to advance to hit the next bucket */
@@ -768,14 +922,22 @@ UINT32 poly_render_triangle_custom(poly_manager *poly, void *dest, const rectang
 			unit->extent[extnum].stopx = istopx;
 			if (istartx < istopx)
 				pixels += istopx - istartx;
+			/* track the horizontal coverage of the unit for tiling */
+			if (istartx < istopx)
+			{
+				minx = MIN(minx, istartx);
+				maxx = MAX(maxx, istopx);
+			}
 		}
+		unit->shared.minx = minx;
+		unit->shared.maxx = maxx;
 	}
 #if KEEP_STATISTICS
 	poly->unit_max = MAX(poly->unit_max, poly->unit_next);
 #endif
 
 	/* enqueue the work items */
-	if (poly->queue != NULL)
+	if (poly->queue != NULL && poly->tile_width == 0)
 		osd_work_item_queue_multiple(poly->queue, poly_item_callback, poly->unit_next - startunit, poly->unit[startunit], poly->unit_size, WORK_ITEM_FLAG_AUTO_RELEASE);
 
 	/* return the total number of pixels in the object */
@@ -808,6 +970,8 @@ UINT32 poly_render_quad(poly_manager *poly, void *dest, const rectangle *cliprec
 	polygon_info *polygon;
 	INT32 pixels = 0;
 	UINT32 startunit;
+	poly_vertex scaledv[4];
+	rectangle scaledclip;
 
 	assert(poly->flags & POLYFLAG_ALLOW_QUADS);
 
@@ -817,6 +981,17 @@ UINT32 poly_render_quad(poly_manager *poly, void *dest, const rectangle *cliprec
 	v[2] = v3;
 	v[3] = v4;
 
+	/* scale to the internal resolution */
+	if (poly->scale != 1)
+	{
+		for (curv = 0; curv < 4; curv++)
+		{
+			scale_vertices(poly, 1, v[curv], &scaledv[curv], paramcount);
+			v[curv] = &scaledv[curv];
+		}
+		cliprect = scale_cliprect(poly, cliprect, &scaledclip);
+	}
+
 	/* determine min/max Y vertices */
 	if (v[1]->y < v[0]->y)
 		minv = 1, maxv = 0;
@@ -925,6 +1100,7 @@ UINT32 poly_render_quad(poly_manager *poly, void *dest, const rectangle *cliprec
 		UINT32 bucketnum = ((UINT32)curscan / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
 		UINT32 unit_index = poly->unit_next++;
 		quad_work_unit *unit = &poly->unit[unit_index]->quad;
+		INT32 minx = 0x7fff, maxx = -0x8000;
 		int extnum;
 
 		/* determine how much to advance to hit the next bucket */
@@ -999,14 +1175,22 @@ UINT32 poly_render_quad(poly_manager *poly, void *dest, const rectangle *cliprec
 			unit->extent[extnum].startx = istartx;
 			unit->extent[extnum].stopx = istopx;
 			pixels += istopx - istartx;
+			/* track the horizontal coverage of the unit for tiling */
+			if (istartx < istopx)
+			{
+				minx = MIN(minx, istartx);
+				maxx = MAX(maxx, istopx);
+			}
 		}
+		unit->shared.minx = minx;
+		unit->shared.maxx = maxx;
 	}
 #if KEEP_STATISTICS
 	poly->unit_max = MAX(poly->unit_max, poly->unit_next);
 #endif
 
 	/* enqueue the work items */
-	if (poly->queue != NULL)
+	if (poly->queue != NULL && poly->tile_width == 0)
 		osd_work_item_queue_multiple(poly->queue, poly_item_callback, poly->unit_next - startunit, poly->unit[startunit], poly->unit_size, WORK_ITEM_FLAG_AUTO_RELEASE);
 
 	/* return the total number of pixels in the triangle */
@@ -1056,9 +1240,21 @@ UINT32 poly_render_polygon(poly_manager *poly, void *dest, const rectangle *clip
 	INT32 pixels = 0;
 	UINT32 startunit;
 	int vertnum;
+	poly_vertex scaledv[MAX_POLYGON_VERTS];
+	rectangle scaledclip;
 
 	assert(poly->flags & POLYFLAG_ALLOW_QUADS);
 
+	/* scale to the internal resolution; vertex 0 is done on its own so the */
+	/* compiler can see it is always written before it is read below */
+	if (poly->scale != 1)
+	{
+		scale_vertices(poly, 1, &v[0], &scaledv[0], paramcount);
+		scale_vertices(poly, numverts - 1, &v[1], &scaledv[1], paramcount);
+		v = scaledv;
+		cliprect = scale_cliprect(poly, cliprect, &scaledclip);
+	}
+
 	/* determine min/max Y vertices */
 	minv = maxv = 0;
 	for (vertnum = 1; vertnum < numverts; vertnum++)
@@ -1163,6 +1359,7 @@ UINT32 poly_render_polygon(poly_manager *poly, void *dest, const rectangle *clip
 		UINT32 bucketnum = ((UINT32)curscan / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
 		UINT32 unit_index = poly->unit_next++;
 		quad_work_unit *unit = &poly->unit[unit_index]->quad;
+		INT32 minx = 0x7fff, maxx = -0x8000;
 		int extnum;
 
 		/* determine how much to advance to hit the next bucket */
@@ -1237,14 +1434,22 @@ UINT32 poly_render_polygon(poly_manager *poly, void *dest, const rectangle *clip
 			unit->extent[extnum].startx = istartx;
 			unit->extent[extnum].stopx = istopx;
 			pixels += istopx - istartx;
+			/* track the horizontal coverage of the unit for tiling */
+			if (istartx < istopx)
+			{
+				minx = MIN(minx, istartx);
+				maxx = MAX(maxx, istopx);
+			}
 		}
+		unit->shared.minx = minx;
+		unit->shared.maxx = maxx;
 	}
 #if KEEP_STATISTICS
 	poly->unit_max = MAX(poly->unit_max, poly->unit_next);
 #endif
 
 	/* enqueue the work items */
-	if (poly->queue != NULL)
+	if (poly->queue != NULL && poly->tile_width == 0)
 		osd_work_item_queue_multiple(poly->queue, poly_item_callback, poly->unit_next - startunit, poly->unit[startunit], poly->unit_size, WORK_ITEM_FLAG_AUTO_RELEASE);
 
 	/* return the total number of pixels in the triangle */
@@ -1412,6 +1617,144 @@ static void *poly_item_callback(void *param, int threadid)
 }
 
 
+/*-------------------------------------------------
+    render_tiles - sort the pending work units
+    into strips and render them a row of tiles
+    at a time
+-------------------------------------------------*/
+
+static void render_tiles(poly_manager *poly)
+{
+	UINT32 minstrip = TOTAL_STRIPS, maxstrip = 0;
+	INT32 minx = 0x7fff, maxx = -0x8000;
+	UINT32 unitnum, strip, rownum, rows = 0;
+
+	/* find the range covered by everything pending */
+	for (unitnum = 0; unitnum < poly->unit_next; unitnum++)
+	{
+		const work_unit_shared *shared = &poly->unit[unitnum]->shared;
+		if (shared->minx < shared->maxx)
+		{
+			strip = strip_index(shared->scanline);
+			minstrip = MIN(minstrip, strip);
+			maxstrip = MAX(maxstrip, strip);
+			minx = MIN(minx, shared->minx);
+			maxx = MAX(maxx, shared->maxx);
+		}
+	}
+	if (minx >= maxx)
+		return;
+
+	/* align to whole rows and columns of tiles */
+	minstrip -= minstrip % poly->tile_strips;
+	poly->tile_minx = minx - ((minx % poly->tile_width) + poly->tile_width) % poly->tile_width;
+	poly->tile_maxx = maxx;
+
+	/* counting sort the units by strip; being stable, this keeps each strip */
+	/* in submission order so overlapping polygons still draw in sequence */
+	memset(&poly->strip_start[minstrip], 0, (maxstrip + 3 - minstrip) * sizeof(poly->strip_start[0]));
+	for (unitnum = 0; unitnum < poly->unit_next; unitnum++)
+	{
+		const work_unit_shared *shared = &poly->unit[unitnum]->shared;
+		if (shared->minx < shared->maxx)
+			poly->strip_start[strip_index(shared->scanline) + 2]++;
+	}
+	for (strip = minstrip + 1; strip <= maxstrip + 2; strip++)
+		poly->strip_start[strip] += poly->strip_start[strip - 1];
+	for (unitnum = 0; unitnum < poly->unit_next; unitnum++)
+	{
+		const work_unit_shared *shared = &poly->unit[unitnum]->shared;
+		if (shared->minx < shared->maxx)
+			poly->strip_unit[poly->strip_start[strip_index(shared->scanline) + 1]++] = unitnum;
+	}
+
+	/* build the rows of tiles */
+	for (strip = minstrip; strip <= maxstrip; strip += poly->tile_strips)
+	{
+		tile_row *row = &poly->row[rows++];
+		row->poly = poly;
+		row->firststrip = strip;
+		row->laststrip = MIN(strip + poly->tile_strips, maxstrip + 1);
+	}
+
+	/* rows never share a scanline, so they can all be rendered at once */
+	if (poly->queue != NULL)
+		osd_work_item_queue_multiple(poly->queue, poly_tile_callback, rows, poly->row, sizeof(poly->row[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+	else
+	{
+		for (rownum = 0; rownum < rows; rownum++)
+			poly_tile_callback(&poly->row[rownum], 0);
+	}
+}
+
+
+/*-------------------------------------------------
+    poly_tile_callback - callback for each row
+    of tiles
+-------------------------------------------------*/
+
+static void *poly_tile_callback(void *param, int threadid)
+{
+	const tile_row *row = (const tile_row *)param;
+	const poly_manager *poly = row->poly;
+	INT32 tilex;
+
+	/* finish each tile before moving right, so its part of the destination stays cached */
+	for (tilex = poly->tile_minx; tilex < poly->tile_maxx; tilex += poly->tile_width)
+	{
+		INT32 tilestop = tilex + poly->tile_width;
+		UINT32 strip, index;
+
+		for (strip = row->firststrip; strip < row->laststrip; strip++)
+			for (index = poly->strip_start[strip]; index < poly->strip_start[strip + 1]; index++)
+			{
+				const work_unit *unit = poly->unit[poly->strip_unit[index]];
+				const polygon_info *polygon = unit->shared.polygon;
+				int count = unit->shared.count_next & 0xffff;
+				int curscan;
+
+				/* skip units that miss this tile entirely */
+				if (unit->shared.minx >= tilestop || unit->shared.maxx <= tilex)
+					continue;
+
+				/* iterate over extents, clipped to the tile */
+				for (curscan = 0; curscan < count; curscan++)
+				{
+					poly_extent tmpextent;
+
+					if (polygon->numverts == 3)
+					{
+						tri_extent clipped = unit->tri.extent[curscan];
+						clipped.startx = MAX(clipped.startx, tilex);
+						clipped.stopx = MIN(clipped.stopx, tilestop);
+						if (clipped.startx >= clipped.stopx)
+							continue;
+						convert_tri_extent_to_poly_extent(&tmpextent, &clipped, polygon, unit->shared.scanline + curscan);
+					}
+					else
+					{
+						const poly_extent *extent = &unit->quad.extent[curscan];
+						int paramnum;
+
+						tmpextent = *extent;
+						if (extent->startx < tilex)
+						{
+							for (paramnum = 0; paramnum < polygon->numparams; paramnum++)
+								tmpextent.param[paramnum].start += (tilex - extent->startx) * extent->param[paramnum].dpdx;
+							tmpextent.startx = tilex;
+						}
+						tmpextent.stopx = MIN(extent->stopx, tilestop);
+						if (tmpextent.startx >= tmpextent.stopx)
+							continue;
+					}
+					(*polygon->callback)(polygon->dest, unit->shared.scanline + curscan, &tmpextent, polygon->extra, threadid);
+				}
+			}
+	}
+	return NULL;
+}
+
+
 /*-------------------------------------------------
     poly_state_presave - pre-save callback to
     ensure everything is synced before saving
@@ -28,6 +28,29 @@
         +---------------+---------------+---------------+
     (0.0,2.0)       (1.0,2.0)       (2.0,2.0)       (3.0,2.0)
 
+    Tiling:
+
+    By default each polygon is split into work units of up to 8 scanlines
+    that are queued as soon as the polygon is set up. A manager created
+    with poly_alloc_tiled() instead holds on to the work units until
+    poly_wait(), sorts them into strips, and renders each row of tiles
+    as a single work item, finishing one tile before moving on to the
+    next. Within a scanline, polygons are still drawn in the order they
+    were submitted. The extents passed to the scanline callback are
+    clipped to the tile, so callbacks must derive everything from
+    extent->startx and the parameter start values, as all of the
+    existing ones do. Tile heights are rounded up to a multiple of 8.
+
+    Scaling:
+
+    poly_set_scale() makes the manager multiply the X/Y coordinates of
+    every vertex and the cliprect by an integer factor before setting
+    up a polygon, so a driver can render into a destination that many
+    times larger than its native resolution without touching its own
+    geometry code. Parameters are left alone; their gradients shrink
+    with the larger extents. poly_render_triangle_custom() is given
+    extents rather than vertices and is never scaled.
+
 ***************************************************************************/
 
 #pragma once
@@ -104,6 +127,9 @@ typedef void (*poly_draw_scanline_func)(void *dest, INT32 scanline, const poly_e
 /* allocate a new poly manager that can render triangles */
 poly_manager *poly_alloc(running_machine *machine, int max_polys, size_t extra_data_size, UINT8 flags);
 
+/* allocate a poly manager that defers rendering until poly_wait, then renders tile by tile */
+poly_manager *poly_alloc_tiled(running_machine *machine, int max_polys, size_t extra_data_size, UINT8 flags, int tilewidth, int tileheight);
+
 /* free a poly manager */
 void poly_free(poly_manager *poly);
 
@@ -117,6 +143,12 @@ void poly_wait(poly_manager *poly, const char *debug_reason);
 /* get a pointer to the extra data for the next polygon */
 void *poly_get_extra_data(poly_manager *poly);
 
+/* render subsequent polygons at 'scale' times the resolution of their vertices and cliprects */
+void poly_set_scale(poly_manager *poly, int scale);
+
+/* return the current rendering scale */
+int poly_get_scale(poly_manager *poly);
+
 
 
 /* ----- core triangle rendering ----- */
@@ -1367,6 +1367,9 @@ struct _voodoo_stats
 	UINT8				display;				/* display stats? */
 	INT32				swaps;					/* total swaps */
 	INT32				stalls;					/* total stalls */
+	INT32				syncs;					/* waits for pending rendering */
+	osd_ticks_t			sync_ticks;				/* host time spent in those waits */
+	INT32				syncs_skipped;			/* state writes that didn't change anything */
 	INT32				total_triangles;		/* total triangles */
 	INT32				total_pixels_in;		/* total pixels in */
 	INT32				total_pixels_out;		/* total pixels out */
@@ -222,9 +222,7 @@ static void dump_rasterizer_stats(voodoo_state *v);
 
 /* generic rasterizers */
 static void raster_fastfill(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
-static void raster_generic_0tmu(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
-static void raster_generic_1tmu(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
-static void raster_generic_2tmu(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
+static poly_draw_scanline_func find_generic_rasterizer(const raster_info *info, int texcount);
 
 
 
@@ -266,6 +264,41 @@ static const raster_info predef_raster_table[] =
     INLINE FUNCTIONS
 ***************************************************************************/
 
+/*-------------------------------------------------
+    wait_for_rendering - wait for all pending
+    rendering to complete, tracking how often and
+    for how long we have to
+-------------------------------------------------*/
+
+INLINE void wait_for_rendering(voodoo_state *v, const char *reason)
+{
+	osd_ticks_t start = osd_ticks();
+
+	poly_wait(v->poly, reason);
+	v->stats.syncs++;
+	v->stats.sync_ticks += osd_ticks() - start;
+}
+
+
+/*-------------------------------------------------
+    register_changes - return TRUE if writing a
+    value to a register on the selected chips
+    would change any of them; rewriting the same
+    state doesn't need to wait for rendering
+-------------------------------------------------*/
+
+INLINE int register_changes(voodoo_state *v, int chips, offs_t regnum, UINT32 data)
+{
+	if (((chips & 1) && v->reg[0x000 + regnum].u != data) ||
+		((chips & 2) && v->reg[0x100 + regnum].u != data) ||
+		((chips & 4) && v->reg[0x200 + regnum].u != data) ||
+		((chips & 8) && v->reg[0x300 + regnum].u != data))
+		return TRUE;
+	v->stats.syncs_skipped++;
+	return FALSE;
+}
+
+
 /*-------------------------------------------------
     get_safe_token - makes sure that the passed
     in device is, in fact, a voodoo device
@@ -902,6 +935,9 @@ static void swap_buffers(voodoo_state *v)
 		statsptr += sprintf(statsptr, "Swap:%6d\n", v->stats.swaps);
 		statsptr += sprintf(statsptr, "Hist:%08X\n", v->reg[fbiSwapHistory].u);
 		statsptr += sprintf(statsptr, "Stal:%6d\n", v->stats.stalls);
+		statsptr += sprintf(statsptr, "Sync:%6d\n", v->stats.syncs);
+		statsptr += sprintf(statsptr, "SyMs:%6d\n", (int)(v->stats.sync_ticks * 1000 / osd_ticks_per_second()));
+		statsptr += sprintf(statsptr, "SySk:%6d\n", v->stats.syncs_skipped);
 		statsptr += sprintf(statsptr, "Rend:%6d%%\n", pixelcount * 100 / screen_area);
 		statsptr += sprintf(statsptr, "Poly:%6d\n", v->stats.total_triangles);
 		statsptr += sprintf(statsptr, "PxIn:%6d\n", v->stats.total_pixels_in);
@@ -925,6 +961,9 @@ static void swap_buffers(voodoo_state *v)
 
 	/* update statistics */
 	v->stats.stalls = 0;
+	v->stats.syncs = 0;
+	v->stats.sync_ticks = 0;
+	v->stats.syncs_skipped = 0;
 	v->stats.total_triangles = 0;
 	v->stats.total_pixels_in = 0;
 	v->stats.total_pixels_out = 0;
@@ -2344,23 +2383,26 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 
 		/* mask off invalid bits for different cards */
 		case fbzColorPath:
-			poly_wait(v->poly, v->regnames[regnum]);
 			if (v->type < VOODOO_2)
 				data &= 0x0fffffff;
+			if (register_changes(v, chips & 1, regnum, data))
+				wait_for_rendering(v, v->regnames[regnum]);
 			if (chips & 1) v->reg[fbzColorPath].u = data;
 			break;
 
 		case fbzMode:
-			poly_wait(v->poly, v->regnames[regnum]);
 			if (v->type < VOODOO_2)
 				data &= 0x001fffff;
+			if (register_changes(v, chips & 1, regnum, data))
+				wait_for_rendering(v, v->regnames[regnum]);
 			if (chips & 1) v->reg[fbzMode].u = data;
 			break;
 
 		case fogMode:
-			poly_wait(v->poly, v->regnames[regnum]);
 			if (v->type < VOODOO_2)
 				data &= 0x0000003f;
+			if (register_changes(v, chips & 1, regnum, data))
+				wait_for_rendering(v, v->regnames[regnum]);
 			if (chips & 1) v->reg[fogMode].u = data;
 			break;
 
@@ -2387,7 +2429,7 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 
 		/* other commands */
 		case nopCMD:
-			poly_wait(v->poly, v->regnames[regnum]);
+			wait_for_rendering(v, v->regnames[regnum]);
 			if (data & 1)
 				reset_counters(v);
 			if (data & 2)
@@ -2399,12 +2441,12 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 			break;
 
 		case swapbufferCMD:
-			poly_wait(v->poly, v->regnames[regnum]);
+			wait_for_rendering(v, v->regnames[regnum]);
 			cycles = swapbuffer(v, data);
 			break;
 
 		case userIntrCMD:
-			poly_wait(v->poly, v->regnames[regnum]);
+			wait_for_rendering(v, v->regnames[regnum]);
 			fatalerror("userIntrCMD");
 			break;
 
@@ -2412,7 +2454,7 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 		case clutData:
 			if (v->type <= VOODOO_2 && (chips & 1))
 			{
-				poly_wait(v->poly, v->regnames[regnum]);
+				wait_for_rendering(v, v->regnames[regnum]);
 				if (!FBIINIT1_VIDEO_TIMING_RESET(v->reg[fbiInit1].u))
 				{
 					int index = data >> 24;
@@ -2431,7 +2473,7 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 		case dacData:
 			if (v->type <= VOODOO_2 && (chips & 1))
 			{
-				poly_wait(v->poly, v->regnames[regnum]);
+				wait_for_rendering(v, v->regnames[regnum]);
 				if (!(data & 0x800))
 					dacdata_w(&v->dac, (data >> 8) & 7, data & 0xff);
 				else
@@ -2446,7 +2488,7 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 		case videoDimensions:
 			if (v->type <= VOODOO_2 && (chips & 1))
 			{
-				poly_wait(v->poly, v->regnames[regnum]);
+				wait_for_rendering(v, v->regnames[regnum]);
 				v->reg[regnum].u = data;
 				if (v->reg[hSync].u != 0 && v->reg[vSync].u != 0 && v->reg[videoDimensions].u != 0)
 				{
@@ -2524,7 +2566,7 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 
 		/* fbiInit0 can only be written if initEnable says we can -- Voodoo/Voodoo2 only */
 		case fbiInit0:
-			poly_wait(v->poly, v->regnames[regnum]);
+			wait_for_rendering(v, v->regnames[regnum]);
 			if (v->type <= VOODOO_2 && (chips & 1) && INITEN_ENABLE_HW_INIT(v->pci.init_enable))
 			{
 				v->reg[fbiInit0].u = data;
@@ -2548,7 +2590,7 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 		case fbiInit1:
 		case fbiInit2:
 		case fbiInit4:
-			poly_wait(v->poly, v->regnames[regnum]);
+			wait_for_rendering(v, v->regnames[regnum]);
 			if (v->type <= VOODOO_2 && (chips & 1) && INITEN_ENABLE_HW_INIT(v->pci.init_enable))
 			{
 				v->reg[regnum].u = data;
@@ -2558,7 +2600,7 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 			break;
 
 		case fbiInit3:
-			poly_wait(v->poly, v->regnames[regnum]);
+			wait_for_rendering(v, v->regnames[regnum]);
 			if (v->type <= VOODOO_2 && (chips & 1) && INITEN_ENABLE_HW_INIT(v->pci.init_enable))
 			{
 				v->reg[regnum].u = data;
@@ -2572,7 +2614,7 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 /*      case swapPending: -- Banshee */
 			if (v->type == VOODOO_2 && (chips & 1) && INITEN_ENABLE_HW_INIT(v->pci.init_enable))
 			{
-				poly_wait(v->poly, v->regnames[regnum]);
+				wait_for_rendering(v, v->regnames[regnum]);
 				v->reg[regnum].u = data;
 				v->fbi.cmdfifo[0].enable = FBIINIT7_CMDFIFO_ENABLE(data);
 				v->fbi.cmdfifo[0].count_holes = !FBIINIT7_DISABLE_CMDFIFO_HOLES(data);
@@ -2585,7 +2627,7 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 		case cmdFifoBaseAddr:
 			if (v->type == VOODOO_2 && (chips & 1))
 			{
-				poly_wait(v->poly, v->regnames[regnum]);
+				wait_for_rendering(v, v->regnames[regnum]);
 				v->reg[regnum].u = data;
 				v->fbi.cmdfifo[0].base = (data & 0x3ff) << 12;
 				v->fbi.cmdfifo[0].end = (((data >> 16) & 0x3ff) + 1) << 12;
@@ -2661,7 +2703,7 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 		case nccTable+9:
 		case nccTable+10:
 		case nccTable+11:
-			poly_wait(v->poly, v->regnames[regnum]);
+			wait_for_rendering(v, v->regnames[regnum]);
 			if (chips & 2) ncc_table_write(&v->tmu[0].ncc[0], regnum - nccTable, data);
 			if (chips & 4) ncc_table_write(&v->tmu[1].ncc[0], regnum - nccTable, data);
 			break;
@@ -2678,7 +2720,7 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 		case nccTable+21:
 		case nccTable+22:
 		case nccTable+23:
-			poly_wait(v->poly, v->regnames[regnum]);
+			wait_for_rendering(v, v->regnames[regnum]);
 			if (chips & 2) ncc_table_write(&v->tmu[0].ncc[1], regnum - (nccTable+12), data);
 			if (chips & 4) ncc_table_write(&v->tmu[1].ncc[1], regnum - (nccTable+12), data);
 			break;
@@ -2716,7 +2758,7 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 		case fogTable+29:
 		case fogTable+30:
 		case fogTable+31:
-			poly_wait(v->poly, v->regnames[regnum]);
+			wait_for_rendering(v, v->regnames[regnum]);
 			if (chips & 1)
 			{
 				int base = 2 * (regnum - fogTable);
@@ -2735,7 +2777,9 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 		case texBaseAddr_1:
 		case texBaseAddr_2:
 		case texBaseAddr_3_8:
-			poly_wait(v->poly, v->regnames[regnum]);
+			if (!register_changes(v, chips & 6, regnum, data))
+				break;
+			wait_for_rendering(v, v->regnames[regnum]);
 			if (chips & 2)
 			{
 				v->tmu[0].reg[regnum].u = data;
@@ -2759,7 +2803,8 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 		case color0:
 		case clipLowYHighY:
 		case clipLeftRight:
-			poly_wait(v->poly, v->regnames[regnum]);
+			if (register_changes(v, chips, regnum, data))
+				wait_for_rendering(v, v->regnames[regnum]);
 			/* fall through to default implementation */
 
 		/* by default, just feed the data to the chips */
@@ -3022,7 +3067,7 @@ static INT32 lfb_w(voodoo_state *v, offs_t offset, UINT32 data, UINT32 mem_mask,
 	depthmax = (v->fbi.mask + 1 - v->fbi.auxoffs) / 2;
 
 	/* wait for any outstanding work to finish */
-	poly_wait(v->poly, "LFB Write");
+	wait_for_rendering(v, "LFB Write");
 
 	/* simple case: no pipeline */
 	if (!LFBMODE_ENABLE_PIXEL_PIPELINE(v->reg[lfbMode].u))
@@ -3177,7 +3222,7 @@ static INT32 texture_w(voodoo_state *v, offs_t offset, UINT32 data)
 		fatalerror("Texture direct write!");
 
 	/* wait for any outstanding work to finish */
-	poly_wait(v->poly, "Texture write");
+	wait_for_rendering(v, "Texture write");
 
 	/* update texture info if dirty */
 	if (t->regdirty)
@@ -3822,7 +3867,7 @@ static UINT32 lfb_r(voodoo_state *v, offs_t offset, int forcefront)
 		return 0xffffffff;
 
 	/* wait for any outstanding work to finish */
-	poly_wait(v->poly, "LFB read");
+	wait_for_rendering(v, "LFB read");
 
 	/* compute the data */
 	data = buffer[bufoffs + 0] | (buffer[bufoffs + 1] << 16);
@@ -4834,7 +4879,7 @@ static INT32 triangle(voodoo_state *v)
 	}
 
 	/* wait for any outstanding work to finish */
-//  poly_wait(v->poly, "triangle");
+//  wait_for_rendering(v, "triangle");
 
 	/* determine the draw buffer */
 	destbuf = (v->type >= VOODOO_BANSHEE) ? 1 : FBZMODE_DRAW_BUFFER(v->reg[fbzMode].u);
@@ -5240,7 +5285,7 @@ static raster_info *find_rasterizer(voodoo_state *v, int texcount)
 		}
 
 	/* generate a new one using the generic entry */
-	curinfo.callback = (texcount == 0) ? raster_generic_0tmu : (texcount == 1) ? raster_generic_1tmu : raster_generic_2tmu;
+	curinfo.callback = find_generic_rasterizer(&curinfo, texcount);
 	curinfo.is_generic = TRUE;
 	curinfo.display = 0;
 	curinfo.polys = 0;
@@ -5356,27 +5401,63 @@ static void raster_fastfill(void *destbase, INT32 y, const poly_extent *extent,
 
 
 /*-------------------------------------------------
-    generic_0tmu - generic rasterizer for 0 TMUs
+    generic rasterizers - each TMU count gets
+    one generic rasterizer per combination of
+    the depth buffer, alpha blend and fog
+    enables; those bits are forced to constants
+    so the compiler drops the unused half of
+    each test, while everything else is still
+    read from the registers
 -------------------------------------------------*/
 
-RASTERIZER(generic_0tmu, 0, v->reg[fbzColorPath].u, v->reg[fbzMode].u, v->reg[alphaMode].u,
-			v->reg[fogMode].u, 0, 0)
+#define GENERIC_FBZMODE(variant)		((v->reg[fbzMode].u & ~0x10) | (((variant) & 1) << 4))
+#define GENERIC_ALPHAMODE(variant)		((v->reg[alphaMode].u & ~0x10) | (((variant) & 2) << 3))
+#define GENERIC_FOGMODE(variant)		((v->reg[fogMode].u & ~0x01) | (((variant) >> 2) & 1))
+
+#define GENERIC_RASTERIZER(tmus, variant, TEXMODE0, TEXMODE1) \
+	RASTERIZER(generic_##tmus##tmu_##variant, tmus, v->reg[fbzColorPath].u, GENERIC_FBZMODE(variant), \
+				GENERIC_ALPHAMODE(variant), GENERIC_FOGMODE(variant), TEXMODE0, TEXMODE1)
+
+#define GENERIC_RASTERIZERS(tmus, TEXMODE0, TEXMODE1) \
+	GENERIC_RASTERIZER(tmus, 0, TEXMODE0, TEXMODE1) \
+	GENERIC_RASTERIZER(tmus, 1, TEXMODE0, TEXMODE1) \
+	GENERIC_RASTERIZER(tmus, 2, TEXMODE0, TEXMODE1) \
+	GENERIC_RASTERIZER(tmus, 3, TEXMODE0, TEXMODE1) \
+	GENERIC_RASTERIZER(tmus, 4, TEXMODE0, TEXMODE1) \
+	GENERIC_RASTERIZER(tmus, 5, TEXMODE0, TEXMODE1) \
+	GENERIC_RASTERIZER(tmus, 6, TEXMODE0, TEXMODE1) \
+	GENERIC_RASTERIZER(tmus, 7, TEXMODE0, TEXMODE1)
+
+GENERIC_RASTERIZERS(0, 0, 0)
+GENERIC_RASTERIZERS(1, v->tmu[0].reg[textureMode].u, 0)
+GENERIC_RASTERIZERS(2, v->tmu[0].reg[textureMode].u, v->tmu[1].reg[textureMode].u)
+
+#define GENERIC_RASTERIZER_TABLE(tmus) \
+	{ raster_generic_##tmus##tmu_0, raster_generic_##tmus##tmu_1, raster_generic_##tmus##tmu_2, raster_generic_##tmus##tmu_3, \
+	  raster_generic_##tmus##tmu_4, raster_generic_##tmus##tmu_5, raster_generic_##tmus##tmu_6, raster_generic_##tmus##tmu_7 }
+
+static const poly_draw_scanline_func generic_rasterizer[3][8] =
+{
+	GENERIC_RASTERIZER_TABLE(0),
+	GENERIC_RASTERIZER_TABLE(1),
+	GENERIC_RASTERIZER_TABLE(2)
+};
 
 
 /*-------------------------------------------------
-    generic_1tmu - generic rasterizer for 1 TMU
+    find_generic_rasterizer - pick the generic
+    rasterizer matching the enables in the
+    given state
 -------------------------------------------------*/
 
-RASTERIZER(generic_1tmu, 1, v->reg[fbzColorPath].u, v->reg[fbzMode].u, v->reg[alphaMode].u,
-			v->reg[fogMode].u, v->tmu[0].reg[textureMode].u, 0)
-
-
-/*-------------------------------------------------
-    generic_2tmu - generic rasterizer for 2 TMUs
--------------------------------------------------*/
+static poly_draw_scanline_func find_generic_rasterizer(const raster_info *info, int texcount)
+{
+	int variant = FBZMODE_ENABLE_DEPTHBUF(info->eff_fbz_mode) |
+				(ALPHAMODE_ALPHABLEND(info->eff_alpha_mode) << 1) |
+				(FOGMODE_ENABLE_FOG(info->eff_fog_mode) << 2);
 
-RASTERIZER(generic_2tmu, 2, v->reg[fbzColorPath].u, v->reg[fbzMode].u, v->reg[alphaMode].u,
-			v->reg[fogMode].u, v->tmu[0].reg[textureMode].u, v->tmu[1].reg[textureMode].u)
+	return generic_rasterizer[texcount][variant];
+}
 
 
 #else
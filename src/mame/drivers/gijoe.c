@@ -302,7 +302,7 @@ static MACHINE_DRIVER_START( gijoe )
 	MDRV_NVRAM_HANDLER(gijoe)
 
 	/* video hardware */
-	MDRV_VIDEO_ATTRIBUTES(VIDEO_HAS_SHADOWS | VIDEO_UPDATE_BEFORE_VBLANK)
+	MDRV_VIDEO_ATTRIBUTES(VIDEO_HAS_SHADOWS | VIDEO_UPDATE_BEFORE_VBLANK | VIDEO_NEEDS_GFXDATA)	/* K056832 linemap reads gfxdata as one array */
 
 	MDRV_SCREEN_ADD("screen", RASTER)
 	MDRV_SCREEN_REFRESH_RATE(60)
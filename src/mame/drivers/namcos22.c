@@ -2889,6 +2889,7 @@ static MACHINE_DRIVER_START( namcos22s )
 	MDRV_SCREEN_SIZE(NAMCOS22_NUM_COLS*16,NAMCOS22_NUM_ROWS*16)
 	MDRV_SCREEN_VISIBLE_AREA(0,NAMCOS22_NUM_COLS*16-1,0,NAMCOS22_NUM_ROWS*16-1)
 
+	MDRV_VIDEO_ATTRIBUTES(VIDEO_NEEDS_GFXDATA)	/* texture tiles are sampled straight from gfxdata */
 	MDRV_PALETTE_LENGTH(NAMCOS22_PALETTE_SIZE)
 	MDRV_GFXDECODE(super)
 	MDRV_VIDEO_START(namcos22s)
@@ -3302,6 +3303,7 @@ static MACHINE_DRIVER_START( namcos22 )
 	MDRV_SCREEN_SIZE(NAMCOS22_NUM_COLS*16,NAMCOS22_NUM_ROWS*16)
 	MDRV_SCREEN_VISIBLE_AREA(0,NAMCOS22_NUM_COLS*16-1,0,NAMCOS22_NUM_ROWS*16-1)
 
+	MDRV_VIDEO_ATTRIBUTES(VIDEO_NEEDS_GFXDATA)	/* texture tiles are sampled straight from gfxdata */
 	MDRV_PALETTE_LENGTH(NAMCOS22_PALETTE_SIZE)
 	MDRV_GFXDECODE(namcos22)
 	MDRV_VIDEO_START(namcos22)
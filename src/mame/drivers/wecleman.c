@@ -1106,6 +1106,7 @@ static MACHINE_DRIVER_START( wecleman )
 	MDRV_SCREEN_SIZE(320 +16, 224 +16)
 	MDRV_SCREEN_VISIBLE_AREA(0 +8, 320-1 +8, 0 +8, 224-1 +8)
 
+	MDRV_VIDEO_ATTRIBUTES(VIDEO_NEEDS_GFXDATA)	/* VIDEO_START patches a decoded tile in place */
 	MDRV_GFXDECODE(wecleman)
 
 	MDRV_PALETTE_LENGTH(2048)
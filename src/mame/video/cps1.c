@@ -1456,6 +1456,12 @@ static int pri_ctrl;				/* Sprite layer priorities */
 static int cps2_objram_bank;
 static int cps2_last_sprite_offset;     /* Offset of the last sprite */
 
+/* sprites are collected and drawn in batches, in the same order */
+#define CPS2_MAX_BATCHED_SPRITES	1024
+static gfx_sprite_batch *cps2_sprite_batch;
+static gfx_sprite cps2_sprite_list[CPS2_MAX_BATCHED_SPRITES];
+static int cps2_sprite_count;
+
 #define CPS2_OBJ_BASE	0x00	/* Unknown (not base address of objects). Could be bass address of bank used when object swap bit set? */
 #define CPS2_OBJ_UK1	0x02	/* Unknown (nearly always 0x807d, or 0x808e when screen flipped) */
 #define CPS2_OBJ_PRI	0x04	/* Layers priorities */
@@ -2098,10 +2104,20 @@ VIDEO_START( cps1 )
 	VIDEO_START_CALL(cps);
 }
 
+static void cps2_video_exit(running_machine *machine)
+{
+	gfx_sprite_batch_free(cps2_sprite_batch);
+	cps2_sprite_batch = NULL;
+}
+
 VIDEO_START( cps2 )
 {
 	cps_version=2;
 	VIDEO_START_CALL(cps);
+
+	cps2_sprite_batch = gfx_sprite_batch_alloc(machine, CPS2_MAX_BATCHED_SPRITES, GFX_SPRITE_BATCH_BANDED);
+	cps2_sprite_count = 0;
+	add_exit_callback(machine, cps2_video_exit);
 }
 
 /***************************************************************************
@@ -2446,24 +2462,37 @@ static void cps2_find_last_sprite(void)    /* Find the offset of last sprite */
 #undef DRAWSPRITE
 }
 
+static void cps2_flush_sprites(running_machine *machine, bitmap_t *bitmap,const rectangle *cliprect)
+{
+	gfx_sprite_batch_pdraw_transpen(cps2_sprite_batch,bitmap,cliprect,cps2_sprite_list,cps2_sprite_count,machine->priority_bitmap,15);
+	cps2_sprite_count = 0;
+}
+
 static void cps2_render_sprites(running_machine *machine, bitmap_t *bitmap,const rectangle *cliprect,int *primasks)
 {
 #define DRAWSPRITE(CODE,COLOR,FLIPX,FLIPY,SX,SY)									\
 {																					\
-	if (flip_screen_get(machine))															\
-		pdrawgfx_transpen(bitmap,\
-				cliprect,machine->gfx[2],											\
-				CODE,																\
-				COLOR,																\
-				!(FLIPX),!(FLIPY),													\
-				511-16-(SX),255-16-(SY),											machine->priority_bitmap,primasks[priority],15);					\
+	gfx_sprite *sprite = &cps2_sprite_list[cps2_sprite_count++];					\
+	sprite->gfx = machine->gfx[2];													\
+	sprite->code = CODE;															\
+	sprite->color = COLOR;															\
+	sprite->pmask = primasks[priority];												\
+	if (flip_screen_get(machine))													\
+	{																				\
+		sprite->flipx = !(FLIPX);													\
+		sprite->flipy = !(FLIPY);													\
+		sprite->destx = 511-16-(SX);												\
+		sprite->desty = 255-16-(SY);												\
+	}																				\
 	else																			\
-		pdrawgfx_transpen(bitmap,\
-				cliprect,machine->gfx[2],											\
-				CODE,																\
-				COLOR,																\
-				FLIPX,FLIPY,														\
-				SX,SY,																machine->priority_bitmap,primasks[priority],15);					\
+	{																				\
+		sprite->flipx = ((FLIPX) != 0);												\
+		sprite->flipy = ((FLIPY) != 0);												\
+		sprite->destx = SX;															\
+		sprite->desty = SY;															\
+	}																				\
+	if (cps2_sprite_count == CPS2_MAX_BATCHED_SPRITES)								\
+		cps2_flush_sprites(machine,bitmap,cliprect);								\
 }
 
 	int i;
@@ -2588,6 +2617,11 @@ static void cps2_render_sprites(running_machine *machine, bitmap_t *bitmap,const
 					(x+xoffs) & 0x3ff,(y+yoffs) & 0x3ff);
 		}
 	}
+
+	/* draw whatever is left in the batch */
+	if (cps2_sprite_count != 0)
+		cps2_flush_sprites(machine,bitmap,cliprect);
+#undef DRAWSPRITE
 }
 
 
@@ -6466,6 +6466,9 @@ static int K056832_update_linemap(running_machine *machine, bitmap_t *bitmap, in
             we REALLY shouldn't be writing directly back into the pixmap, surely this should
             be done when rendering instead
 
+            it also walks pen_data past the end of a single tile, so any driver that enables
+            the linemap must set VIDEO_NEEDS_GFXDATA to keep the gfx out of the decode pool
+
         */
 		{
 
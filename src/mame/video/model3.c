@@ -2,6 +2,7 @@
 #include "video/poly.h"
 #include "video/rgbutil.h"
 #include "eminline.h"
+#include "profiler.h"
 #include <math.h>
 #include "includes/model3.h"
 
@@ -39,9 +40,23 @@ struct _cached_texture
 	UINT8		height;
 	UINT8		format;
 	UINT8		alpha;
+	UINT8		dirty;			/* texture RAM under it was written since it was decoded */
+	UINT32		hash;			/* hash of the texture RAM it was decoded from */
+	UINT32		lastused;		/* frame it was last drawn in */
 	rgb_t		data[1];
 };
 
+typedef struct _texture_cache_stats texture_cache_stats;
+struct _texture_cache_stats
+{
+	UINT32		hits;			/* lookups that found a clean texture */
+	UINT32		rehits;			/* lookups of rewritten textures whose data hadn't changed */
+	UINT32		misses;			/* lookups that had to decode */
+	UINT32		evictions;		/* textures freed to stay within the budget */
+	UINT32		bytes;			/* decoded bytes currently held */
+	UINT32		maxbytes;		/* peak of the above */
+};
+
 typedef struct _poly_extra_data poly_extra_data;
 struct _poly_extra_data
 {
@@ -60,6 +75,10 @@ struct _poly_extra_data
 
 #define MAX_TRIANGLES		131072
 
+/* decoded textures are 8x the size of their source; once the cache */
+/* holds more than this, textures not drawn in the last frame are freed */
+#define TEXTURE_CACHE_BUDGET	(16 * 1024 * 1024)
+
 
 /* forward declarations */
 static void real3d_traverse_display_list(void);
@@ -74,6 +93,7 @@ static void traverse_list(UINT32 address);
 static void draw_block(UINT32 address);
 static void draw_viewport(int pri, UINT32 address);
 static void invalidate_texture(int page, int texx, int texy, int texwidth, int texheight);
+static void free_textures(UINT32 keepframe);
 
 /*****************************************************************************/
 
@@ -103,7 +123,9 @@ static UINT16 *pal_lookup;
 static int real3d_display_list = 0;
 
 static bitmap_t *bitmap3d;
+static bitmap_t *render3d;
 static bitmap_t *zbuffer;
+static int render_scale;
 static rectangle clip3d;
 static rectangle *screen_clip;
 
@@ -114,6 +136,8 @@ static float ambient_light_intensity;
 
 static poly_manager *poly;
 static cached_texture *texcache[2][1024/32][2048/32];
+static texture_cache_stats texstats;
+static UINT32 texture_frame;
 
 
 static int list_depth = 0;
@@ -157,8 +181,9 @@ static UINT32 matrix_base_address;
 
 static void model3_exit(running_machine *machine)
 {
-	invalidate_texture(0, 0, 0, 6, 5);
-	invalidate_texture(1, 0, 0, 6, 5);
+	mame_printf_verbose("Model 3 texture cache: %u hits, %u unchanged rewrites, %u decodes, %u evictions, %u KB peak\n",
+			texstats.hits, texstats.rehits, texstats.misses, texstats.evictions, texstats.maxbytes / 1024);
+	free_textures(~0);
 	poly_free(poly);
 }
 
@@ -166,13 +191,21 @@ VIDEO_START( model3 )
 {
 	int width, height;
 
-	poly = poly_alloc(machine, 4000, sizeof(poly_extra_data), 0);
+	/* with -polyscale, the 3D is rendered into a larger bitmap and filtered down into bitmap3d */
+	render_scale = options_get_int(mame_options(), OPTION_POLYSCALE);
+	render_scale = MAX(1, MIN(render_scale, 4));
+
+	poly = poly_alloc_tiled(machine, 4000, sizeof(poly_extra_data), 0, 64, 16);
+	poly_set_scale(poly, render_scale);
 	add_exit_callback(machine, model3_exit);
 
 	width = video_screen_get_width(machine->primary_screen);
 	height = video_screen_get_height(machine->primary_screen);
 	bitmap3d = video_screen_auto_bitmap_alloc(machine->primary_screen);
-	zbuffer = auto_bitmap_alloc(machine, width, height, BITMAP_FORMAT_INDEXED32);
+	render3d = bitmap3d;
+	if (render_scale > 1)
+		render3d = auto_bitmap_alloc(machine, width * render_scale, height * render_scale, bitmap3d->format);
+	zbuffer = auto_bitmap_alloc(machine, width * render_scale, height * render_scale, BITMAP_FORMAT_INDEXED32);
 
 	m3_char_ram = auto_alloc_array_clear(machine, UINT64, 0x100000/8);
 	m3_tile_ram = auto_alloc_array_clear(machine, UINT64, 0x8000/8);
@@ -546,42 +579,129 @@ READ64_HANDLER( model3_palette_r )
 */
 static void invalidate_texture(int page, int texx, int texy, int texwidth, int texheight)
 {
-	int wtiles = 1 << texwidth;
-	int htiles = 1 << texheight;
+	int xend = MIN(texx + (1 << texwidth), 2048/32);
+	int yend = MIN(texy + (1 << texheight), 1024/32);
 	int x, y;
 
-	for (y = 0; y < htiles; y++)
-		for (x = 0; x < wtiles; x++)
-			while (texcache[page][texy + y][texx + x] != NULL)
+	/* mark every texture overlapping the written area; the ones starting */
+	/* up or left of it can reach into it too, so look back from the origin */
+	for (y = 0; y < yend; y++)
+		for (x = 0; x < xend; x++)
+		{
+			cached_texture *tex;
+
+			for (tex = texcache[page][y][x]; tex != NULL; tex = tex->next)
+				if (x + (1 << tex->width) > texx && y + (1 << tex->height) > texy)
+					tex->dirty = TRUE;
+		}
+}
+
+/*
+    free cached textures not drawn in the given frame (~0 frees them all);
+    only safe when no polygons referencing them are pending
+*/
+static void free_textures(UINT32 keepframe)
+{
+	int page, x, y;
+
+	for (page = 0; page < 2; page++)
+		for (y = 0; y < 1024/32; y++)
+			for (x = 0; x < 2048/32; x++)
 			{
-				cached_texture *freeme = texcache[page][texy + y][texx + x];
-				texcache[page][texy + y][texx + x] = freeme->next;
-				free(freeme);
+				cached_texture **texptr = &texcache[page][y][x];
+
+				while (*texptr != NULL)
+				{
+					cached_texture *freeme = *texptr;
+
+					if (freeme->lastused == keepframe)
+					{
+						texptr = &freeme->next;
+						continue;
+					}
+					*texptr = freeme->next;
+					texstats.bytes -= (2 * (32 << freeme->width) * 2 * (32 << freeme->height)) * sizeof(rgb_t);
+					if (keepframe != ~0)
+						texstats.evictions++;
+					free(freeme);
+				}
 			}
 }
 
+/*
+    hash the texture RAM a texture decodes from; formats 4 and 5 pack two
+    texels per word so they only read half as many words per line
+*/
+static UINT32 hash_texture(int page, int texx, int texy, int texwidth, int texheight, int format)
+{
+	int pixheight = 32 << texheight;
+	int words = (format == 4 || format == 5) ? (16 << texwidth) : (32 << texwidth);
+	UINT32 hash = 2166136261U;
+	int x, y;
+
+	for (y = 0; y < pixheight; y++)
+	{
+		const UINT16 *texsrc = &texture_ram[page][(texy * 32 + y) * 2048 + texx * 32];
+
+		for (x = 0; x < words; x++)
+			hash = (hash ^ texsrc[x]) * 16777619U;
+	}
+	return hash;
+}
+
 static cached_texture *get_texture(int page, int texx, int texy, int texwidth, int texheight, int format)
 {
-	cached_texture *tex = texcache[page][texy][texx];
+	cached_texture *tex;
 	int pixheight = 32 << texheight;
 	int pixwidth = 32 << texwidth;
 	UINT32 alpha = ~0;
+	UINT32 hash;
 	int x, y;
 
 	/* if we have one already, validate it */
 	for (tex = texcache[page][texy][texx]; tex != NULL; tex = tex->next)
 		if (tex->width == texwidth && tex->height == texheight && tex->format == format)
-			return tex;
+			break;
 
-	/* create a new texture */
-	tex = (cached_texture *)alloc_array_or_die(UINT8, sizeof(cached_texture) + (2 * pixwidth * 2 * pixheight) * sizeof(rgb_t));
-	tex->width = texwidth;
-	tex->height = texheight;
-	tex->format = format;
+	if (tex != NULL)
+	{
+		tex->lastused = texture_frame;
+		if (!tex->dirty)
+		{
+			texstats.hits++;
+			return tex;
+		}
 
-	/* set the new texture */
-	tex->next = texcache[page][texy][texx];
-	texcache[page][texy][texx] = tex;
+		/* games often upload the same texture again; only decode if it really changed */
+		hash = hash_texture(page, texx, texy, texwidth, texheight, format);
+		tex->dirty = FALSE;
+		if (hash == tex->hash)
+		{
+			texstats.rehits++;
+			return tex;
+		}
+	}
+	else
+	{
+		/* create a new texture */
+		UINT32 bytes = (2 * pixwidth * 2 * pixheight) * sizeof(rgb_t);
+
+		hash = hash_texture(page, texx, texy, texwidth, texheight, format);
+		tex = (cached_texture *)alloc_array_or_die(UINT8, sizeof(cached_texture) + bytes);
+		tex->width = texwidth;
+		tex->height = texheight;
+		tex->format = format;
+		tex->dirty = FALSE;
+		tex->lastused = texture_frame;
+		texstats.bytes += bytes;
+		texstats.maxbytes = MAX(texstats.maxbytes, texstats.bytes);
+
+		/* set the new texture */
+		tex->next = texcache[page][texy][texx];
+		texcache[page][texy][texx] = tex;
+	}
+	texstats.misses++;
+	tex->hash = hash;
 
 	/* decode it */
 	for (y = 0; y < pixheight; y++)
@@ -796,6 +916,47 @@ static void real3d_upload_texture(UINT32 header, UINT32 *data)
 	}
 }
 
+/*
+    filter the scaled 3D render down into bitmap3d; a pixel is transparent
+    unless at least half of its samples were drawn, and otherwise gets the
+    average of the drawn ones so edges don't pick up the 0x8000 key
+*/
+static void downsample_3d(void)
+{
+	int samples = render_scale * render_scale;
+	int x, y, sx, sy;
+
+	for (y = 0; y < bitmap3d->height; y++)
+	{
+		UINT16 *d = BITMAP_ADDR16(bitmap3d, y, 0);
+
+		for (x = 0; x < bitmap3d->width; x++)
+		{
+			UINT32 r = 0, g = 0, b = 0;
+			int count = 0;
+
+			for (sy = 0; sy < render_scale; sy++)
+			{
+				const UINT16 *s = BITMAP_ADDR16(render3d, y * render_scale + sy, x * render_scale);
+
+				for (sx = 0; sx < render_scale; sx++)
+					if (!(s[sx] & 0x8000))
+					{
+						r += s[sx] & 0x7c00;
+						g += s[sx] & 0x03e0;
+						b += s[sx] & 0x001f;
+						count++;
+					}
+			}
+
+			if (count * 2 < samples)
+				d[x] = 0x8000;
+			else
+				d[x] = ((r / count) & 0x7c00) | ((g / count) & 0x03e0) | (b / count);
+		}
+	}
+}
+
 void real3d_display_list_end(void)
 {
 	/* upload textures if there are any in the FIFO */
@@ -812,8 +973,10 @@ void real3d_display_list_end(void)
 	}
 	texture_fifo_pos = 0;
 	bitmap_fill(zbuffer, NULL, 0);
-	bitmap_fill(bitmap3d, NULL, 0x8000);
+	bitmap_fill(render3d, NULL, 0x8000);
 	real3d_traverse_display_list();
+	if (render_scale > 1)
+		downsample_3d();
 //  real3d_display_list = 1;
 }
 
@@ -919,6 +1082,7 @@ INLINE float dot_product3(VECTOR3 a, VECTOR3 b)
 	return (a[0] * b[0]) + (a[1] * b[1]) + (a[2] * b[2]);
 }
 
+#ifdef UNUSED_FUNCTION
 /* multiplies a 4-element vector by a 4x4 matrix */
 static void matrix_multiply_vector(MATRIX matrix, const VECTOR v, VECTOR *p)
 {
@@ -927,6 +1091,7 @@ static void matrix_multiply_vector(MATRIX matrix, const VECTOR v, VECTOR *p)
 	(*p)[2] = (v[0] * matrix[0][2]) + (v[1] * matrix[1][2]) + (v[2] * matrix[2][2]) + (v[3] * matrix[3][2]);
 	(*p)[3] = (v[0] * matrix[0][3]) + (v[1] * matrix[1][3]) + (v[2] * matrix[2][3]) + (v[3] * matrix[3][3]);
 }
+#endif
 
 /* multiplies a 4x4 matrix with another 4x4 matrix */
 static void matrix_multiply(MATRIX a, MATRIX b, MATRIX *out)
@@ -1026,6 +1191,18 @@ INLINE float line_plane_intersection(const poly_vertex *v1, const poly_vertex *v
 	return t;
 }
 
+/* returns a bit for each clip plane the point is outside of */
+INLINE int compute_outcode(float x, float y, float z)
+{
+	int outcode = 0;
+	int i;
+
+	for (i = 0; i < 5; i++)
+		if (!is_point_inside(x, y, z, clip_plane[i]))
+			outcode |= 1 << i;
+	return outcode;
+}
+
 static int clip_polygon(const poly_vertex *v, int num_vertices, PLANE cp, poly_vertex *vout)
 {
 	poly_vertex clipv[10];
@@ -1107,7 +1284,7 @@ static void render_one(TRIANGLE *tri)
 			callback = (tri->transparency >= 32) ? draw_scanline_normal : draw_scanline_trans;
 		else
 			callback = draw_scanline_alpha;
-		poly_render_triangle(poly, bitmap3d, &clip3d, callback, 3, &tri->v[0], &tri->v[1], &tri->v[2]);
+		poly_render_triangle(poly, render3d, &clip3d, callback, 3, &tri->v[0], &tri->v[1], &tri->v[2]);
 	}
 	else
 	{
@@ -1115,7 +1292,7 @@ static void render_one(TRIANGLE *tri)
 		extra->polygon_intensity	= tri->intensity;
 		extra->color                = tri->color;
 
-		poly_render_triangle(poly, bitmap3d, &clip3d, draw_scanline_color, 1, &tri->v[0], &tri->v[1], &tri->v[2]);
+		poly_render_triangle(poly, render3d, &clip3d, draw_scanline_color, 1, &tri->v[0], &tri->v[1], &tri->v[2]);
 	}
 }
 
@@ -1130,6 +1307,10 @@ static void draw_model(UINT32 addr)
 	float fixed_point_fraction;
 	poly_vertex vertex[4];
 	poly_vertex prev_vertex[4];
+	poly_vertex xform_vert[4];
+	poly_vertex prev_xform_vert[4];
+	int outcode[4];
+	int prev_outcode[4];
 	poly_vertex clip_vert[10];
 
 	int polynum = 0;
@@ -1154,8 +1335,8 @@ static void draw_model(UINT32 addr)
 		UINT16 color;
 		VECTOR3 normal;
 		VECTOR3 sn;
-		VECTOR p[4];
 		TRIANGLE tri;
+		int clip_or, clip_and;
 		float dot;
 		int intensity;
 		int polygon_transparency;
@@ -1179,11 +1360,16 @@ static void draw_model(UINT32 addr)
 		normal[1] = (float)((INT32)header[2] >> 8) * (1.0f / 4194304.0f);
 		normal[2] = (float)((INT32)header[3] >> 8) * (1.0f / 4194304.0f);
 
-		/* load reused vertices */
+		/* load reused vertices, which have already been transformed */
 		vi = 0;
 		for (v = 0; v < 4; v++)
 			if (header[0] & (1 << v))
-				vertex[vi++] = prev_vertex[v];
+			{
+				vertex[vi] = prev_vertex[v];
+				xform_vert[vi] = prev_xform_vert[v];
+				outcode[vi] = prev_outcode[v];
+				vi++;
+			}
 
 		/* load new vertices */
 		for ( ; vi < num_vertices; vi++)
@@ -1193,10 +1379,33 @@ static void draw_model(UINT32 addr)
 			vertex[vi].pz = (float)((INT32)model[index++]) * fixed_point_fraction;
 			vertex[vi].pu = (UINT16)(model[index] >> 16);
 			vertex[vi].pv = (UINT16)(model[index++]);
+
+			/* TODO: depth bias */
+			/* transform to world-space (w is always 1) and apply the coordinate system */
+			xform_vert[vi].x = ((vertex[vi].x * transform_matrix[0][0]) + (vertex[vi].y * transform_matrix[1][0]) + (vertex[vi].pz * transform_matrix[2][0]) + transform_matrix[3][0]) * coordinate_system[0][1];
+			xform_vert[vi].y = ((vertex[vi].x * transform_matrix[0][1]) + (vertex[vi].y * transform_matrix[1][1]) + (vertex[vi].pz * transform_matrix[2][1]) + transform_matrix[3][1]) * coordinate_system[1][2];
+			xform_vert[vi].pz = ((vertex[vi].x * transform_matrix[0][2]) + (vertex[vi].y * transform_matrix[1][2]) + (vertex[vi].pz * transform_matrix[2][2]) + transform_matrix[3][2]) * coordinate_system[2][0];
+			outcode[vi] = compute_outcode(xform_vert[vi].x, xform_vert[vi].y, xform_vert[vi].pz);
 		}
 
 		/* Copy current vertices as previous vertices */
 		memcpy(prev_vertex, vertex, sizeof(poly_vertex) * 4);
+		memcpy(prev_xform_vert, xform_vert, sizeof(poly_vertex) * 4);
+		memcpy(prev_outcode, outcode, sizeof(outcode));
+
+		/* skip polygons entirely outside one of the clip planes */
+		clip_or = 0;
+		clip_and = 0x1f;
+		for (i = 0; i < num_vertices; i++)
+		{
+			clip_or |= outcode[i];
+			clip_and &= outcode[i];
+		}
+		if (clip_and != 0)
+		{
+			++polynum;
+			continue;
+		}
 
 		color = (((header[4] >> 27) & 0x1f) << 10) | (((header[4] >> 19) & 0x1f) << 5) | ((header[4] >> 11) & 0x1f);
 		polygon_transparency =  (header[6] & 0x800000) ? 32 : ((header[6] >> 18) & 0x1f);
@@ -1216,34 +1425,25 @@ static void draw_model(UINT32 addr)
 		sn[1] *= coordinate_system[1][2];
 		sn[2] *= coordinate_system[2][0];
 
-		/* TODO: depth bias */
-		/* transform vertices */
+		/* texture coordinates are scaled per polygon, even for reused vertices */
 		for (i = 0; i < num_vertices; i++)
 		{
-			VECTOR vect;
-
-			vect[0] = vertex[i].x;
-			vect[1] = vertex[i].y;
-			vect[2] = vertex[i].pz;
-			vect[3] = 1.0f;
-
-			/* transform to world-space */
-			matrix_multiply_vector(transform_matrix, vect, &p[i]);
-
-			/* apply coordinate system */
-			clip_vert[i].x = p[i][0] * coordinate_system[0][1];
-			clip_vert[i].y = p[i][1] * coordinate_system[1][2];
-			clip_vert[i].pz = p[i][2] * coordinate_system[2][0];
+			clip_vert[i].x = xform_vert[i].x;
+			clip_vert[i].y = xform_vert[i].y;
+			clip_vert[i].pz = xform_vert[i].pz;
 			clip_vert[i].pu = vertex[i].pu * texture_coord_scale;
 			clip_vert[i].pv = vertex[i].pv * texture_coord_scale;
 		}
 
-		/* clip against view frustum */
-		num_vertices = clip_polygon(clip_vert, num_vertices, clip_plane[0], clip_vert);
-		num_vertices = clip_polygon(clip_vert, num_vertices, clip_plane[1], clip_vert);
-		num_vertices = clip_polygon(clip_vert, num_vertices, clip_plane[2], clip_vert);
-		num_vertices = clip_polygon(clip_vert, num_vertices, clip_plane[3], clip_vert);
-		num_vertices = clip_polygon(clip_vert, num_vertices, clip_plane[4], clip_vert);
+		/* clip against view frustum, unless we're entirely inside it */
+		if (clip_or != 0)
+		{
+			num_vertices = clip_polygon(clip_vert, num_vertices, clip_plane[0], clip_vert);
+			num_vertices = clip_polygon(clip_vert, num_vertices, clip_plane[1], clip_vert);
+			num_vertices = clip_polygon(clip_vert, num_vertices, clip_plane[2], clip_vert);
+			num_vertices = clip_polygon(clip_vert, num_vertices, clip_plane[3], clip_vert);
+			num_vertices = clip_polygon(clip_vert, num_vertices, clip_plane[4], clip_vert);
+		}
 
 		/* backface culling */
 		if( (header[6] & 0x800000) && (!(header[1] & 0x0010)) )	{
@@ -1521,11 +1721,21 @@ static void real3d_traverse_display_list(void)
 {
 	int pri;
 
+	/* nothing is pending now, so this is where the texture cache can shrink */
+	if (texstats.bytes > TEXTURE_CACHE_BUDGET)
+		free_textures(texture_frame);
+	texture_frame++;
+
+	/* walking the lists and transforming the geometry is USER1; rasterizing is USER2 */
+	profiler_mark_start(PROFILER_USER1);
 	init_matrix_stack();
 
 	for (pri = 0; pri < 4; pri++)
 		draw_viewport(pri, 0x800000);
+	profiler_mark_end();
 
+	profiler_mark_start(PROFILER_USER2);
 	poly_wait(poly, "real3d_traverse_display_list");
+	profiler_mark_end();
 }
 
@@ -1522,6 +1522,20 @@ do                                                          \
 }                                                           \
 while(0)
 
+// (s << 20) / w for the perspective divide; the quotient of two integers this
+// size is always exact in double precision, so the 64-bit division (a library
+// call on 32-bit hosts) is only needed when the result doesn't fit in an int
+INLINE int perspective_divide(int s, int w)
+{
+    double quotient = ((double)s * 1048576.0) / (double)w;
+
+    if (quotient > -2147483648.0 && quotient < 2147483648.0)
+    {
+        return (int)quotient;
+    }
+    return (int)(((INT64)s << 20) / w);
+}
+
 static int alpha_compare_success(COLOR c1, COLOR c2)
 {
     if( other_modes.alpha_compare_en )
@@ -2593,7 +2607,7 @@ static void render_spans_32(int start, int end, int tilenum, int shade, int text
         int xinc;
 
         int fb_index = fb_width * i;
-        int length;
+        int length, jstart, jend;
 
         drinc = flip ? (dr) : -dr;
         dginc = flip ? (dg) : -dg;
@@ -2609,7 +2623,31 @@ static void render_spans_32(int start, int end, int tilenum, int shade, int text
 
         length = flip ? (xstart - xend) : (xend - xstart);
 
-        for (j=0; j <= length; j++)
+        // skip straight to the part of the span inside the clip rectangle
+        jstart = flip ? (clipx1 - xend) : (xend - (clipx2 - 1));
+        jend = flip ? (clipx2 - 1 - xend) : (xend - clipx1);
+        if (jend > length)
+        {
+            jend = length;
+        }
+        if (jstart > 0)
+        {
+            r += jstart * drinc;
+            g += jstart * dginc;
+            b += jstart * dbinc;
+            a += jstart * dainc;
+            z += jstart * dzinc;
+            s += jstart * dsinc;
+            t += jstart * dtinc;
+            w += jstart * dwinc;
+            x += jstart * xinc;
+        }
+        else
+        {
+            jstart = 0;
+        }
+
+        for (j=jstart; j <= jend; j++)
         {
             int sr = r >> 16;
             int sg = g >> 16;
@@ -2635,8 +2673,8 @@ static void render_spans_32(int start, int end, int tilenum, int shade, int text
                 {
                     if (sw != 0)
                     {
-                        sss = (((INT64)(ss) << 20) / sw);
-                        sst = (((INT64)(st) << 20) / sw);
+                        sss = perspective_divide(ss, sw);
+                        sst = perspective_divide(st, sw);
                     }
                 }
                 else
@@ -2819,7 +2857,7 @@ static void render_spans_16(int start, int end, int tilenum, int shade, int text
         int xinc;
 
         int fb_index = fb_width * i;
-        int length;
+        int length, jstart, jend;
 
         drinc = flip ? (dr) : -dr;
         dginc = flip ? (dg) : -dg;
@@ -2835,7 +2873,31 @@ static void render_spans_16(int start, int end, int tilenum, int shade, int text
 
         length = flip ? (xstart - xend) : (xend - xstart);
 
-        for (j=0; j <= length; j++)
+        // skip straight to the part of the span inside the clip rectangle
+        jstart = flip ? (clipx1 - xend) : (xend - (clipx2 - 1));
+        jend = flip ? (clipx2 - 1 - xend) : (xend - clipx1);
+        if (jend > length)
+        {
+            jend = length;
+        }
+        if (jstart > 0)
+        {
+            r += jstart * drinc;
+            g += jstart * dginc;
+            b += jstart * dbinc;
+            a += jstart * dainc;
+            z += jstart * dzinc;
+            s += jstart * dsinc;
+            t += jstart * dtinc;
+            w += jstart * dwinc;
+            x += jstart * xinc;
+        }
+        else
+        {
+            jstart = 0;
+        }
+
+        for (j=jstart; j <= jend; j++)
         {
             int sr = r >> 16;
             int sg = g >> 16;
@@ -2873,8 +2935,8 @@ static void render_spans_16(int start, int end, int tilenum, int shade, int text
                 {
                     if (sw != 0)
                     {
-                        sss = (((INT64)(ss) << 20) / sw);
-                        sst = (((INT64)(st) << 20) / sw);
+                        sss = perspective_divide(ss, sw);
+                        sst = perspective_divide(st, sw);
                     }
                 }
                 else
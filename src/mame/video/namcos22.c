@@ -264,8 +264,27 @@ struct _poly_extra_data
 	int alpha;
 	int prioverchar;
 	int line_modulo;
+	int penmask;				/* quads: texel bits selecting the pen */
+	int penshift;				/* quads: shift applied to the texel first */
+	int transFactor;			/* quads: 0xff, or the polygon translucency when drawn over chars */
+	int fogDelta;				/* sprites: fog offset added to z */
+	int fogEnable;				/* sprites: fog applies */
+	int fadeEnable;				/* sprites: fade applies */
 };
 
+/* render statistics, toggled with the backslash key */
+static struct
+{
+	UINT32 quads;				/* quads submitted this frame */
+	UINT32 sprites;				/* sprite tiles submitted this frame */
+	UINT32 pixels;				/* pixels rasterized this frame */
+	osd_ticks_t polygon_ticks;	/* time spent in DrawPolygons this frame */
+	osd_ticks_t scene_ticks;	/* time spent in RenderScene this frame */
+	char buffer[256];			/* last frame's summary */
+	UINT8 display;				/* are we displaying the stats? */
+	UINT8 lastkey;				/* last key state */
+} mStats;
+
 
 static void renderscanline_uvi_full(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid)
 {
@@ -283,44 +302,16 @@ static void renderscanline_uvi_full(void *dest, INT32 scanline, const poly_exten
 	const pen_t *pens = extra->pens;
 	int fogFactor = 0xff - extra->fogFactor;
 	int fadeFactor = 0xff - extra->fadeFactor;
-	int transFactor = 0xff;
+	int transFactor = extra->transFactor;
 	rgbint fogColor = extra->fogColor;
 	rgbint fadeColor = extra->fadeColor;
-	int penmask, penshift;
-	int prioverchar;
+	int penmask = extra->penmask;
+	int penshift = extra->penshift;
 	const UINT8 *pCharPri = BITMAP_ADDR8(extra->priority_bitmap, scanline, 0);
 	UINT32 *pDest = BITMAP_ADDR32(bitmap, scanline, 0);
 	int x;
 
-	if (extra->cmode & 4)
-	{
-		prioverchar = 0;
-		pens += 0xec + ((extra->cmode & 8) << 1);
-		penmask = 0x03;
-		penshift = 2 * ~(extra->cmode & 3);
-	}
-	else if (extra->cmode & 2)
-	{
-		prioverchar = 0;
-		pens += 0xe0 + ((extra->cmode & 8) << 1);
-		penmask = 0x0f;
-		penshift = 4 * ~(extra->cmode & 1);
-	}
-	else if (extra->cmode & 1)
-	{
-		transFactor = 0xff - mixer.poly_translucency;
-		prioverchar = 1;
-		penmask = 0xff;
-		penshift = 0;
-	}
-	else
-	{
-		prioverchar = 0;
-		penmask = 0xff;
-		penshift = 0;
-	}
-
-	if (prioverchar)
+	if (extra->prioverchar)
 	{
 		for( x=extent->startx; x<extent->stopx; x++ )
 		{
@@ -445,6 +436,32 @@ static void poly3d_DrawQuad(running_machine *machine, bitmap_t *bitmap, int text
 	extra->fogFactor = 0;
 	extra->fadeFactor = 0;
 
+	/* decode the color mode once here rather than on every scanline */
+	extra->transFactor = 0xff;
+	extra->prioverchar = 0;
+	if (cmode & 4)
+	{
+		extra->pens += 0xec + ((cmode & 8) << 1);
+		extra->penmask = 0x03;
+		extra->penshift = 2 * ~(cmode & 3);
+	}
+	else if (cmode & 2)
+	{
+		extra->pens += 0xe0 + ((cmode & 8) << 1);
+		extra->penmask = 0x0f;
+		extra->penshift = 4 * ~(cmode & 1);
+	}
+	else
+	{
+		if (cmode & 1)
+		{
+			extra->transFactor = 0xff - mixer.poly_translucency;
+			extra->prioverchar = 1;
+		}
+		extra->penmask = 0xff;
+		extra->penshift = 0;
+	}
+
 	if (mixer.target&1)
 	{
 		extra->fadeFactor = mixer.fadeFactor;
@@ -478,10 +495,11 @@ static void poly3d_DrawQuad(running_machine *machine, bitmap_t *bitmap, int text
 		}
 	}
 
+	mStats.quads++;
 #ifdef RENDER_AS_QUADS
-	poly_render_quad_fan(poly, bitmap, &mClip.scissor, renderscanline_uvi_full, 4, clipverts, clipv);
+	mStats.pixels += poly_render_quad_fan(poly, bitmap, &mClip.scissor, renderscanline_uvi_full, 4, clipverts, clipv);
 #else
-	poly_render_triangle_fan(poly, bitmap, &mClip.scissor, renderscanline_uvi_full, 4, clipverts, clipv);
+	mStats.pixels += poly_render_triangle_fan(poly, bitmap, &mClip.scissor, renderscanline_uvi_full, 4, clipverts, clipv);
 #endif
 }
 
@@ -501,19 +519,9 @@ static void renderscanline_sprite(void *destbase, INT32 scanline, const poly_ext
 	const UINT8 *pCharPri = BITMAP_ADDR8(extra->priority_bitmap, scanline, 0);
 	int x;
 
-	int bFogEnable = 0;
-	INT16 fogDelta = 0;
-	int fadeEnable = (mixer.target&2) && mixer.fadeFactor;
-
-	if( mbSuperSystem22 )
-	{
-		fogDelta = nthword(namcos22_czattr, 0 );
-		bFogEnable = nthword(namcos22_czattr,4)&0x4000; /* ? */
-	}
-	else
-	{
-		bFogEnable = 0;
-	}
+	int bFogEnable = extra->fogEnable;
+	INT16 fogDelta = extra->fogDelta;
+	int fadeEnable = extra->fadeEnable;
 
 	for( x=extent->startx; x<extent->stopx; x++ )
 	{
@@ -600,10 +608,25 @@ mydrawgfxzoom(
 		extra->pens = &gfx->machine->pens[gfx->color_base + gfx->color_granularity * (color % gfx->total_colors)];
 		extra->priority_bitmap = gfx->machine->priority_bitmap;
 		extra->source = gfx_element_get_data(gfx, code % gfx->total_elements);
+
+		/* fog and fade setup is the same for every scanline of the sprite */
+		extra->fadeEnable = (mixer.target&2) && mixer.fadeFactor;
+		if( mbSuperSystem22 )
+		{
+			extra->fogDelta = (INT16)nthword(namcos22_czattr, 0 );
+			extra->fogEnable = nthword(namcos22_czattr,4)&0x4000; /* ? */
+		}
+		else
+		{
+			extra->fogDelta = 0;
+			extra->fogEnable = 0;
+		}
+
+		mStats.sprites++;
 #ifdef RENDER_AS_QUADS
-		poly_render_quad_fan(poly, dest_bmp, clip, renderscanline_sprite, 2, 4, &vert[0]);
+		mStats.pixels += poly_render_quad_fan(poly, dest_bmp, clip, renderscanline_sprite, 2, 4, &vert[0]);
 #else
-		poly_render_triangle_fan(poly, dest_bmp, clip, renderscanline_sprite, 2, 4, &vert[0]);
+		mStats.pixels += poly_render_triangle_fan(poly, dest_bmp, clip, renderscanline_sprite, 2, 4, &vert[0]);
 #endif
 	}
 } /* mydrawgfxzoom */
@@ -988,6 +1011,7 @@ static void RenderSceneHelper(running_machine *machine, bitmap_t *bitmap, struct
 static void RenderScene(running_machine *machine, bitmap_t *bitmap )
 {
    struct SceneNode *node = &mSceneRoot;
+   osd_ticks_t start = osd_ticks();
    int i;
    for( i=RADIX_BUCKETS-1; i>=0; i-- )
    {
@@ -996,8 +1020,37 @@ static void RenderScene(running_machine *machine, bitmap_t *bitmap )
    }
    poly3d_NoClip();
 	poly_wait(poly, "DrawPolygons");
+	mStats.scene_ticks += osd_ticks() - start;
 } /* RenderScene */
 
+/* show (if enabled) and reset the per-frame render statistics */
+static void
+UpdateRenderStats( running_machine *machine )
+{
+	int statskey = (input_code_pressed(machine, KEYCODE_BACKSLASH) != 0);
+	if( statskey && statskey != mStats.lastkey )
+	{
+		mStats.display = !mStats.display;
+	}
+	mStats.lastkey = statskey;
+
+	if( mStats.display )
+	{
+		osd_ticks_t tps = osd_ticks_per_second();
+		sprintf(mStats.buffer, "Quads:%6d\nSprites:%4d\nPixels:%7d\nDSP ms:%6.2f\nScene ms:%5.2f",
+			mStats.quads, mStats.sprites, mStats.pixels,
+			(double)mStats.polygon_ticks * 1000.0 / (double)tps,
+			(double)mStats.scene_ticks * 1000.0 / (double)tps);
+		popmessage("%s", mStats.buffer);
+	}
+
+	mStats.quads = 0;
+	mStats.sprites = 0;
+	mStats.pixels = 0;
+	mStats.polygon_ticks = 0;
+	mStats.scene_ticks = 0;
+} /* UpdateRenderStats */
+
 static float
 DspFloatToNativeFloat( UINT32 iVal )
 {
@@ -2154,8 +2207,10 @@ DrawPolygons( running_machine *machine, bitmap_t *bitmap )
 {
 	if( mbDSPisActive )
 	{
+		osd_ticks_t start = osd_ticks();
 		SimulateSlaveDSP( machine, bitmap );
 		poly_wait(poly, "DrawPolygons");
+		mStats.polygon_ticks += osd_ticks() - start;
 	}
 } /* DrawPolygons */
 
@@ -2275,6 +2330,7 @@ VIDEO_UPDATE( namcos22s )
 	RenderScene(screen->machine, bitmap );
 	DrawTranslucentCharacters( bitmap, cliprect );
 	ApplyGamma( screen->machine, bitmap );
+	UpdateRenderStats( screen->machine );
 
 #ifdef MAME_DEBUG
    if( input_code_pressed(screen->machine, KEYCODE_D) )
@@ -2325,6 +2381,7 @@ VIDEO_UPDATE( namcos22 )
 	RenderScene(screen->machine, bitmap);
 	DrawTranslucentCharacters( bitmap, cliprect );
 	ApplyGamma( screen->machine, bitmap );
+	UpdateRenderStats( screen->machine );
 
 #ifdef MAME_DEBUG
    if( input_code_pressed(screen->machine, KEYCODE_D) )
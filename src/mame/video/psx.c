@@ -1096,8 +1096,6 @@ INLINE void decode_tpage( running_machine *machine, struct PSXGPU *p_psxgpu, UIN
 	} \
 	TRANSPARENCYSETUP
 
-#define FLATPOLYGONUPDATE
-#define FLATRECTANGEUPDATE
 #define GOURAUDPOLYGONUPDATE \
 	n_r.d += n_dr; \
 	n_g.d += n_dg; \
@@ -1140,6 +1138,47 @@ INLINE void decode_tpage( running_machine *machine, struct PSXGPU *p_psxgpu, UIN
 		break; \
 	} \
 
+/* flat primitives have the same colour across the whole span, so look it */
+/* (or its share of the blend) up once instead of for every pixel */
+#define FLATFILL \
+	if( n_distance > ( (INT32)m_n_drawarea_x2 - n_x ) + 1 ) \
+	{ \
+		n_distance = ( m_n_drawarea_x2 - n_x ) + 1; \
+	} \
+	p_vram = m_p_p_vram[ n_y ] + n_x; \
+ \
+	switch( n_cmd & 0x02 ) \
+	{ \
+	case 0x00: \
+		/* transparency off */ \
+		n_bgr = \
+			m_p_n_redshade[ MID_LEVEL | n_r.w.h ] | \
+			m_p_n_greenshade[ MID_LEVEL | n_g.w.h ] | \
+			m_p_n_blueshade[ MID_LEVEL | n_b.w.h ]; \
+		while( n_distance > 0 ) \
+		{ \
+			WRITE_PIXEL( n_bgr ); \
+			p_vram++; \
+			n_distance--; \
+		} \
+		break; \
+	case 0x02: \
+		/* transparency on */ \
+		n_redf = p_n_f[ MID_LEVEL | n_r.w.h ]; \
+		n_greenf = p_n_f[ MID_LEVEL | n_g.w.h ]; \
+		n_bluef = p_n_f[ MID_LEVEL | n_b.w.h ]; \
+		while( n_distance > 0 ) \
+		{ \
+			WRITE_PIXEL( \
+				p_n_redtrans[ n_redf | p_n_redb[ *( p_vram ) ] ] | \
+				p_n_greentrans[ n_greenf | p_n_greenb[ *( p_vram ) ] ] | \
+				p_n_bluetrans[ n_bluef | p_n_blueb[ *( p_vram ) ] ] ); \
+			p_vram++; \
+			n_distance--; \
+		} \
+		break; \
+	} \
+
 #define FLATTEXTUREDPOLYGONUPDATE \
 	n_u.d += n_du; \
 	n_v.d += n_dv;
@@ -1234,6 +1273,38 @@ INLINE void decode_tpage( running_machine *machine, struct PSXGPU *p_psxgpu, UIN
 		n_distance--; \
 	}
 
+/* raw textures (command bit 0) are drawn at a shade of 0x80, which leaves */
+/* the texel unchanged, so skip the shade tables for them */
+#define RAWPIXEL( PIXELUPDATE ) \
+		if( n_bgr != 0 ) \
+		{ \
+			WRITE_PIXEL( n_bgr & 0x7fff ); \
+		} \
+		p_vram++; \
+		PIXELUPDATE \
+		n_distance--; \
+	}
+
+#define RAWTRANSPARENTPIXEL( PIXELUPDATE ) \
+		if( n_bgr != 0 ) \
+		{ \
+			if( ( n_bgr & 0x8000 ) != 0 ) \
+			{ \
+				WRITE_PIXEL( \
+					p_n_redtrans[ p_n_f[ m_p_n_redlevel[ n_bgr ] | MID_SHADE ] | p_n_redb[ *( p_vram ) ] ] | \
+					p_n_greentrans[ p_n_f[ m_p_n_greenlevel[ n_bgr ] | MID_SHADE ] | p_n_greenb[ *( p_vram ) ] ] | \
+					p_n_bluetrans[ p_n_f[ m_p_n_bluelevel[ n_bgr ] | MID_SHADE ] | p_n_blueb[ *( p_vram ) ] ] ); \
+			} \
+			else \
+			{ \
+				WRITE_PIXEL( n_bgr ); \
+			} \
+		} \
+		p_vram++; \
+		PIXELUPDATE \
+		n_distance--; \
+	}
+
 #define TEXTUREFILL( PIXELUPDATE, TXU, TXV ) \
 	if( n_distance > ( (INT32)m_n_drawarea_x2 - n_x ) + 1 ) \
 	{ \
@@ -1401,6 +1472,55 @@ INLINE void decode_tpage( running_machine *machine, struct PSXGPU *p_psxgpu, UIN
 				break; \
 			} \
 		} \
+		else if( ( n_cmd & 0x01 ) != 0 ) \
+		{ \
+			/* no texture window, raw texture */ \
+			switch( n_cmd & 0x02 ) \
+			{ \
+			case 0x00: \
+				/* no shading */ \
+				switch( psxgpu.n_tp ) \
+				{ \
+				case 0: \
+					/* 4 bit clut */ \
+					TEXTURE4BIT( TXV, TXU ) \
+					RAWPIXEL( PIXELUPDATE ) \
+					break; \
+				case 1: \
+					/* 8 bit clut */ \
+					TEXTURE8BIT( TXV, TXU ) \
+					RAWPIXEL( PIXELUPDATE ) \
+					break; \
+				case 2: \
+					/* 15 bit */ \
+					TEXTURE15BIT( TXV, TXU ) \
+					RAWPIXEL( PIXELUPDATE ) \
+					break; \
+				} \
+				break; \
+			case 0x02: \
+				/* semi transparency */ \
+				switch( psxgpu.n_tp ) \
+				{ \
+				case 0: \
+					/* 4 bit clut */ \
+					TEXTURE4BIT( TXV, TXU ) \
+					RAWTRANSPARENTPIXEL( PIXELUPDATE ) \
+					break; \
+				case 1: \
+					/* 8 bit clut */ \
+					TEXTURE8BIT( TXV, TXU ) \
+					RAWTRANSPARENTPIXEL( PIXELUPDATE ) \
+					break; \
+				case 2: \
+					/* 15 bit */ \
+					TEXTURE15BIT( TXV, TXU ) \
+					RAWTRANSPARENTPIXEL( PIXELUPDATE ) \
+					break; \
+				} \
+				break; \
+			} \
+		} \
 		else \
 		{ \
 			/* no texture window */ \
@@ -1475,6 +1595,10 @@ static void FlatPolygon( running_machine *machine, int n_points )
 	UINT8 n_cmd;
 
 	INT32 n_distance;
+	UINT16 n_bgr;
+	UINT16 n_redf;
+	UINT16 n_greenf;
+	UINT16 n_bluef;
 
 	UINT16 n_point;
 	UINT16 n_rightpoint;
@@ -1598,7 +1722,7 @@ static void FlatPolygon( running_machine *machine, int n_points )
 				n_distance -= ( m_n_drawarea_x1 - n_x );
 				n_x = m_n_drawarea_x1;
 			}
-			SOLIDFILL( FLATPOLYGONUPDATE )
+			FLATFILL
 		}
 		n_cx1.d += n_dx1;
 		n_cx2.d += n_dx2;
@@ -2631,6 +2755,10 @@ static void FlatRectangle( running_machine *machine )
 	PAIR n_b;
 
 	INT32 n_distance;
+	UINT16 n_bgr;
+	UINT16 n_redf;
+	UINT16 n_greenf;
+	UINT16 n_bluef;
 	INT32 n_h;
 	UINT16 *p_vram;
 
@@ -2669,7 +2797,7 @@ static void FlatRectangle( running_machine *machine )
 				n_distance -= ( m_n_drawarea_x1 - n_x );
 				n_x = m_n_drawarea_x1;
 			}
-			SOLIDFILL( FLATRECTANGEUPDATE )
+			FLATFILL
 		}
 		n_y++;
 		n_h--;
@@ -2696,6 +2824,10 @@ static void FlatRectangle8x8( running_machine *machine )
 	PAIR n_b;
 
 	INT32 n_distance;
+	UINT16 n_bgr;
+	UINT16 n_redf;
+	UINT16 n_greenf;
+	UINT16 n_bluef;
 	INT32 n_h;
 	UINT16 *p_vram;
 
@@ -2734,7 +2866,7 @@ static void FlatRectangle8x8( running_machine *machine )
 				n_distance -= ( m_n_drawarea_x1 - n_x );
 				n_x = m_n_drawarea_x1;
 			}
-			SOLIDFILL( FLATRECTANGEUPDATE )
+			FLATFILL
 		}
 		n_y++;
 		n_h--;
@@ -2761,6 +2893,10 @@ static void FlatRectangle16x16( running_machine *machine )
 	PAIR n_b;
 
 	INT32 n_distance;
+	UINT16 n_bgr;
+	UINT16 n_redf;
+	UINT16 n_greenf;
+	UINT16 n_bluef;
 	INT32 n_h;
 	UINT16 *p_vram;
 
@@ -2799,7 +2935,7 @@ static void FlatRectangle16x16( running_machine *machine )
 				n_distance -= ( m_n_drawarea_x1 - n_x );
 				n_x = m_n_drawarea_x1;
 			}
-			SOLIDFILL( FLATRECTANGEUPDATE )
+			FLATFILL
 		}
 		n_y++;
 		n_h--;
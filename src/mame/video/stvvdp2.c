@@ -5781,12 +5781,45 @@ static int stv_vdp2_apply_window_on_layer(rectangle *cliprect)
 static int		stv_sprite_priorities_used[8];
 static int		stv_sprite_priorities_usage_valid;
 static UINT8	stv_sprite_priorities_in_fb_line[512][8];
+static INT16	stv_sprite_line_first_x[512];
+static INT16	stv_sprite_line_last_x[512];
+
+/*
+    The first draw_sprites() pass of a frame walks the whole framebuffer and
+    notes which priorities each line uses and where its non-zero pixels are.
+    Later passes only visit the lines holding their priority, and only the
+    part of the line between the first and last non-zero pixel. An all-zero
+    framebuffer word never draws anything, whatever its priority bits say.
+*/
+INLINE int stv_sprite_line_range(int y, UINT8 pri, int min_x, int max_x, int *start_x, int *end_x)
+{
+	*start_x = min_x;
+	*end_x = max_x;
+	if ( stv_sprite_priorities_usage_valid )
+	{
+		if ( stv_sprite_priorities_in_fb_line[y][pri] == 0 )
+			return 0;
+		*start_x = MAX(min_x, stv_sprite_line_first_x[y]);
+		*end_x = MIN(max_x, stv_sprite_line_last_x[y]);
+	}
+	return 1;
+}
+
+INLINE void stv_sprite_line_note_range(int y, int first_x, int last_x)
+{
+	if ( !stv_sprite_priorities_usage_valid )
+	{
+		stv_sprite_line_first_x[y] = first_x;
+		stv_sprite_line_last_x[y] = last_x;
+	}
+}
 
 
 static void draw_sprites(running_machine *machine, bitmap_t *bitmap, const rectangle *cliprect, UINT8 pri)
 {
 	int x,y,r,g,b;
 	int i;
+	int start_x, end_x, first_x, last_x;
 	UINT16 pix;
 	UINT16 *framebuffer_line;
 	UINT16 *bitmap_line, *bitmap_line2 = NULL;
@@ -5902,16 +5935,22 @@ static void draw_sprites(running_machine *machine, bitmap_t *bitmap, const recta
 		{
 			for ( y = mycliprect.min_y; y <= mycliprect.max_y; y++ )
 			{
-				if ( stv_sprite_priorities_usage_valid )
-					if (stv_sprite_priorities_in_fb_line[y][pri] == 0)
-						continue;
+				if ( !stv_sprite_line_range(y, pri, mycliprect.min_x, mycliprect.max_x, &start_x, &end_x) )
+					continue;
 
 				framebuffer_line = stv_framebuffer_display_lines[y];
 				bitmap_line = BITMAP_ADDR16(bitmap, y, 0);
+				first_x = last_x = -1;
 
-				for ( x = mycliprect.min_x; x <= mycliprect.max_x; x++ )
+				for ( x = start_x; x <= end_x; x++ )
 				{
 					pix = framebuffer_line[x];
+					if ( pix == 0 )
+						continue;
+					if ( first_x < 0 )
+						first_x = x;
+					last_x = x;
+
 					if ( (pix & 0x8000) && sprite_color_mode)
 					{
 						if ( sprite_priorities[0] != pri )
@@ -5958,22 +5997,29 @@ static void draw_sprites(running_machine *machine, bitmap_t *bitmap, const recta
 						}
 					}
 				}
+				stv_sprite_line_note_range(y, first_x, last_x);
 			}
 		}
 		else //alpha_enabled == 1
 		{
 			for ( y = mycliprect.min_y; y <= mycliprect.max_y; y++ )
 			{
-				if ( stv_sprite_priorities_usage_valid )
-					if (stv_sprite_priorities_in_fb_line[y][pri] == 0)
-						continue;
+				if ( !stv_sprite_line_range(y, pri, mycliprect.min_x, mycliprect.max_x, &start_x, &end_x) )
+					continue;
 
 				framebuffer_line = stv_framebuffer_display_lines[y];
 				bitmap_line = BITMAP_ADDR16(bitmap, y, 0);
+				first_x = last_x = -1;
 
-				for ( x = mycliprect.min_x; x <= mycliprect.max_x; x++ )
+				for ( x = start_x; x <= end_x; x++ )
 				{
 					pix = framebuffer_line[x];
+					if ( pix == 0 )
+						continue;
+					if ( first_x < 0 )
+						first_x = x;
+					last_x = x;
+
 					if ( (pix & 0x8000) && sprite_color_mode)
 					{
 						if ( sprite_priorities[0] != pri )
@@ -6042,6 +6088,7 @@ static void draw_sprites(running_machine *machine, bitmap_t *bitmap, const recta
 						}
 					}
 				}
+				stv_sprite_line_note_range(y, first_x, last_x);
 			}
 		}
 	}
@@ -6049,11 +6096,11 @@ static void draw_sprites(running_machine *machine, bitmap_t *bitmap, const recta
 	{
 		for ( y = mycliprect.min_y; y <= mycliprect.max_y; y++ )
 		{
-			if ( stv_sprite_priorities_usage_valid )
-				if (stv_sprite_priorities_in_fb_line[y][pri] == 0)
-					continue;
+			if ( !stv_sprite_line_range(y, pri, mycliprect.min_x, double_x ? (mycliprect.max_x)/2 : mycliprect.max_x, &start_x, &end_x) )
+				continue;
 
 			framebuffer_line = stv_framebuffer_display_lines[y];
+			first_x = last_x = -1;
 			if ( interlace_framebuffer == 0 )
 			{
 				bitmap_line = BITMAP_ADDR16(bitmap, y, 0);
@@ -6064,9 +6111,15 @@ static void draw_sprites(running_machine *machine, bitmap_t *bitmap, const recta
 				bitmap_line2 = BITMAP_ADDR16(bitmap, 2*y + 1, 0);
 			}
 
-			for ( x = mycliprect.min_x; double_x ? x <= ((mycliprect.max_x)/2) : (x <= mycliprect.max_x); x++ )
+			for ( x = start_x; x <= end_x; x++ )
 			{
 				pix = framebuffer_line[x];
+				if ( pix == 0 )
+					continue;
+				if ( first_x < 0 )
+					first_x = x;
+				last_x = x;
+
 				if ( (pix & 0x8000) && sprite_color_mode)
 				{
 					if ( sprite_priorities[0] != pri )
@@ -6211,6 +6264,7 @@ static void draw_sprites(running_machine *machine, bitmap_t *bitmap, const recta
 					}
 				}
 			}
+			stv_sprite_line_note_range(y, first_x, last_x);
 		}
 	}
 
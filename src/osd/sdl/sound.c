@@ -18,6 +18,7 @@
 #include "mame.h"
 #include "osdepend.h"
 #include "osdsdl.h"
+#include "eminline.h"
 
 //============================================================
 //	DEBUGGING
@@ -33,30 +34,56 @@
 #define SDL_XFER_SAMPLES	(512)
 
 static int sdl_xfer_samples = SDL_XFER_SAMPLES;
-static int stream_in_initialized = 0;
-static int stream_loop = 0;
 
 // maximum audio latency
 #define MAX_AUDIO_LATENCY		10
 
+// largest rate correction, in parts per million; 0.5% is below what
+// can be heard as a pitch change
+#define MAX_RATE_ADJUST			5000
+
 //============================================================
 //	LOCAL VARIABLES
 //============================================================
 
 static int	 			attenuation = 0;
+static int				attenuation_level = 128;
 
 static int				initialized_audio = 0;
-static int				buf_locked;
-
-static INT8				*stream_buffer;
-static volatile INT32	stream_playpos;
-
-static UINT32			stream_buffer_size;
-static UINT32			stream_buffer_in;
+static int				stream_started;
+
+// the ring holds interleaved stereo frames; ring_in is only written by
+// osd_update_audio_stream and ring_out only by sdl_callback, and both
+// count frames forever so their difference is the fill level
+static INT16			*stream_buffer;
+static UINT32			stream_buffer_frames;		// power of two
+static INT32 volatile	ring_in;
+static INT32 volatile	ring_out;
+
+// fill level the rate control steers towards
+static UINT32			target_frames;
+static UINT32			average_fill;				// 24.8 fixed point
+
+// resampler state: input frames per output frame in 16.16 fixed point,
+// the position in the current input block, and the last frame of the
+// previous block to interpolate from
+static UINT32			resample_step;
+static UINT32			resample_pos;
+static INT16			resample_last[2];
+static int				rate_integral;				// parts per million
 
 // buffer over/underflow counts
 static int				buffer_underflows;
 static int				buffer_overflows;
+static UINT32			underflow_frames;
+
+// latency statistics, gathered in the callback
+static UINT32			callback_count;
+static UINT64			callback_fill_total;
+static UINT32			callback_fill_min;
+static UINT32			callback_fill_max;
+static int				rate_adjust_min;
+static int				rate_adjust_max;
 
 // debugging
 static FILE *sound_log;
@@ -118,7 +145,14 @@ static void sdl_cleanup_audio(running_machine *machine)
 	
 	// print out over/underflow stats
 	if (buffer_overflows || buffer_underflows)
-		mame_printf_verbose("Sound buffer: overflows=%d underflows=%d\n", buffer_overflows, buffer_underflows);
+		mame_printf_verbose("Sound buffer: overflows=%d underflows=%d (%u frames of silence)\n", buffer_overflows, buffer_underflows, underflow_frames);
+	if (callback_count != 0)
+		mame_printf_verbose("Sound latency: target %.1f ms, average %.1f ms, min %.1f ms, max %.1f ms, rate adjust %+d..%+d ppm\n",
+				(double)target_frames * 1000.0 / machine->sample_rate,
+				(double)callback_fill_total * 1000.0 / ((double)callback_count * machine->sample_rate),
+				(double)callback_fill_min * 1000.0 / machine->sample_rate,
+				(double)callback_fill_max * 1000.0 / machine->sample_rate,
+				rate_adjust_min, rate_adjust_max);
 
 	if (LOG_SOUND)
 	{
@@ -128,135 +162,41 @@ static void sdl_cleanup_audio(running_machine *machine)
 }
 
 //============================================================
-//	lock_buffer
+//	update_rate_control
 //============================================================
-static int lock_buffer(long offset, long size, void **buffer1, long *length1, void **buffer2, long *length2)
-{
-	volatile long pstart, pend, lstart, lend;
-
-	if (!buf_locked)
-	{
-		if (video_get_throttle())
-		{
-			pstart = stream_playpos;
-			pend = (pstart + sdl_xfer_samples);
-			lstart = offset;
-			lend = lstart+size;
-			while (((pstart >= lstart) && (pstart <= lend)) ||
-			       ((pend >= lstart) && (pend <= lend)))
-			{
-				pstart = stream_playpos;
-				pend = pstart + sdl_xfer_samples;
-			}
-		}
-
-		SDL_LockAudio();
-		buf_locked++;
-	}
 
-	// init lengths
-	*length1 = *length2 = 0;
-
-	if ((offset + size) > stream_buffer_size)
-	{
-		// 2-piece case
-		*length1 = stream_buffer_size - offset;
-		*buffer1 = &stream_buffer[offset];
-		*length2 = size - *length1;
-		*buffer2 = stream_buffer;
-	}
-	else
-	{
-		// normal 1-piece case
-		*length1 = size;
-		*buffer1 = &stream_buffer[offset];
-	}
-
-	if (LOG_SOUND)
-		fprintf(sound_log, "locking %ld bytes at offset %ld (total %d, playpos %d): len1 %ld len2 %ld\n",
-	        size, offset, stream_buffer_size, stream_playpos, *length1, *length2);
-
-	return 0;
-}
-
-//============================================================
-//	unlock_buffer
-//============================================================
-static void unlock_buffer(void)
+// nudge the resample ratio so the fill level stays centred on the
+// target instead of drifting into an underflow or overflow; the
+// integral term soaks up the steady clock mismatch between the
+// emulation and the sound card so the proportional term can settle
+static void update_rate_control(UINT32 fill)
 {
-	buf_locked--;
-	if (!buf_locked)
-		SDL_UnlockAudio();
-
-	if (LOG_SOUND)
-		fprintf(sound_log, "unlocking\n");
-
+	int error, adjust;
+
+	average_fill = average_fill - (average_fill >> 3) + (fill << 5);
+	error = (int)(((INT64)target_frames * 256 - (INT64)average_fill) * 1000000 / ((INT64)target_frames * 256));
+
+	rate_integral += error / 4000;
+	if (rate_integral > MAX_RATE_ADJUST)
+		rate_integral = MAX_RATE_ADJUST;
+	else if (rate_integral < -MAX_RATE_ADJUST)
+		rate_integral = -MAX_RATE_ADJUST;
+
+	adjust = error / 50 + rate_integral;
+	if (adjust > MAX_RATE_ADJUST)
+		adjust = MAX_RATE_ADJUST;
+	else if (adjust < -MAX_RATE_ADJUST)
+		adjust = -MAX_RATE_ADJUST;
+
+	// more output frames per input frame when the ring runs low
+	resample_step = (UINT32)(((UINT64)0x10000 * 1000000) / (1000000 + adjust));
+
+	if (adjust < rate_adjust_min)
+		rate_adjust_min = adjust;
+	if (adjust > rate_adjust_max)
+		rate_adjust_max = adjust;
 }
 
-//============================================================
-//	Apply attenuation
-//============================================================
-
-static void att_memcpy(void *dest, INT16 *data, int bytes_to_copy)
-{	
-	int level= (int) (pow(10.0, (float) attenuation / 20.0) * 128.0);
-	INT16 *d = dest;
-	int count = bytes_to_copy/2;
-	while (count>0)
-	{	
-		*d++ = (*data++ * level) >> 7; /* / 128 */
-		count--;
-	}
-}
-
-//============================================================
-//	copy_sample_data
-//============================================================
-
-static void copy_sample_data(INT16 *data, int bytes_to_copy)
-{
-	void *buffer1, *buffer2 = (void *)NULL;
-	long length1, length2;
-	int cur_bytes;
-
-	// attempt to lock the stream buffer
-	if (lock_buffer(stream_buffer_in, bytes_to_copy, &buffer1, &length1, &buffer2, &length2) < 0)
-	{
-		buffer_underflows++;
-		return;
-	}
-
-	// adjust the input pointer
-	stream_buffer_in += bytes_to_copy;
-	if (stream_buffer_in >= stream_buffer_size)
-	{
-		stream_buffer_in -= stream_buffer_size;
-		stream_loop = 1;
-
-		if (LOG_SOUND)
-			fprintf(sound_log, "stream_loop set to 1 (stream_buffer_in looped)\n");
-	}
-
-	// copy the first chunk
-	cur_bytes = (bytes_to_copy > length1) ? length1 : bytes_to_copy;
-	att_memcpy(buffer1, data, cur_bytes);
-
-	// adjust for the number of bytes
-	bytes_to_copy -= cur_bytes;
-	data = (INT16 *)((UINT8 *)data + cur_bytes);
-
-	// copy the second chunk
-	if (bytes_to_copy != 0)
-	{
-		cur_bytes = (bytes_to_copy > length2) ? length2 : bytes_to_copy;
-		att_memcpy(buffer2, data, cur_bytes);
-	}
-
-	// unlock
-	unlock_buffer();
-}
-
-
 //============================================================
 //	osd_update_audio_stream
 //============================================================
@@ -266,74 +206,59 @@ void osd_update_audio_stream(running_machine *machine, INT16 *buffer, int sample
 	// if nothing to do, don't do it
 	if (machine->sample_rate != 0 && stream_buffer)
 	{
-		int bytes_this_frame = samples_this_frame * sizeof(INT16) * 2;
-		int play_position, write_position, stream_in;
-		int orig_write; // used in LOG
-		
-		play_position = stream_playpos;
-
-		write_position = stream_playpos + ((machine->sample_rate / 50) * sizeof(INT16) * 2);
-		orig_write = write_position;
-
-		if (!stream_in_initialized)
+		UINT32 mask = stream_buffer_frames - 1;
+		UINT32 in = ring_in;
+		UINT32 out = (UINT32)atomic_add32(&ring_out, 0);
+		UINT32 limit = out + stream_buffer_frames;
+		UINT32 end = (UINT32)samples_this_frame << 16;
+		int level = attenuation_level;
+		int dropped = 0;
+
+		update_rate_control(in - out);
+
+		// resample into the ring, interpolating between neighbouring frames;
+		// position 0 is the last frame of the previous block
+		while (resample_pos < end)
 		{
-			stream_in = stream_buffer_in = (write_position + stream_buffer_size) / 2;
+			UINT32 index = resample_pos >> 16;
+			int frac = (resample_pos & 0xffff) >> 1;
+			const INT16 *s0 = (index == 0) ? resample_last : &buffer[(index - 1) * 2];
+			const INT16 *s1 = &buffer[index * 2];
 
-			if (LOG_SOUND)
+			if (in != limit)
 			{
-				fprintf(sound_log, "stream_in = %d\n", (int)stream_in);
-				fprintf(sound_log, "stream_playpos = %d\n", (int)stream_playpos);
-				fprintf(sound_log, "write_position = %d\n", (int)write_position);
+				INT16 *dest = &stream_buffer[(in & mask) * 2];
+				dest[0] = ((s0[0] + (((s1[0] - s0[0]) * frac) >> 15)) * level) >> 7;
+				dest[1] = ((s0[1] + (((s1[1] - s0[1]) * frac) >> 15)) * level) >> 7;
+				in++;
 			}
-			// start playing
-			SDL_PauseAudio(0);
-
-			stream_in_initialized = 1;
+			else
+				dropped++;
+			resample_pos += resample_step;
 		}
-		else
+		resample_pos -= end;
+		if (samples_this_frame > 0)
 		{
-			// normalize the stream in position
-			stream_in = stream_buffer_in;
-			if (stream_in < write_position && stream_loop == 1)
-				stream_in += stream_buffer_size;
-
-			// now we should have, in order:
-			//    <------pp---wp---si--------------->
-
-			// if we're between play and write positions, then bump forward, but only in full chunks
-			while (stream_in < write_position)
-			{
-				if (LOG_SOUND)
-					fprintf(sound_log, "Underflow: PP=%d  WP=%d(%d)  SI=%d(%d)  BTF=%d\n", (int)play_position, (int)write_position, (int)orig_write, (int)stream_in, (int)stream_buffer_in, (int)bytes_this_frame);
-
-				buffer_underflows++;
-				stream_in += samples_this_frame;
-			}
-
-			// if we're going to overlap the play position, just skip this chunk
-			if (stream_in + bytes_this_frame > play_position + stream_buffer_size)
-			{
-				if (LOG_SOUND)
-					fprintf(sound_log, "Overflow: PP=%d  WP=%d(%d)  SI=%d(%d)  BTF=%d\n", (int)play_position, (int)write_position, (int)orig_write, (int)stream_in, (int)stream_buffer_in, (int)bytes_this_frame);
-
-				buffer_overflows++;
-				return;
-			}
+			resample_last[0] = buffer[(samples_this_frame - 1) * 2 + 0];
+			resample_last[1] = buffer[(samples_this_frame - 1) * 2 + 1];
 		}
 
-		if (stream_in >= stream_buffer_size)
+		if (dropped)
 		{
-			stream_in -= stream_buffer_size;
-			stream_loop = 1;
-			
 			if (LOG_SOUND)
-				fprintf(sound_log, "stream_loop set to 1 (stream_in looped)\n");
-
+				fprintf(sound_log, "Overflow: in=%u out=%d dropped=%d\n", in, (int)ring_out, dropped);
+			buffer_overflows++;
 		}
 
-		// now we know where to copy; let's do it
-		stream_buffer_in = stream_in;
-		copy_sample_data(buffer, bytes_this_frame);
+		// publish the new frames to the callback
+		atomic_exchange32(&ring_in, (INT32)in);
+
+		if (!stream_started)
+		{
+			// start playing
+			SDL_PauseAudio(0);
+			stream_started = 1;
+		}
 	}
 }
 
@@ -352,6 +277,7 @@ void osd_set_mastervolume(int _attenuation)
 		_attenuation = -32;
 
 	attenuation = _attenuation;
+	attenuation_level = (int) (pow(10.0, (float) attenuation / 20.0) * 128.0);
 }
 
 //============================================================
@@ -359,60 +285,49 @@ void osd_set_mastervolume(int _attenuation)
 //============================================================
 static void sdl_callback(void *userdata, Uint8 *stream, int len)
 {
-	int len1, len2, sb_in;
-
-	sb_in = stream_buffer_in;
-	if (stream_loop)
-		sb_in += stream_buffer_size;
-
-	if (sb_in < (stream_playpos+len))
-	{
-		if (LOG_SOUND)
-			fprintf(sound_log, "Underflow at sdl_callback: SPP=%d SBI=%d(%d) Len=%d\n", (int)stream_playpos, (int)sb_in, (int)stream_buffer_in, (int)len);
-
-		return;
-	}
-	else if ((stream_playpos+len) > stream_buffer_size)
-	{
-		len1 = stream_buffer_size - stream_playpos;
-		len2 = len - len1;
-	}
-	else
-	{
-		len1 = len;
-		len2 = 0;
-	}
-
+	INT16 *dest = (INT16 *)stream;
+	UINT32 mask = stream_buffer_frames - 1;
+	UINT32 out = ring_out;
+	UINT32 fill = (UINT32)atomic_add32(&ring_in, 0) - out;
+	UINT32 frames = len / (2 * sizeof(INT16));
+	UINT32 avail = (fill < frames) ? fill : frames;
+	UINT32 first = stream_buffer_frames - (out & mask);
+
+	// gather latency statistics
+	callback_count++;
+	callback_fill_total += fill;
+	if (callback_count == 1 || fill < callback_fill_min)
+		callback_fill_min = fill;
+	if (fill > callback_fill_max)
+		callback_fill_max = fill;
+
+	// copy what is there, in up to two pieces
+	if (first > avail)
+		first = avail;
 	if (snd_enabled)
 	{
-		memcpy(stream, stream_buffer + stream_playpos, len1);
-		memset(stream_buffer + stream_playpos, 0, len1); // no longer needed
-		if (len2)
-		{
-			memcpy(stream+len1, stream_buffer, len2);
-			memset(stream_buffer, 0, len2); // no longer needed
-		}
-
+		memcpy(dest, &stream_buffer[(out & mask) * 2], first * 2 * sizeof(INT16));
+		memcpy(dest + first * 2, stream_buffer, (avail - first) * 2 * sizeof(INT16));
 	}
 	else
-	{
-		memset(stream, 0, len);
-	}
+		memset(dest, 0, avail * 2 * sizeof(INT16));
 
-	// move the play cursor
-	stream_playpos += len1 + len2;
-	if (stream_playpos >= stream_buffer_size)
+	// pad a short ring with silence
+	if (avail < frames)
 	{
-		stream_playpos -= stream_buffer_size;
-		stream_loop = 0;
-		
 		if (LOG_SOUND)
-			fprintf(sound_log, "stream_loop set to 0 (stream_playpos looped)\n");
+			fprintf(sound_log, "Underflow at sdl_callback: out=%u fill=%u frames=%u\n", out, fill, frames);
+
+		memset(dest + avail * 2, 0, (frames - avail) * 2 * sizeof(INT16));
+		buffer_underflows++;
+		underflow_frames += frames - avail;
 	}
 
+	// hand the frames back to the producer
+	atomic_exchange32(&ring_out, (INT32)(out + avail));
+
 	if (LOG_SOUND)
-		fprintf(sound_log, "callback: xfer len1 %d len2 %d, playpos %d\n",
-				len1, len2, stream_playpos);
+		fprintf(sound_log, "callback: xfer %u of %u frames, fill %u\n", avail, frames, fill);
 }
 
 
@@ -434,8 +349,7 @@ static int sdl_init(running_machine *machine)
 	initialized_audio = 0;
 
 	sdl_xfer_samples = SDL_XFER_SAMPLES;
-	stream_in_initialized = 0;
-	stream_loop = 0;
+	stream_started = 0;
 
 	// set up the audio specs
 	aspec.freq = machine->sample_rate;
@@ -474,11 +388,17 @@ static int sdl_init(running_machine *machine)
 		audio_latency = 1;
 	}
 
-	// compute the buffer sizes
-	stream_buffer_size = machine->sample_rate * 2 * sizeof(INT16) * audio_latency / MAX_AUDIO_LATENCY;
-	stream_buffer_size = (stream_buffer_size / 1024) * 1024;
-	if (stream_buffer_size < 1024)
-		stream_buffer_size = 1024;
+	// aim for the same latency as the old half-full buffer, but never
+	// less than two callbacks' worth
+	target_frames = machine->sample_rate * audio_latency / (2 * MAX_AUDIO_LATENCY);
+	if (target_frames < 2 * sdl_xfer_samples)
+		target_frames = 2 * sdl_xfer_samples;
+
+	// the ring gets the same again plus a tenth of a second of headroom
+	// for bursty frames, rounded up to a power of two
+	stream_buffer_frames = 1024;
+	while (stream_buffer_frames < 2 * target_frames + machine->sample_rate / 10)
+		stream_buffer_frames *= 2;
 
 	// create the buffers
 	if (sdl_create_buffers())
@@ -516,12 +436,29 @@ static void sdl_kill(running_machine *machine)
 
 static int sdl_create_buffers(void)
 {
-	mame_printf_verbose("sdl_create_buffers: creating stream buffer of %u bytes\n", stream_buffer_size);
-
-	stream_buffer = (INT8 *)malloc(stream_buffer_size);
-	memset(stream_buffer, 0, stream_buffer_size);
-	stream_playpos = 0;
-	buf_locked = 0;
+	mame_printf_verbose("sdl_create_buffers: creating stream buffer of %u frames, target fill %u frames\n", stream_buffer_frames, target_frames);
+
+	stream_buffer = (INT16 *)malloc(stream_buffer_frames * 2 * sizeof(INT16));
+	if (stream_buffer == NULL)
+		return 1;
+	memset(stream_buffer, 0, stream_buffer_frames * 2 * sizeof(INT16));
+
+	// start out with the target latency worth of silence
+	ring_out = 0;
+	ring_in = target_frames;
+	average_fill = target_frames << 8;
+
+	resample_step = 0x10000;
+	resample_pos = 0;
+	resample_last[0] = resample_last[1] = 0;
+	rate_integral = 0;
+	rate_adjust_min = rate_adjust_max = 0;
+
+	buffer_underflows = buffer_overflows = 0;
+	underflow_frames = 0;
+	callback_count = 0;
+	callback_fill_total = 0;
+	callback_fill_min = callback_fill_max = 0;
 	return 0;
 }
 
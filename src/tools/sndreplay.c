@@ -0,0 +1,712 @@
+/***************************************************************************
+
+    sndreplay.c
+
+    Replays a sound chip register log written with -soundlog through the
+    sound cores at full speed, and reports their throughput and a CRC of
+    the generated samples.
+
+    Copyright Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+***************************************************************************/
+
+#include "sndintrf.h"
+#include "corefile.h"
+#include "corestr.h"
+#include "sound/soundlog.h"
+#include "sound/fm.h"
+#include "sound/ym2151.h"
+#include "sound/fmopl.h"
+#include "sound/ymf262.h"
+#include <zlib.h>
+#include <stdarg.h>
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+#define CHUNK_SAMPLES		1024
+#define MAX_CHIP_OUTPUTS	4
+
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+typedef struct _log_region log_region;
+struct _log_region
+{
+	const UINT8 *			base;
+	UINT32					length;
+	UINT32					crc;
+};
+
+
+typedef struct _log_device log_device;
+struct _log_device
+{
+	UINT32					clock;
+	char					name[256];
+	char					tag[256];
+	int						regions;
+	log_region				region[SOUNDLOG_MAX_REGIONS];
+};
+
+
+typedef struct _log_event log_event;
+struct _log_event
+{
+	UINT8					type;
+	UINT8					device;
+	UINT64					time;
+	UINT32					offset;
+	UINT8					data;
+};
+
+
+typedef struct _sound_log sound_log;
+struct _sound_log
+{
+	int						devices;
+	log_device				device[SOUNDLOG_MAX_DEVICES];
+	int						events;
+	log_event *				event;
+	UINT64					endtime;
+};
+
+
+typedef struct _replay_chip replay_chip;
+struct _replay_chip
+{
+	const char *			name;
+	int						outputs;
+	int						divider;		/* output rate is clock / divider, as in the interfaces */
+	void *					(*start)(const log_device *device, const device_config *config, int rate);
+	void					(*reset)(void *chip);
+	void					(*stop)(void *chip);
+	void					(*write)(void *chip, offs_t offset, UINT8 data);
+	void					(*update)(void *chip, stream_sample_t **outputs, int samples);
+};
+
+
+typedef struct _replay_result replay_result;
+struct _replay_result
+{
+	UINT64					samples;
+	osd_ticks_t				ticks;
+	UINT32					crc;
+};
+
+
+
+/***************************************************************************
+    EMULATOR STUBS
+***************************************************************************/
+
+/*
+    The cores only use the machine for timers, save states and logging,
+    none of which matter when replaying a log.
+*/
+
+static int verbose;
+
+void CLIB_DECL logerror(const char *format, ...)
+{
+	va_list arg;
+
+	if (!verbose)
+		return;
+	va_start(arg, format);
+	vfprintf(stderr, format, arg);
+	va_end(arg);
+}
+
+void state_save_register_memory(running_machine *machine, const char *module, const char *tag, UINT32 index, const char *name, void *val, UINT32 valsize, UINT32 valcount) { }
+void state_save_register_postload(running_machine *machine, state_postload_func func, void *param) { }
+emu_timer *_timer_alloc_internal(running_machine *machine, timer_fired_func callback, void *param, const char *file, int line, const char *func) { return NULL; }
+void _timer_set_internal(running_machine *machine, attotime duration, void *ptr, INT32 param, timer_fired_func callback, const char *file, int line, const char *func) { }
+void timer_adjust_oneshot(emu_timer *which, attotime duration, INT32 param) { }
+int timer_enable(emu_timer *which, int enable) { return 0; }
+attotime timer_get_time(running_machine *machine) { return attotime_zero; }
+const char *device_get_info_string(const device_config *device, UINT32 state) { return ""; }
+
+#if HAS_YM2203
+void ym2203_update_request(void *param) { }
+#endif
+#if HAS_YM2608
+void ym2608_update_request(void *param) { }
+#endif
+#if HAS_YM2610 || HAS_YM2610B
+void ym2610_update_request(void *param) { }
+#endif
+#if HAS_YM2612 || HAS_YM3438
+void ym2612_update_request(void *param) { }
+#endif
+
+
+
+/***************************************************************************
+    CHIP INTERFACES
+***************************************************************************/
+
+#if HAS_YM2203 || HAS_YM2608 || HAS_YM2610 || HAS_YM2610B
+/* the SSG half of the OPN chips is a separate AY-3-8910 core, which is not replayed */
+static void ssg_set_clock(void *param, int clock) { }
+static void ssg_write(void *param, int address, int data) { }
+static int ssg_read(void *param) { return 0; }
+static void ssg_reset(void *param) { }
+
+static const ssg_callbacks ssg_stub = { ssg_set_clock, ssg_write, ssg_read, ssg_reset };
+#endif
+
+
+#if HAS_YM2151
+static UINT8 ym2151_lastreg;
+
+static void *ym2151_replay_start(const log_device *device, const device_config *config, int rate)
+{
+	ym2151_lastreg = 0;
+	return ym2151_init(config, device->clock, rate);
+}
+
+static void ym2151_replay_write(void *chip, offs_t offset, UINT8 data)
+{
+	if (offset & 1)
+		ym2151_write_reg(chip, ym2151_lastreg, data);
+	else
+		ym2151_lastreg = data;
+}
+
+static void ym2151_replay_update(void *chip, stream_sample_t **outputs, int samples)
+{
+	ym2151_update_one(chip, outputs, samples);
+}
+#endif
+
+
+#if HAS_YM2203
+static void *ym2203_replay_start(const log_device *device, const device_config *config, int rate)
+{
+	return ym2203_init(NULL, config, device->clock, rate, NULL, NULL, &ssg_stub);
+}
+
+static void ym2203_replay_write(void *chip, offs_t offset, UINT8 data)
+{
+	ym2203_write(chip, offset & 1, data);
+}
+
+static void ym2203_replay_update(void *chip, stream_sample_t **outputs, int samples)
+{
+	ym2203_update_one(chip, outputs[0], samples);
+}
+#endif
+
+
+#if HAS_YM2608
+static void *ym2608_replay_start(const log_device *device, const device_config *config, int rate)
+{
+	return ym2608_init(NULL, config, device->clock, rate, (void *)device->region[0].base, device->region[0].length, NULL, NULL, &ssg_stub);
+}
+
+static void ym2608_replay_write(void *chip, offs_t offset, UINT8 data)
+{
+	ym2608_write(chip, offset & 3, data);
+}
+#endif
+
+
+#if HAS_YM2610 || HAS_YM2610B
+static void *ym2610_replay_start(const log_device *device, const device_config *config, int rate)
+{
+	const log_region *deltat = &device->region[(device->regions > 1) ? 1 : 0];
+	return ym2610_init(NULL, config, device->clock, rate,
+			(void *)device->region[0].base, device->region[0].length,
+			(void *)deltat->base, deltat->length, NULL, NULL, &ssg_stub);
+}
+
+static void ym2610_replay_write(void *chip, offs_t offset, UINT8 data)
+{
+	ym2610_write(chip, offset & 3, data);
+}
+#endif
+
+
+#if HAS_YM2612 || HAS_YM3438
+static void *ym2612_replay_start(const log_device *device, const device_config *config, int rate)
+{
+	return ym2612_init(NULL, config, device->clock, rate, NULL, NULL);
+}
+
+static void ym2612_replay_write(void *chip, offs_t offset, UINT8 data)
+{
+	ym2612_write(chip, offset & 3, data);
+}
+#endif
+
+
+#if HAS_YM3526
+static void *ym3526_replay_start(const log_device *device, const device_config *config, int rate)
+{
+	return ym3526_init(config, device->clock, rate);
+}
+
+static void ym3526_replay_write(void *chip, offs_t offset, UINT8 data)
+{
+	ym3526_write(chip, offset & 1, data);
+}
+
+static void ym3526_replay_update(void *chip, stream_sample_t **outputs, int samples)
+{
+	ym3526_update_one(chip, outputs[0], samples);
+}
+#endif
+
+
+#if HAS_YM3812
+static void *ym3812_replay_start(const log_device *device, const device_config *config, int rate)
+{
+	return ym3812_init(config, device->clock, rate);
+}
+
+static void ym3812_replay_write(void *chip, offs_t offset, UINT8 data)
+{
+	ym3812_write(chip, offset & 1, data);
+}
+
+static void ym3812_replay_update(void *chip, stream_sample_t **outputs, int samples)
+{
+	ym3812_update_one(chip, outputs[0], samples);
+}
+#endif
+
+
+#if HAS_Y8950
+static void *y8950_replay_start(const log_device *device, const device_config *config, int rate)
+{
+	void *chip = y8950_init(config, device->clock, rate);
+	if (chip != NULL)
+		y8950_set_delta_t_memory(chip, (void *)device->region[0].base, device->region[0].length);
+	return chip;
+}
+
+static void y8950_replay_write(void *chip, offs_t offset, UINT8 data)
+{
+	y8950_write(chip, offset & 1, data);
+}
+
+static void y8950_replay_update(void *chip, stream_sample_t **outputs, int samples)
+{
+	y8950_update_one(chip, outputs[0], samples);
+}
+#endif
+
+
+#if HAS_YMF262
+static void *ymf262_replay_start(const log_device *device, const device_config *config, int rate)
+{
+	return ymf262_init(config, device->clock, rate);
+}
+
+static void ymf262_replay_write(void *chip, offs_t offset, UINT8 data)
+{
+	ymf262_write(chip, offset & 3, data);
+}
+#endif
+
+
+static const replay_chip replay_chips[] =
+{
+#if HAS_YM2151
+	{ "YM2151",  2,  64, ym2151_replay_start, ym2151_reset_chip, ym2151_shutdown, ym2151_replay_write, ym2151_replay_update },
+#endif
+#if HAS_YM2203
+	{ "YM2203",  1,  72, ym2203_replay_start, ym2203_reset_chip, ym2203_shutdown, ym2203_replay_write, ym2203_replay_update },
+#endif
+#if HAS_YM2608
+	{ "YM2608",  2,  72, ym2608_replay_start, ym2608_reset_chip, ym2608_shutdown, ym2608_replay_write, ym2608_update_one },
+#endif
+#if HAS_YM2610
+	{ "YM2610",  2,  72, ym2610_replay_start, ym2610_reset_chip, ym2610_shutdown, ym2610_replay_write, ym2610_update_one },
+#endif
+#if HAS_YM2610B
+	{ "YM2610B", 2,  72, ym2610_replay_start, ym2610_reset_chip, ym2610_shutdown, ym2610_replay_write, ym2610b_update_one },
+#endif
+#if HAS_YM2612
+	{ "YM2612",  2,  72, ym2612_replay_start, ym2612_reset_chip, ym2612_shutdown, ym2612_replay_write, ym2612_update_one },
+#endif
+#if HAS_YM3438
+	{ "YM3438",  2,  72, ym2612_replay_start, ym2612_reset_chip, ym2612_shutdown, ym2612_replay_write, ym2612_update_one },
+#endif
+#if HAS_YM3526
+	{ "YM3526",  1,  72, ym3526_replay_start, ym3526_reset_chip, ym3526_shutdown, ym3526_replay_write, ym3526_replay_update },
+#endif
+#if HAS_YM3812
+	{ "YM3812",  1,  72, ym3812_replay_start, ym3812_reset_chip, ym3812_shutdown, ym3812_replay_write, ym3812_replay_update },
+#endif
+#if HAS_Y8950
+	{ "Y8950",   1,  72, y8950_replay_start,  y8950_reset_chip,  y8950_shutdown,  y8950_replay_write,  y8950_replay_update },
+#endif
+#if HAS_YMF262
+	{ "YMF262",  4, 288, ymf262_replay_start, ymf262_reset_chip, ymf262_shutdown, ymf262_replay_write, ymf262_update_one },
+#endif
+	{ NULL }
+};
+
+
+
+/***************************************************************************
+    LOG PARSING
+***************************************************************************/
+
+/*-------------------------------------------------
+    get8/get32/get64 - read little-endian values
+    from the log, failing at the end of data
+-------------------------------------------------*/
+
+static int get8(const UINT8 **ptr, const UINT8 *end, UINT8 *value)
+{
+	if (end - *ptr < 1)
+		return FALSE;
+	*value = *(*ptr)++;
+	return TRUE;
+}
+
+
+static int get32(const UINT8 **ptr, const UINT8 *end, UINT32 *value)
+{
+	const UINT8 *p = *ptr;
+	if (end - p < 4)
+		return FALSE;
+	*value = p[0] | (p[1] << 8) | (p[2] << 16) | ((UINT32)p[3] << 24);
+	*ptr += 4;
+	return TRUE;
+}
+
+
+static int get64(const UINT8 **ptr, const UINT8 *end, UINT64 *value)
+{
+	UINT32 lo, hi;
+	if (!get32(ptr, end, &lo) || !get32(ptr, end, &hi))
+		return FALSE;
+	*value = ((UINT64)hi << 32) | lo;
+	return TRUE;
+}
+
+
+static int getstring(const UINT8 **ptr, const UINT8 *end, char *string)
+{
+	UINT8 length;
+	if (!get8(ptr, end, &length) || end - *ptr < length)
+		return FALSE;
+	memcpy(string, *ptr, length);
+	string[length] = 0;
+	*ptr += length;
+	return TRUE;
+}
+
+
+/*-------------------------------------------------
+    parse_log - split a log into its devices and
+    events; the region data is left in place
+-------------------------------------------------*/
+
+static int parse_log(const UINT8 *data, UINT32 length, sound_log *log)
+{
+	const UINT8 *ptr = data + 12;
+	const UINT8 *end = data + length;
+	int maxevents = 0;
+
+	memset(log, 0, sizeof(*log));
+	if (length < 12 || memcmp(data, SOUNDLOG_MAGIC, 8) != 0)
+	{
+		fprintf(stderr, "Not a sound log\n");
+		return FALSE;
+	}
+	if ((data[8] | (data[9] << 8) | (data[10] << 16) | (data[11] << 24)) != SOUNDLOG_VERSION)
+	{
+		fprintf(stderr, "Unsupported sound log version\n");
+		return FALSE;
+	}
+
+	while (ptr < end)
+	{
+		UINT8 type = *ptr++;
+
+		if (type == SOUNDLOG_END)
+		{
+			if (!get64(&ptr, end, &log->endtime))
+				break;
+			return TRUE;
+		}
+
+		else if (type == SOUNDLOG_DEVICE)
+		{
+			log_device *device;
+			UINT8 index, regions;
+			int regnum;
+
+			if (!get8(&ptr, end, &index) || index != log->devices)
+				break;
+			device = &log->device[log->devices++];
+			if (!get32(&ptr, end, &device->clock) || !getstring(&ptr, end, device->name) || !getstring(&ptr, end, device->tag) ||
+				!get8(&ptr, end, &regions) || regions > SOUNDLOG_MAX_REGIONS)
+				break;
+			for (regnum = 0; regnum < regions; regnum++)
+			{
+				log_region *region = &device->region[regnum];
+				if (!get32(&ptr, end, &region->length) || !get32(&ptr, end, &region->crc) || end - ptr < region->length)
+					break;
+				region->base = ptr;
+				ptr += region->length;
+				if (crc32(0, region->base, region->length) != region->crc)
+					fprintf(stderr, "Warning: region %d of '%s' does not match its CRC\n", regnum, device->tag);
+			}
+			if (regnum != regions)
+				break;
+			device->regions = regions;
+		}
+
+		else if (type == SOUNDLOG_WRITE || type == SOUNDLOG_RESET)
+		{
+			log_event *event;
+
+			if (log->events == maxevents)
+			{
+				maxevents = (maxevents == 0) ? 65536 : maxevents * 2;
+				log->event = (log_event *)realloc(log->event, maxevents * sizeof(log->event[0]));
+				if (log->event == NULL)
+				{
+					fprintf(stderr, "Out of memory\n");
+					return FALSE;
+				}
+			}
+			event = &log->event[log->events];
+			event->type = type;
+			event->offset = 0;
+			event->data = 0;
+			if (!get8(&ptr, end, &event->device) || event->device >= log->devices || !get64(&ptr, end, &event->time))
+				break;
+			if (type == SOUNDLOG_WRITE && (!get32(&ptr, end, &event->offset) || !get8(&ptr, end, &event->data)))
+				break;
+			log->events++;
+		}
+
+		else
+			break;
+	}
+
+	/* a log cut short (e.g. by a crash) still replays up to its last event */
+	fprintf(stderr, "Warning: sound log is truncated or corrupt after %d events\n", log->events);
+	log->endtime = (log->events > 0) ? log->event[log->events - 1].time : 0;
+	return TRUE;
+}
+
+
+
+/***************************************************************************
+    REPLAY
+***************************************************************************/
+
+/*-------------------------------------------------
+    render - generate samples up to 'target',
+    timing the core and folding the output into
+    the CRC
+-------------------------------------------------*/
+
+static void render(const replay_chip *intf, void *chip, stream_sample_t **outputs, UINT64 target, replay_result *result)
+{
+	static UINT8 bytes[CHUNK_SAMPLES * MAX_CHIP_OUTPUTS * 4];
+
+	while (result->samples < target)
+	{
+		int samples = (target - result->samples > CHUNK_SAMPLES) ? CHUNK_SAMPLES : (int)(target - result->samples);
+		osd_ticks_t start = osd_ticks();
+		UINT8 *dest = bytes;
+		int sampnum, outnum;
+
+		(*intf->update)(chip, outputs, samples);
+		result->ticks += osd_ticks() - start;
+
+		/* hash the samples in a host-independent order */
+		for (sampnum = 0; sampnum < samples; sampnum++)
+			for (outnum = 0; outnum < intf->outputs; outnum++)
+			{
+				UINT32 value = outputs[outnum][sampnum];
+				*dest++ = value;
+				*dest++ = value >> 8;
+				*dest++ = value >> 16;
+				*dest++ = value >> 24;
+			}
+		result->crc = crc32(result->crc, bytes, dest - bytes);
+		result->samples += samples;
+	}
+}
+
+
+/*-------------------------------------------------
+    replay_device - replay all events for one
+    device
+-------------------------------------------------*/
+
+static int replay_device(const sound_log *log, int devnum, const replay_chip *intf, replay_result *result)
+{
+	static stream_sample_t buffer[MAX_CHIP_OUTPUTS][CHUNK_SAMPLES];
+	stream_sample_t *outputs[MAX_CHIP_OUTPUTS];
+	const log_device *device = &log->device[devnum];
+	device_config *config;
+	int rate = device->clock / intf->divider;
+	void *chip;
+	int evnum;
+
+	for (evnum = 0; evnum < MAX_CHIP_OUTPUTS; evnum++)
+		outputs[evnum] = buffer[evnum];
+
+	/* the cores only look at the region and clock of the device */
+	config = (device_config *)calloc(1, sizeof(*config));
+	config->clock = device->clock;
+	config->region = (UINT8 *)device->region[0].base;
+	config->regionbytes = device->region[0].length;
+
+	chip = (*intf->start)(device, config, rate);
+	if (chip == NULL)
+	{
+		fprintf(stderr, "Error starting %s '%s'\n", device->name, device->tag);
+		free(config);
+		return FALSE;
+	}
+	(*intf->reset)(chip);
+
+	memset(result, 0, sizeof(*result));
+	for (evnum = 0; evnum < log->events; evnum++)
+	{
+		const log_event *event = &log->event[evnum];
+		if (event->device != devnum)
+			continue;
+
+		render(intf, chip, outputs, event->time * rate / 1000000000, result);
+		if (event->type == SOUNDLOG_WRITE)
+			(*intf->write)(chip, event->offset, event->data);
+		else
+			(*intf->reset)(chip);
+	}
+	render(intf, chip, outputs, log->endtime * rate / 1000000000, result);
+
+	(*intf->stop)(chip);
+	free(config);
+	return TRUE;
+}
+
+
+
+/***************************************************************************
+    MAIN
+***************************************************************************/
+
+int main(int argc, char *argv[])
+{
+	const char *filename = NULL;
+	const char *tag = NULL;
+	int repeat = 1;
+	sound_log log;
+	file_error filerr;
+	UINT32 length;
+	void *data;
+	int arg, devnum;
+	int result = 0;
+
+	/* parse the arguments */
+	for (arg = 1; arg < argc; arg++)
+	{
+		if (core_stricmp(argv[arg], "-device") == 0 && arg + 1 < argc)
+			tag = argv[++arg];
+		else if (core_stricmp(argv[arg], "-repeat") == 0 && arg + 1 < argc)
+		{
+			repeat = atoi(argv[++arg]);
+			if (repeat < 1)
+				repeat = 1;
+		}
+		else if (core_stricmp(argv[arg], "-verbose") == 0)
+			verbose = TRUE;
+		else if (argv[arg][0] != '-' && filename == NULL)
+			filename = argv[arg];
+		else
+			goto usage;
+	}
+	if (filename == NULL)
+		goto usage;
+
+	/* load and parse the log */
+	filerr = core_fload(filename, &data, &length);
+	if (filerr != FILERR_NONE)
+	{
+		fprintf(stderr, "Error opening file '%s'\n", filename);
+		return 1;
+	}
+	if (!parse_log((const UINT8 *)data, length, &log))
+	{
+		free(data);
+		return 1;
+	}
+	printf("%d devices, %d events, %.3f seconds\n", log.devices, log.events, (double)log.endtime / 1e9);
+
+	/* replay each device on its own */
+	for (devnum = 0; devnum < log.devices; devnum++)
+	{
+		const log_device *device = &log.device[devnum];
+		const replay_chip *intf;
+		replay_result first, pass;
+		osd_ticks_t ticks = 0, tps;
+		double seconds, emulated;
+		int passnum;
+
+		if (tag != NULL && strcmp(tag, device->tag) != 0)
+			continue;
+		for (intf = replay_chips; intf->name != NULL; intf++)
+			if (strcmp(intf->name, device->name) == 0)
+				break;
+		if (intf->name == NULL)
+		{
+			printf("%-8s %-16s not supported\n", device->name, device->tag);
+			continue;
+		}
+
+		/* repeated passes must hash the same, otherwise the core is not deterministic */
+		memset(&first, 0, sizeof(first));
+		for (passnum = 0; passnum < repeat; passnum++)
+		{
+			if (!replay_device(&log, devnum, intf, &pass))
+			{
+				result = 1;
+				break;
+			}
+			if (passnum == 0)
+				first = pass;
+			else if (pass.crc != first.crc)
+			{
+				printf("%-8s %-16s pass %d CRC %08X differs from %08X\n", device->name, device->tag, passnum + 1, pass.crc, first.crc);
+				result = 1;
+			}
+			ticks += pass.ticks;
+		}
+		if (passnum != repeat)
+			continue;
+
+		tps = osd_ticks_per_second();
+		seconds = (double)ticks / (double)tps;
+		emulated = (double)first.samples * repeat / (double)(device->clock / intf->divider);
+		printf("%-8s %-16s %10.0f samples/s  %8.2fx realtime  CRC %08X\n", device->name, device->tag,
+				(seconds > 0) ? (double)first.samples * repeat / seconds : 0.0,
+				(seconds > 0) ? emulated / seconds : 0.0, first.crc);
+	}
+
+	free(log.event);
+	free(data);
+	return result;
+
+usage:
+	printf("Usage: %s <soundlog> [-device <tag>] [-repeat <count>] [-verbose]\n", argv[0]);
+	return 1;
+}
@@ -33,6 +33,7 @@ TOOLS += \
 	srcclean$(EXE) \
 	src2html$(EXE) \
 	split$(EXE) \
+	sndreplay$(EXE) \
 
 
 
@@ -164,3 +165,28 @@ SPLITOBJS = \
 split$(EXE): $(SPLITOBJS) $(LIBUTIL) $(LIBOCORE) $(ZLIB) $(EXPAT)
 	@echo Linking $@...
 	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@
+
+
+
+#-------------------------------------------------
+# sndreplay
+#-------------------------------------------------
+
+# the sound cores that sndreplay can drive, as far as they are in this build
+SNDREPLAYCORES = $(addprefix $(SOUNDOBJ)/, \
+	fm.o \
+	fm2612.o \
+	fmopl.o \
+	ym2151.o \
+	ymdeltat.o \
+	ymf262.o \
+)
+
+SNDREPLAYOBJS = \
+	$(TOOLSOBJ)/sndreplay.o \
+	$(EMUOBJ)/attotime.o \
+	$(filter $(SNDREPLAYCORES),$(sort $(SOUNDOBJS))) \
+
+sndreplay$(EXE): $(SNDREPLAYOBJS) $(LIBUTIL) $(LIBOCORE) $(ZLIB) $(EXPAT)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@